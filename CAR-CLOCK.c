@@ -0,0 +1,468 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Este programa implementa el algoritmo de reemplazo **CAR (Clock with Adaptive Replacement)**, la
+ * versión de ARC construida con relojes. La memoria se reparte entre dos relojes: T1 guarda las páginas
+ * vistas una sola vez desde que entraron y T2 las que se han vuelto a referenciar. Dos listas fantasma
+ * (B1 y B2) recuerdan las páginas desalojadas recientemente de cada reloj sin ocupar frames; un fallo
+ * sobre una página fantasma indica qué reloj se quedó corto y mueve el objetivo adaptativo p (tamaño
+ * deseado de T1). Un recorrido secuencial solo pasa por T1 y no desplaza el conjunto de trabajo de T2,
+ * así que CAR resiste los barridos que vacían CLOCK y LRU.
+ *
+ * Como LRU-CLOCK.c, los frames se guardan como estructura de arrays: cada entrada (residente o
+ * fantasma) es un índice en arrays contiguos de página, siguiente y anterior, con el bit de referencia
+ * en un mapa de bits. Hay 2 * capacity entradas, el máximo que permiten las invariantes de CAR, y las
+ * cuatro listas son circulares sobre esos índices: en T1 y T2 la cabeza es el puntero del reloj, y en
+ * B1 y B2 la cabeza es la entrada más antigua. Un índice hash página -> entrada localiza las páginas
+ * residentes y fantasma en tiempo constante.
+ *
+ * Los tipos y funciones del algoritmo son privados; se exportan a través de carPolicy (policy.h) y el
+ * main se omite al compilar con -DPOLICY_LIBRARY para enlazarlo junto a los demás en el simulador.
+ *
+ * Compilación: gcc -O2 -pthread CAR-CLOCK.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o CAR-CLOCK
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "policy.h"
+#include "driver.h"
+#include "checkpoint.h"
+#include "framescan.h"
+
+#define NO_ENTRY -1     // Índice nulo en las listas y en el índice hash
+
+// Lista a la que pertenece cada entrada
+enum {
+    LIST_FREE,      // Entrada sin usar
+    LIST_T1,        // Residente, vista una vez
+    LIST_T2,        // Residente, vista al menos dos veces
+    LIST_B1,        // Fantasma desalojada de T1
+    LIST_B2,        // Fantasma desalojada de T2
+    NUM_LISTS
+};
+
+// Estructura para administrar los relojes y las listas fantasma
+typedef struct FrameList {
+    int capacity;           // Número de frames disponibles en memoria física
+    int numEntries;         // Entradas reservadas (2 * capacity)
+    int *pages;             // Página de cada entrada
+    int *next;              // Siguiente entrada en su lista circular
+    int *prev;              // Entrada anterior en su lista circular
+    int *hashNext;          // Siguiente entrada en la misma cubeta del índice hash
+    unsigned char *list;    // Lista a la que pertenece cada entrada (LIST_*)
+    uint64_t *reference;    // Mapa de bits: bit de referencia de las entradas residentes
+    int *buckets;           // Cubetas del índice hash página -> entrada
+    int numBuckets;         // Número de cubetas (potencia de 2)
+    int heads[NUM_LISTS];   // Cabeza de cada lista (puntero del reloj en T1 y T2, la más antigua en B1 y B2)
+    int sizes[NUM_LISTS];   // Número de entradas de cada lista
+    int target;             // Objetivo adaptativo p: tamaño deseado de T1
+    SimStats stats;         // Contadores de accesos, aciertos, fallos y desalojos
+} FrameList;
+
+/*
+ * Función: destroyFrameList
+ * Descripción: Libera los arrays de entradas, el índice hash y la propia lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void destroyFrameList(FrameList *frameList) {
+    free(frameList->pages);
+    free(frameList->next);
+    free(frameList->prev);
+    free(frameList->hashNext);
+    free(frameList->list);
+    free(frameList->reference);
+    free(frameList->buckets);
+    free(frameList);
+}
+
+/*
+ * Función: createFrameList
+ * Descripción: Inicializa los relojes vacíos, con todas las entradas en la lista libre.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ * Retorna: Puntero a la lista creada.
+ */
+static FrameList* createFrameList(int capacity) {
+    FrameList *frameList = (FrameList *)calloc(1, sizeof(FrameList));
+    if (frameList != NULL) {
+        int numEntries = 2 * capacity;
+        frameList->numBuckets = 1;
+        while (frameList->numBuckets < 2 * numEntries) {
+            frameList->numBuckets <<= 1;
+        }
+        frameList->pages = (int *)malloc((size_t)numEntries * sizeof(int));
+        frameList->next = (int *)malloc((size_t)numEntries * sizeof(int));
+        frameList->prev = (int *)malloc((size_t)numEntries * sizeof(int));
+        frameList->hashNext = (int *)malloc((size_t)numEntries * sizeof(int));
+        frameList->list = (unsigned char *)calloc((size_t)numEntries, 1);  // LIST_FREE
+        frameList->reference = (uint64_t *)calloc(BITMAP_WORDS(numEntries), sizeof(uint64_t));
+        frameList->buckets = (int *)malloc((size_t)frameList->numBuckets * sizeof(int));
+        if (frameList->pages == NULL || frameList->next == NULL || frameList->prev == NULL ||
+            frameList->hashNext == NULL || frameList->list == NULL || frameList->reference == NULL ||
+            frameList->buckets == NULL) {
+            destroyFrameList(frameList);
+            return NULL;
+        }
+        frameList->capacity = capacity;
+        frameList->numEntries = numEntries;
+        for (int i = 0; i < frameList->numBuckets; i++) {
+            frameList->buckets[i] = NO_ENTRY;
+        }
+        for (int l = 0; l < NUM_LISTS; l++) {
+            frameList->heads[l] = NO_ENTRY;
+        }
+        // La lista libre es una lista circular más, con todas las entradas en orden
+        for (int i = 0; i < numEntries; i++) {
+            frameList->pages[i] = -1;
+            frameList->next[i] = (i + 1) % numEntries;
+            frameList->prev[i] = (i + numEntries - 1) % numEntries;
+        }
+        frameList->heads[LIST_FREE] = numEntries > 0 ? 0 : NO_ENTRY;
+        frameList->sizes[LIST_FREE] = numEntries;
+    }
+    return frameList;
+}
+
+/*
+ * Función: hashPage
+ * Descripción: Calcula la cubeta del índice hash que corresponde a una página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static int hashPage(const FrameList *frameList, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (int)(h & (uint32_t)(frameList->numBuckets - 1));
+}
+
+/*
+ * Función: findEntry
+ * Descripción: Busca en el índice hash la entrada (residente o fantasma) de una página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página que se busca.
+ * Retorna: Índice de la entrada, o NO_ENTRY si la página no está en ninguna lista.
+ */
+static int findEntry(FrameList *frameList, int page) {
+    int entry = frameList->buckets[hashPage(frameList, page)];
+    INSTRUMENT(frameList->stats.lookups++);
+    while (entry != NO_ENTRY) {
+        INSTRUMENT(frameList->stats.lookupSteps++);
+        if (frameList->pages[entry] == page) {
+            break;
+        }
+        entry = frameList->hashNext[entry];
+    }
+    return entry;
+}
+
+/*
+ * Funciones: indexInsert, indexRemove
+ * Descripción: Añaden o quitan una entrada del índice hash según su página.
+ */
+static void indexInsert(FrameList *frameList, int entry) {
+    int bucket = hashPage(frameList, frameList->pages[entry]);
+    frameList->hashNext[entry] = frameList->buckets[bucket];
+    frameList->buckets[bucket] = entry;
+}
+
+static void indexRemove(FrameList *frameList, int entry) {
+    int *link = &frameList->buckets[hashPage(frameList, frameList->pages[entry])];
+    while (*link != entry) {
+        link = &frameList->hashNext[*link];
+    }
+    *link = frameList->hashNext[entry];
+}
+
+/*
+ * Función: unlinkEntry
+ * Descripción: Quita una entrada de la lista circular en la que está.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - entry: Índice de la entrada.
+ */
+static void unlinkEntry(FrameList *frameList, int entry) {
+    int l = frameList->list[entry];
+    if (--frameList->sizes[l] == 0) {
+        frameList->heads[l] = NO_ENTRY;
+    } else {
+        frameList->next[frameList->prev[entry]] = frameList->next[entry];
+        frameList->prev[frameList->next[entry]] = frameList->prev[entry];
+        if (frameList->heads[l] == entry) {
+            frameList->heads[l] = frameList->next[entry];
+        }
+    }
+}
+
+/*
+ * Función: appendEntry
+ * Descripción: Inserta una entrada al final de una lista: justo detrás del puntero del reloj en T1 y
+ *              T2, o como la más reciente en B1 y B2.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - entry: Índice de la entrada (no debe estar en ninguna lista).
+ *  - l: Lista de destino (LIST_*).
+ */
+static void appendEntry(FrameList *frameList, int entry, int l) {
+    int head = frameList->heads[l];
+    if (head == NO_ENTRY) {
+        frameList->next[entry] = entry;
+        frameList->prev[entry] = entry;
+        frameList->heads[l] = entry;
+    } else {
+        int tail = frameList->prev[head];
+        frameList->next[tail] = entry;
+        frameList->prev[entry] = tail;
+        frameList->next[entry] = head;
+        frameList->prev[head] = entry;
+    }
+    frameList->list[entry] = (unsigned char)l;
+    frameList->sizes[l]++;
+}
+
+/*
+ * Función: moveEntry
+ * Descripción: Pasa una entrada de su lista actual al final de otra.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - entry: Índice de la entrada.
+ *  - l: Lista de destino (LIST_*).
+ */
+static void moveEntry(FrameList *frameList, int entry, int l) {
+    unlinkEntry(frameList, entry);
+    appendEntry(frameList, entry, l);
+}
+
+/*
+ * Función: discardGhost
+ * Descripción: Olvida la entrada fantasma más antigua de B1 o B2 y la devuelve a la lista libre.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - l: LIST_B1 o LIST_B2.
+ */
+static void discardGhost(FrameList *frameList, int l) {
+    int entry = frameList->heads[l];
+    indexRemove(frameList, entry);
+    frameList->pages[entry] = -1;
+    moveEntry(frameList, entry, LIST_FREE);
+}
+
+/*
+ * Función: replaceFrame
+ * Descripción: Libera un frame con los dos relojes. Se avanza el de T1 si su tamaño alcanza el objetivo
+ *              p y el de T2 en caso contrario; una página de T1 referenciada pasa a T2, una de T2
+ *              referenciada da otra vuelta, y la primera sin referencia se desaloja a su lista fantasma.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames (con al menos una página residente).
+ * Retorna: Página desalojada.
+ */
+static int replaceFrame(FrameList *frameList) {
+    for (;;) {
+        int t1 = frameList->sizes[LIST_T1];
+        bool useT1 = t1 > 0 && (t1 >= (frameList->target > 1 ? frameList->target : 1) ||
+                                frameList->sizes[LIST_T2] == 0);
+        int l = useT1 ? LIST_T1 : LIST_T2;
+        int entry = frameList->heads[l];
+        INSTRUMENT(frameList->stats.handSteps++);
+        if (!testBit(frameList->reference, entry)) {
+            moveEntry(frameList, entry, useT1 ? LIST_B1 : LIST_B2);
+            frameList->stats.evictions++;
+            return frameList->pages[entry];
+        }
+        clearBit(frameList->reference, entry);
+        if (useT1) {
+            moveEntry(frameList, entry, LIST_T2);
+        } else {
+            frameList->heads[LIST_T2] = frameList->next[entry];  // Avanzar el puntero del reloj
+        }
+    }
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja la página que elegiría CAR para dejar sitio a una nueva.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Página desalojada, o -1 si no hay frames ocupados.
+ */
+static int evictFrame(FrameList *frameList) {
+    if (frameList->sizes[LIST_T1] + frameList->sizes[LIST_T2] == 0) {
+        return -1;
+    }
+    return replaceFrame(frameList);
+}
+
+/*
+ * Función: loadPage
+ * Descripción: Carga una página en memoria utilizando el algoritmo CAR.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página a cargar.
+ * Retorna: true si la página ya estaba en memoria (acierto).
+ */
+static bool loadPage(FrameList *frameList, int page) {
+    int entry = findEntry(frameList, page);
+    frameList->stats.accesses++;
+
+    int l = entry == NO_ENTRY ? LIST_FREE : frameList->list[entry];
+    if (l == LIST_T1 || l == LIST_T2) {
+        // Acierto: como en CLOCK, basta con marcar el bit de referencia
+        frameList->stats.hits++;
+        setBit(frameList->reference, entry);
+        return true;
+    }
+
+    frameList->stats.misses++;
+    int *sizes = frameList->sizes;
+    if (sizes[LIST_T1] + sizes[LIST_T2] == frameList->capacity) {
+        replaceFrame(frameList);
+        // Mantener |T1| + |B1| <= c y el total de entradas <= 2c para las páginas nuevas
+        if (l == LIST_FREE) {
+            if (sizes[LIST_T1] + sizes[LIST_B1] == frameList->capacity) {
+                discardGhost(frameList, LIST_B1);
+            } else if (sizes[LIST_FREE] == 0) {
+                discardGhost(frameList, LIST_B2);
+            }
+        }
+    }
+    if (l == LIST_FREE && sizes[LIST_FREE] == 0) {
+        // Solo ocurre si evictFrame vació frames a mano: se olvida el fantasma más antiguo disponible
+        discardGhost(frameList, sizes[LIST_B2] > 0 ? LIST_B2 : LIST_B1);
+    }
+
+    if (l == LIST_FREE) {
+        entry = frameList->heads[LIST_FREE];
+        frameList->pages[entry] = page;
+        indexInsert(frameList, entry);
+        moveEntry(frameList, entry, LIST_T1);
+    } else {
+        // Fallo fantasma: el reloj del que salió se quedó corto, ajustar p a su favor
+        if (l == LIST_B1) {
+            int step = sizes[LIST_B2] > sizes[LIST_B1] ? sizes[LIST_B2] / sizes[LIST_B1] : 1;
+            frameList->target = frameList->target + step < frameList->capacity ?
+                                frameList->target + step : frameList->capacity;
+        } else {
+            int step = sizes[LIST_B1] > sizes[LIST_B2] ? sizes[LIST_B1] / sizes[LIST_B2] : 1;
+            frameList->target = frameList->target > step ? frameList->target - step : 0;
+        }
+        moveEntry(frameList, entry, LIST_T2);
+    }
+    clearBit(frameList->reference, entry);
+    return false;
+}
+
+/*
+ * Función: printFrameList
+ * Descripción: Imprime el contenido de los dos relojes, desde su puntero, y el tamaño de las listas fantasma.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void printFrameList(FrameList *frameList) {
+    static const char *const names[NUM_LISTS] = { "Libre", "T1", "T2", "B1", "B2" };
+    printf("Estado actual de los frames (p = %d):\n", frameList->target);
+    for (int l = LIST_T1; l <= LIST_T2; l++) {
+        int entry = frameList->heads[l];
+        for (int i = 0; i < frameList->sizes[l]; i++) {
+            printf("%s - Página: %d, Referencia: %d\n", names[l], frameList->pages[entry],
+                   testBit(frameList->reference, entry));
+            entry = frameList->next[entry];
+        }
+    }
+    printf("Fantasmas: %s = %d, %s = %d\n\n", names[LIST_B1], frameList->sizes[LIST_B1],
+           names[LIST_B2], frameList->sizes[LIST_B2]);
+}
+
+/*
+ * Funciones: carCreate, carDestroy, carAccess, carEvict, carStats, carPrint, carSave, carRestore
+ * Descripción: Adaptan las funciones del algoritmo CAR a la interfaz común PolicyOps; el checkpoint
+ *              guarda los arrays de entradas (residentes y fantasmas) y el índice hash.
+ */
+static void* carCreate(int numFrames) {
+    return createFrameList(numFrames);
+}
+
+static void carDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
+
+static bool carAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page);
+}
+
+static int carEvict(void *state) {
+    return evictFrame((FrameList *)state);
+}
+
+static const SimStats* carStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
+
+static void carPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+static bool carSave(void *state, FILE *out) {
+    FrameList *frameList = (FrameList *)state;
+    size_t entries = (size_t)frameList->numEntries;
+    return saveBlock(out, frameList, sizeof(FrameList)) &&
+           saveBlock(out, frameList->pages, entries * sizeof(int)) &&
+           saveBlock(out, frameList->next, entries * sizeof(int)) &&
+           saveBlock(out, frameList->prev, entries * sizeof(int)) &&
+           saveBlock(out, frameList->hashNext, entries * sizeof(int)) &&
+           saveBlock(out, frameList->list, entries) &&
+           saveBlock(out, frameList->reference, BITMAP_WORDS(entries) * sizeof(uint64_t)) &&
+           saveBlock(out, frameList->buckets, (size_t)frameList->numBuckets * sizeof(int));
+}
+
+static bool carRestore(void *state, PolicyImage *image) {
+    FrameList *frameList = (FrameList *)state;
+    FrameList saved;
+    if (!loadBlock(image, &saved, sizeof(FrameList)) || saved.capacity != frameList->capacity) {
+        return false;
+    }
+    saved.pages = frameList->pages;  // Los punteros guardados no valen: se conservan los arrays propios
+    saved.next = frameList->next;
+    saved.prev = frameList->prev;
+    saved.hashNext = frameList->hashNext;
+    saved.list = frameList->list;
+    saved.reference = frameList->reference;
+    saved.buckets = frameList->buckets;
+    size_t entries = (size_t)saved.numEntries;
+    if (!loadBlock(image, saved.pages, entries * sizeof(int)) ||
+        !loadBlock(image, saved.next, entries * sizeof(int)) ||
+        !loadBlock(image, saved.prev, entries * sizeof(int)) ||
+        !loadBlock(image, saved.hashNext, entries * sizeof(int)) ||
+        !loadBlock(image, saved.list, entries) ||
+        !loadBlock(image, saved.reference, BITMAP_WORDS(entries) * sizeof(uint64_t)) ||
+        !loadBlock(image, saved.buckets, (size_t)saved.numBuckets * sizeof(int))) {
+        return false;
+    }
+    *frameList = saved;
+    return true;
+}
+
+const PolicyOps carPolicy = {
+    "CAR", carCreate, carDestroy, carAccess, carEvict, carStats, carPrint,
+    carSave, carRestore, NULL, NULL, NULL
+};
+
+#ifndef POLICY_LIBRARY
+/*
+ * Función: main
+ * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo CAR.
+ *              Uso: CAR-CLOCK [-t traza] [-d cadaN] [-q] [numFrames] [página ...] (ver driver.h).
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *policies[] = { &carPolicy };
+    return runDriver(argc, argv, policies, 1);
+}
+#endif
@@ -10,155 +10,392 @@
  * para marcarla como la más recientemente usada. Si la lista está llena, se elimina el frame menos 
  * recientemente utilizado (el último en la lista). 
  * 
+ * Para que cada acceso cueste tiempo constante, la lista se complementa con un índice hash
+ * (página -> Frame*) con encadenamiento intrusivo, que se mantiene al insertar y eliminar frames.
+ * Los frames provienen de un pool de capacidad fija reservado al crear la lista: los frames libres
+ * se encadenan en una lista libre intrusiva y los desalojados se reciclan sin llamar a malloc/free.
+ * 
  * El estado actual de la memoria se imprime en cada paso para depuración.
+ * 
+ * Además de LRU exacto hay dos modos de promoción que reducen el trabajo de moveToHead en los aciertos
+ * a cambio de desviarse de LRU (la desviación se ve simulándolos junto a LRU: -p lru,lru-batch,lru-hot):
+ *  - LRU-BATCH acumula los aciertos en un búfer pequeño y los aplica a la lista en lotes, como hacen
+ *    las cachés concurrentes con un búfer por hilo; un frame desalojado antes del lote se descarta.
+ *  - LRU-HOT no promueve los frames que siguen en la parte más reciente de la lista (la primera
+ *    capacity / HOT_FRACTION posiciones), donde moverlos apenas cambia el orden.
+ * 
+ * Las páginas leídas por adelantado (driver -a, ver prefetch.h) entran al frente como las demás y
+ * llevan una marca hasta su primera referencia, para contar si la lectura fue útil o desperdiciada.
+ * 
+ * Las escrituras (ops->write) marcan el frame como sucio; al desalojarlo se encola su escritura en disco
+ * en el búfer de víctimas sucias de la lista (WriteBack, ver stats.h).
+ * 
+ * Los tipos y funciones del algoritmo son privados; se exportan a través de lruPolicy (policy.h) y el
+ * main se omite al compilar con -DPOLICY_LIBRARY para enlazarlo junto a los demás en el simulador.
+ * 
+ * Compilación: gcc -O2 -pthread FIFO-LRU.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o FIFO-LRU
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "policy.h"
+#include "driver.h"
+#include "checkpoint.h"
 
-#define NUM_FRAMES 4   // Número de frames disponibles en memoria física
-#define NUM_PAGES 10   // Número total de páginas virtuales
+#define PROMOTION_BUFFER 32     // Aciertos que LRU-BATCH acumula antes de aplicarlos a la lista
+#define HOT_FRACTION 4          // LRU-HOT no promueve frames dentro de la primera cuarta parte de la lista
+#define NO_INDEX UINT32_MAX     // Índice nulo en los enlaces entre frames
 
-// Estructura para un frame en memoria física
+// Cómo se promueve un frame al frente de la lista en un acierto
+typedef enum Promotion {
+    PROMOTE_ALWAYS,     // LRU exacto: moveToHead en cada acierto
+    PROMOTE_BATCHED,    // Aciertos aplicados en lotes de PROMOTION_BUFFER
+    PROMOTE_COLD        // Solo se promueven los frames fuera de la parte más reciente
+} Promotion;
+
+// Estructura para un frame en memoria física; los enlaces son índices en el pool, no punteros, de modo
+// que el estado completo se puede volcar y recargar con memcpy (ver checkpoint.h)
 typedef struct Frame {
     int page;           // Número de la página almacenada (-1 si está vacío)
     bool valid;         // Indica si el frame está ocupado (true) o vacío (false)
-    struct Frame *prev; // Puntero al frame anterior (para lista doblemente enlazada)
-    struct Frame *next; // Puntero al frame siguiente (para lista doblemente enlazada)
+    bool prefetched;    // Cargado por lectura anticipada y todavía no referenciado
+    bool dirty;         // Modificado desde que se cargó: desalojarlo obliga a escribirlo en disco
+    uint32_t prev;      // Frame anterior (para lista doblemente enlazada)
+    uint32_t next;      // Frame siguiente (para lista doblemente enlazada)
+    uint32_t hashNext;  // Siguiente frame en la misma cubeta del índice hash
+    uint64_t stamp;     // Valor de FrameList.moves cuando el frame llegó al frente
 } Frame;
 
+// Acierto pendiente de aplicar a la lista (LRU-BATCH)
+typedef struct PendingHit {
+    uint32_t frame;     // Frame referenciado
+    int page;           // Página que tenía al referenciarse (si cambia, el frame se desalojó)
+} PendingHit;
+
 // Estructura para administrar la lista de frames en memoria física
 typedef struct FrameList {
+    int capacity;       // Número de frames disponibles en memoria física
     int numFrames;      // Número de frames ocupados actualmente
-    Frame *head;        // Puntero al primer frame (más recientemente usado)
-    Frame *tail;        // Puntero al último frame (menos recientemente usado)
+    uint32_t head;      // Primer frame (más recientemente usado)
+    uint32_t tail;      // Último frame (menos recientemente usado)
+    uint32_t *buckets;  // Cubetas del índice hash página -> frame
+    int numBuckets;     // Número de cubetas (potencia de 2)
+    Frame *pool;        // Pool contiguo de capacity frames reservado al crear la lista
+    uint32_t freeFrames;    // Lista libre intrusiva (enlazada por next) de frames sin usar
+    Promotion promotion;    // Modo de promoción en los aciertos
+    uint64_t moves;         // Frames llevados al frente (una posición más de distancia para los demás)
+    PendingHit pending[PROMOTION_BUFFER];   // Aciertos pendientes (LRU-BATCH)
+    int numPending;         // Aciertos en pending
+    WriteBack writeBack;    // Víctimas sucias pendientes de escribir en disco
+    SimStats stats;     // Contadores de accesos, aciertos, fallos y desalojos
 } FrameList;
 
 /*
  * Función: createFrame
- * Descripción: Crea e inicializa un nuevo frame vacío.
- * Retorna: Puntero al frame creado.
+ * Descripción: Toma un frame vacío de la lista libre del pool.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Índice del frame obtenido, o NO_INDEX si el pool está agotado.
  */
-Frame* createFrame() {
-    Frame *frame = (Frame *)malloc(sizeof(Frame));
-    if (frame != NULL) {
+static uint32_t createFrame(FrameList *frameList) {
+    uint32_t index = frameList->freeFrames;
+    if (index != NO_INDEX) {
+        Frame *frame = &frameList->pool[index];
+        frameList->freeFrames = frame->next;
         frame->page = -1;
         frame->valid = false;
-        frame->prev = NULL;
-        frame->next = NULL;
+        frame->prefetched = false;
+        frame->dirty = false;
+        frame->prev = NO_INDEX;
+        frame->next = NO_INDEX;
+        frame->hashNext = NO_INDEX;
     }
-    return frame;
+    return index;
 }
 
 /*
  * Función: createFrameList
  * Descripción: Inicializa una lista vacía de frames.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ *  - promotion: Modo de promoción en los aciertos.
  * Retorna: Puntero a la lista creada.
  */
-FrameList* createFrameList() {
+static FrameList* createFrameList(int capacity, Promotion promotion) {
     FrameList *frameList = (FrameList *)malloc(sizeof(FrameList));
     if (frameList != NULL) {
+        frameList->capacity = capacity;
         frameList->numFrames = 0;
-        frameList->head = NULL;
-        frameList->tail = NULL;
+        frameList->promotion = promotion;
+        frameList->moves = 0;
+        frameList->numPending = 0;
+        frameList->writeBack.count = 0;
+        frameList->stats = (SimStats){0};
+        frameList->head = NO_INDEX;
+        frameList->tail = NO_INDEX;
+
+        // Al menos el doble de cubetas que frames para mantener las cadenas cortas
+        frameList->numBuckets = 1;
+        while (frameList->numBuckets < 2 * capacity) {
+            frameList->numBuckets <<= 1;
+        }
+        frameList->buckets = (uint32_t *)malloc((size_t)frameList->numBuckets * sizeof(uint32_t));
+        frameList->pool = (Frame *)malloc((size_t)capacity * sizeof(Frame));
+        if (frameList->buckets == NULL || frameList->pool == NULL) {
+            free(frameList->buckets);
+            free(frameList->pool);
+            free(frameList);
+            return NULL;
+        }
+        for (int i = 0; i < frameList->numBuckets; i++) {
+            frameList->buckets[i] = NO_INDEX;
+        }
+
+        // Encadenar todo el pool en la lista libre, en orden de dirección
+        frameList->freeFrames = NO_INDEX;
+        for (int i = capacity - 1; i >= 0; i--) {
+            frameList->pool[i].next = frameList->freeFrames;
+            frameList->freeFrames = (uint32_t)i;
+        }
     }
     return frameList;
 }
 
+/*
+ * Función: destroyFrameList
+ * Descripción: Libera el pool de frames, el índice hash y la propia lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void destroyFrameList(FrameList *frameList) {
+    free(frameList->pool);
+    free(frameList->buckets);
+    free(frameList);
+}
+
+/*
+ * Función: hashPage
+ * Descripción: Calcula la cubeta del índice hash que corresponde a una página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static int hashPage(const FrameList *frameList, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (int)(h & (uint32_t)(frameList->numBuckets - 1));
+}
+
+/*
+ * Función: indexInsert
+ * Descripción: Registra un frame en el índice hash bajo su número de página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame que se va a registrar.
+ */
+static void indexInsert(FrameList *frameList, uint32_t index) {
+    int bucket = hashPage(frameList, frameList->pool[index].page);
+    frameList->pool[index].hashNext = frameList->buckets[bucket];
+    frameList->buckets[bucket] = index;
+}
+
+/*
+ * Función: indexRemove
+ * Descripción: Quita un frame del índice hash.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame que se va a quitar.
+ */
+static void indexRemove(FrameList *frameList, uint32_t index) {
+    uint32_t *link = &frameList->buckets[hashPage(frameList, frameList->pool[index].page)];
+    while (*link != NO_INDEX) {
+        if (*link == index) {
+            *link = frameList->pool[index].hashNext;
+            frameList->pool[index].hashNext = NO_INDEX;
+            return;
+        }
+        link = &frameList->pool[*link].hashNext;
+    }
+}
+
 /*
  * Función: insertFrame
  * Descripción: Inserta un frame al frente de la lista.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - frame: Puntero al frame que se va a insertar.
+ *  - index: Índice del frame que se va a insertar.
  */
-void insertFrame(FrameList *frameList, Frame *frame) {
-    if (frameList->head == NULL) {
-        frameList->head = frame;
-        frameList->tail = frame;
+static void insertFrame(FrameList *frameList, uint32_t index) {
+    Frame *frame = &frameList->pool[index];
+    if (frameList->head == NO_INDEX) {
+        frameList->head = index;
+        frameList->tail = index;
     } else {
         frame->next = frameList->head;
-        frameList->head->prev = frame;
-        frameList->head = frame;
+        frameList->pool[frameList->head].prev = index;
+        frameList->head = index;
     }
+    frame->stamp = ++frameList->moves;
+    indexInsert(frameList, index);
     frameList->numFrames++;
 }
 
+/*
+ * Función: unlinkFrame
+ * Descripción: Desconecta un frame de la lista, sin tocar el índice hash.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame que se va a desconectar.
+ */
+static void unlinkFrame(FrameList *frameList, uint32_t index) {
+    Frame *frame = &frameList->pool[index];
+    if (frame->prev != NO_INDEX) {
+        frameList->pool[frame->prev].next = frame->next;
+    } else {
+        frameList->head = frame->next;
+    }
+    if (frame->next != NO_INDEX) {
+        frameList->pool[frame->next].prev = frame->prev;
+    } else {
+        frameList->tail = frame->prev;
+    }
+}
+
 /*
  * Función: moveToHead
  * Descripción: Mueve un frame al frente de la lista, marcándolo como el más recientemente usado.
+ *              El índice hash no cambia: la página sigue asociada al mismo frame.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - frame: Puntero al frame que se va a mover.
+ *  - index: Índice del frame que se va a mover.
  */
-void moveToHead(FrameList *frameList, Frame *frame) {
-    if (frameList->head == frame) {
+static void moveToHead(FrameList *frameList, uint32_t index) {
+    if (frameList->head == index) {
         return; // Ya está al frente
     }
 
-    // Desconectar el frame de su posición actual
-    if (frame->prev != NULL) {
-        frame->prev->next = frame->next;
-    }
-    if (frame->next != NULL) {
-        frame->next->prev = frame->prev;
-    }
-    if (frameList->tail == frame) {
-        frameList->tail = frame->prev;
-    }
+    // Desconectar el frame de su posición actual (no es el primero, así que la lista no queda vacía)
+    unlinkFrame(frameList, index);
 
     // Mover el frame al frente de la lista
+    Frame *frame = &frameList->pool[index];
     frame->next = frameList->head;
-    frame->prev = NULL;
-    if (frameList->head != NULL) {
-        frameList->head->prev = frame;
-    }
-    frameList->head = frame;
-    if (frameList->tail == NULL) {
-        frameList->tail = frame;
-    }
+    frame->prev = NO_INDEX;
+    frameList->pool[frameList->head].prev = index;
+    frameList->head = index;
+    frame->stamp = ++frameList->moves;
 }
 
 /*
  * Función: removeFrame
- * Descripción: Elimina el frame menos recientemente usado (tail) de la lista.
+ * Descripción: Elimina un frame de la lista y lo devuelve a la lista libre del pool.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - frame: Puntero al frame que se va a eliminar.
+ *  - index: Índice del frame que se va a eliminar.
  */
-void removeFrame(FrameList *frameList, Frame *frame) {
-    if (frame->prev != NULL) {
-        frame->prev->next = frame->next;
-    } else {
-        frameList->head = frame->next;
-    }
-    if (frame->next != NULL) {
-        frame->next->prev = frame->prev;
-    } else {
-        frameList->tail = frame->prev;
-    }
+static void removeFrame(FrameList *frameList, uint32_t index) {
+    unlinkFrame(frameList, index);
+    indexRemove(frameList, index);
     frameList->numFrames--;
-    free(frame); // Liberar la memoria del frame eliminado
+
+    // Devolver el frame al pool para reciclarlo
+    Frame *frame = &frameList->pool[index];
+    frame->page = -1;
+    frame->valid = false;
+    frame->prev = NO_INDEX;
+    frame->next = frameList->freeFrames;
+    frameList->freeFrames = index;
 }
 
 /*
  * Función: findFrame
- * Descripción: Busca un frame en la lista por su número de página.
+ * Descripción: Busca un frame por su número de página a través del índice hash.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  *  - page: Número de la página que se busca.
- * Retorna: Puntero al frame encontrado, o NULL si no está en la lista.
+ * Retorna: Índice del frame encontrado, o NO_INDEX si no está en la lista.
  */
-Frame* findFrame(FrameList *frameList, int page) {
-    Frame *current = frameList->head;
-    while (current != NULL) {
-        if (current->page == page) {
+static uint32_t findFrame(FrameList *frameList, int page) {
+    uint32_t current = frameList->buckets[hashPage(frameList, page)];
+    INSTRUMENT(frameList->stats.lookups++);
+    while (current != NO_INDEX) {
+        INSTRUMENT(frameList->stats.lookupSteps++);
+        if (frameList->pool[current].page == page) {
             return current;
         }
-        current = current->next;
+        current = frameList->pool[current].hashNext;
     }
-    return NULL;
+    return NO_INDEX;
+}
+
+/*
+ * Función: flushPromotions
+ * Descripción: Aplica a la lista los aciertos pendientes de LRU-BATCH, en el orden en que ocurrieron.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void flushPromotions(FrameList *frameList) {
+    for (int i = 0; i < frameList->numPending; i++) {
+        PendingHit *hit = &frameList->pending[i];
+        const Frame *frame = &frameList->pool[hit->frame];
+        if (frame->valid && frame->page == hit->page) {
+            moveToHead(frameList, hit->frame);
+        }
+    }
+    frameList->numPending = 0;
+}
+
+/*
+ * Función: promoteFrame
+ * Descripción: Marca un frame como recién usado según el modo de promoción de la lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame referenciado.
+ */
+static void promoteFrame(FrameList *frameList, uint32_t index) {
+    if (frameList->promotion == PROMOTE_BATCHED) {
+        frameList->pending[frameList->numPending].frame = index;
+        frameList->pending[frameList->numPending].page = frameList->pool[index].page;
+        if (++frameList->numPending == PROMOTION_BUFFER) {
+            flushPromotions(frameList);
+        }
+    } else if (frameList->promotion == PROMOTE_COLD) {
+        // Desde que llegó al frente, cada frame movido lo ha alejado como mucho una posición
+        if (frameList->moves - frameList->pool[index].stamp >= (uint64_t)(frameList->capacity / HOT_FRACTION)) {
+            moveToHead(frameList, index);
+        }
+    } else {
+        moveToHead(frameList, index);
+    }
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja el frame menos recientemente usado (tail) y lo devuelve al pool.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Página desalojada, o -1 si la lista está vacía.
+ */
+static int evictFrame(FrameList *frameList) {
+    uint32_t lruFrame = frameList->tail;
+    if (lruFrame == NO_INDEX) {
+        return -1;
+    }
+    int page = frameList->pool[lruFrame].page;
+    if (frameList->pool[lruFrame].prefetched) {
+        frameList->stats.prefetchWasted++;  // Leída por adelantado y nunca pedida
+    }
+    if (frameList->pool[lruFrame].dirty) {
+        recordWriteBack(&frameList->writeBack, &frameList->stats, page);
+    }
+    removeFrame(frameList, lruFrame);
+    frameList->stats.evictions++;
+    return page;
 }
 
 /*
@@ -167,23 +404,61 @@ Frame* findFrame(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  *  - page: Número de la página a cargar.
+ *  - write: true si el acceso modifica la página.
+ * Retorna: true si la página ya estaba en memoria (acierto).
  */
-void loadPage(FrameList *frameList, int page) {
-    Frame *frame = findFrame(frameList, page);
-    if (frame != NULL) {
-        moveToHead(frameList, frame);  // Mover al frente si ya está en memoria
-    } else {
-        frame = createFrame();
-        frame->page = page;
-        frame->valid = true;
-
-        // Eliminar el frame menos recientemente usado si la lista está llena
-        if (frameList->numFrames == NUM_FRAMES) {
-            Frame *lruFrame = frameList->tail;
-            removeFrame(frameList, lruFrame);
+static bool loadPage(FrameList *frameList, int page, bool write) {
+    uint32_t index = findFrame(frameList, page);
+    frameList->stats.accesses++;
+    frameList->stats.writes += write;
+    if (index != NO_INDEX) {
+        frameList->stats.hits++;
+        frameList->pool[index].dirty |= write;
+        if (frameList->pool[index].prefetched) {
+            frameList->pool[index].prefetched = false;
+            frameList->stats.prefetchHits++;
         }
-        insertFrame(frameList, frame);  // Insertar el nuevo frame al frente
+        promoteFrame(frameList, index);  // Mover al frente (o anotarlo) si ya está en memoria
+        return true;
+    }
+    frameList->stats.misses++;
+
+    // Eliminar el frame menos recientemente usado si la lista está llena;
+    // su frame vuelve al pool y se reutiliza de inmediato para la nueva página
+    if (frameList->numFrames == frameList->capacity) {
+        evictFrame(frameList);
+    }
+    index = createFrame(frameList);
+    frameList->pool[index].page = page;
+    frameList->pool[index].valid = true;
+    frameList->pool[index].dirty = write;
+    insertFrame(frameList, index);  // Insertar el nuevo frame al frente
+    return false;
+}
+
+/*
+ * Función: prefetchPage
+ * Descripción: Carga una página por adelantado, sin contarla como acceso. Entra al frente de la lista
+ *              como una carga por demanda, así que sobrevive a capacity cargas antes de desalojarse.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página a cargar.
+ * Retorna: true si se cargó (false si ya estaba en memoria).
+ */
+static bool prefetchPage(FrameList *frameList, int page) {
+    if (findFrame(frameList, page) != NO_INDEX) {
+        return false;
     }
+    if (frameList->numFrames == frameList->capacity) {
+        evictFrame(frameList);
+    }
+    uint32_t index = createFrame(frameList);
+    frameList->pool[index].page = page;
+    frameList->pool[index].valid = true;
+    frameList->pool[index].prefetched = true;
+    insertFrame(frameList, index);
+    frameList->stats.prefetches++;
+    return true;
 }
 
 /*
@@ -192,37 +467,114 @@ void loadPage(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  */
-void printFrameList(FrameList *frameList) {
+static void printFrameList(FrameList *frameList) {
     printf("Estado actual de los frames:\n");
-    Frame *current = frameList->head;
-    while (current != NULL) {
-        printf("Página: %d, Estado: %s\n", current->page,
-               current->valid ? "Ocupado" : "Vacío");
-        current = current->next;
+    for (uint32_t current = frameList->head; current != NO_INDEX; current = frameList->pool[current].next) {
+        const Frame *frame = &frameList->pool[current];
+        printf("Página: %d, Estado: %s%s\n", frame->page, frame->valid ? "Ocupado" : "Vacío",
+               frame->dirty ? ", Sucio" : "");
+    }
+    if (frameList->numPending > 0) {
+        printf("Aciertos pendientes de aplicar: %d\n", frameList->numPending);
     }
     printf("\n");
 }
 
 /*
- * Función: main
- * Descripción: Función principal que simula la carga de páginas en memoria usando LRU.
+ * Funciones: lruCreate, lruBatchCreate, lruHotCreate, lruDestroy, lruAccess, lruEvict, lruStats, lruPrint,
+ *            lruSave, lruRestore, lruPrefetch, lruWrite
+ * Descripción: Adaptan las funciones del algoritmo LRU a la interfaz común PolicyOps; las tres
+ *              variantes solo difieren en el modo de promoción con el que se crea la lista. El checkpoint
+ *              guarda la lista, el pool y el índice hash tal cual, incluidos los aciertos pendientes.
  */
-int main() {
-    FrameList *frameList = createFrameList();
+static void* lruCreate(int numFrames) {
+    return createFrameList(numFrames, PROMOTE_ALWAYS);
+}
+
+static void* lruBatchCreate(int numFrames) {
+    return createFrameList(numFrames, PROMOTE_BATCHED);
+}
 
-    // Simular la carga de páginas en memoria
-    loadPage(frameList, 1);
-    loadPage(frameList, 2);
-    loadPage(frameList, 3);
-    loadPage(frameList, 4);
-    printFrameList(frameList);  // Imprimir el estado actual de los frames
+static void* lruHotCreate(int numFrames) {
+    return createFrameList(numFrames, PROMOTE_COLD);
+}
 
-    // Intentar cargar otra página con todos los frames ocupados
-    loadPage(frameList, 5);
-    printFrameList(frameList);  // Imprimir el estado después de la sustitución
+static void lruDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
 
-    // Liberar la memoria utilizada por la lista de frames
-    free(frameList);
+static bool lruAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page, false);
+}
 
-    return 0;
+static bool lruWrite(void *state, int page) {
+    return loadPage((FrameList *)state, page, true);
+}
+
+static int lruEvict(void *state) {
+    return evictFrame((FrameList *)state);
+}
+
+static const SimStats* lruStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
+
+static void lruPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+static bool lruPrefetch(void *state, int page) {
+    return prefetchPage((FrameList *)state, page);
+}
+
+static bool lruSave(void *state, FILE *out) {
+    FrameList *frameList = (FrameList *)state;
+    return saveBlock(out, frameList, sizeof(FrameList)) &&
+           saveBlock(out, frameList->pool, (size_t)frameList->capacity * sizeof(Frame)) &&
+           saveBlock(out, frameList->buckets, (size_t)frameList->numBuckets * sizeof(uint32_t));
+}
+
+static bool lruRestore(void *state, PolicyImage *image) {
+    FrameList *frameList = (FrameList *)state;
+    FrameList saved;
+    if (!loadBlock(image, &saved, sizeof(FrameList)) || saved.capacity != frameList->capacity ||
+        saved.promotion != frameList->promotion) {
+        return false;
+    }
+    saved.pool = frameList->pool;  // Los punteros guardados no valen: se conservan los arrays propios
+    saved.buckets = frameList->buckets;
+    if (!loadBlock(image, saved.pool, (size_t)saved.capacity * sizeof(Frame)) ||
+        !loadBlock(image, saved.buckets, (size_t)saved.numBuckets * sizeof(uint32_t))) {
+        return false;
+    }
+    *frameList = saved;
+    return true;
+}
+
+const PolicyOps lruPolicy = {
+    "LRU", lruCreate, lruDestroy, lruAccess, lruEvict, lruStats, lruPrint,
+    lruSave, lruRestore, NULL, lruPrefetch, lruWrite
+};
+
+const PolicyOps lruBatchPolicy = {
+    "LRU-BATCH", lruBatchCreate, lruDestroy, lruAccess, lruEvict, lruStats, lruPrint,
+    lruSave, lruRestore, NULL, lruPrefetch, lruWrite
+};
+
+const PolicyOps lruHotPolicy = {
+    "LRU-HOT", lruHotCreate, lruDestroy, lruAccess, lruEvict, lruStats, lruPrint,
+    lruSave, lruRestore, NULL, lruPrefetch, lruWrite
+};
+
+#ifndef POLICY_LIBRARY
+/*
+ * Función: main
+ * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo LRU.
+ *              Uso: FIFO-LRU [-p LRU|LRU-BATCH|LRU-HOT,...] [-t traza] [-d cadaN] [-q] [numFrames] [página ...]
+ *              (ver driver.h).
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *policies[] = { &lruPolicy, &lruBatchPolicy, &lruHotPolicy };
+    return runDriver(argc, argv, policies, 3);
 }
+#endif
@@ -11,43 +11,101 @@
  * 
  * Cada vez que se accede a una página, su bit de referencia se actualiza. Si es necesario reemplazar una página, 
  * el algoritmo busca un frame con bit de referencia en 0 para realizar la sustitución.
+ * 
+ * Los tipos y funciones del algoritmo son privados; se exportan a través de clockPolicy (policy.h) y el
+ * main se omite al compilar con -DPOLICY_LIBRARY para enlazarlo junto a los demás en el simulador.
+ * 
+ * Los frames se guardan como estructura de arrays: un array contiguo con la página de cada frame y dos
+ * mapas de bits (ocupado y referencia), de modo que findFrame y el puntero del reloj recorren memoria
+ * contigua con los núcleos vectoriales de framescan.h.
+ * 
+ * Las páginas leídas por adelantado (driver -a, ver prefetch.h) entran con el bit de referencia a 1, como
+ * una carga por demanda: con el bit a 0, en cuanto el puntero da una vuelta limpiando bits el lote recién
+ * leído es lo primero que encuentra y se desaloja antes de pedirse. Un tercer mapa de bits las marca hasta
+ * su primera referencia, para contar si la lectura fue útil o desperdiciada.
+ * 
+ * Las escrituras (ops->write) ponen a 1 el bit de sucio del frame; al desalojarlo se encola su escritura
+ * en disco (WriteBack, ver stats.h). CLOCK-ESC es la variante de segunda oportunidad mejorada: el reloj
+ * clasifica los frames por (referencia, sucio) y prefiere, por este orden, (0,0), (0,1), (1,0) y (1,1):
+ *  1. Busca desde el puntero un frame (0,0) sin tocar ningún bit.
+ *  2. Si no lo hay, busca uno (0,1) poniendo a 0 los bits de referencia que encuentra en el camino.
+ *  3. Si tampoco, todos estaban referenciados y la vuelta los ha limpiado: repite el paso 1, y si todos
+ *     están sucios se queda con el frame del puntero.
+ * Así una página limpia no referenciada sale antes que una sucia, que costaría una escritura en disco.
+ * 
+ * Compilación: gcc -O2 -march=native -pthread LRU-CLOCK.c framescan.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o LRU-CLOCK
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
-#define NUM_FRAMES 4   // Número de frames disponibles en memoria física
-#define NUM_PAGES 10   // Número total de páginas virtuales
-
-// Estructura para un frame en memoria física
-typedef struct Frame {
-    int page;           // Número de la página almacenada (-1 si está vacío)
-    bool valid;         // Indica si el frame está ocupado (true) o vacío (false)
-    bool reference;     // Bit de referencia para el algoritmo Clock
-} Frame;
+#include "policy.h"
+#include "driver.h"
+#include "framescan.h"
+#include "checkpoint.h"
 
 // Estructura para administrar la lista de frames en memoria física
 typedef struct FrameList {
-    int numFrames;      // Número de frames actualmente ocupados
-    Frame frames[NUM_FRAMES]; // Array que almacena los frames
-    int clockHand;      // Puntero del reloj (clock hand)
+    int capacity;           // Número de frames disponibles en memoria física
+    int numFrames;          // Número de frames actualmente ocupados
+    int *pages;             // Página almacenada en cada frame (-1 si está vacío)
+    uint64_t *valid;        // Mapa de bits: frame ocupado
+    uint64_t *reference;    // Mapa de bits: bit de referencia del algoritmo Clock (0 en los frames vacíos)
+    uint64_t *prefetched;   // Mapa de bits: cargado por lectura anticipada y todavía no referenciado
+    uint64_t *dirty;        // Mapa de bits: modificado desde que se cargó
+    int clockHand;          // Puntero del reloj (clock hand)
+    bool enhanced;          // Segunda oportunidad mejorada: preferir víctimas limpias (CLOCK-ESC)
+    WriteBack writeBack;    // Víctimas sucias pendientes de escribir en disco
+    SimStats stats;         // Contadores de accesos, aciertos, fallos y desalojos
 } FrameList;
 
+/*
+ * Función: destroyFrameList
+ * Descripción: Libera los arrays de frames y la propia lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void destroyFrameList(FrameList *frameList) {
+    free(frameList->pages);
+    free(frameList->valid);
+    free(frameList->reference);
+    free(frameList->prefetched);
+    free(frameList->dirty);
+    free(frameList);
+}
+
 /*
  * Función: createFrameList
  * Descripción: Inicializa la lista de frames en memoria física.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ *  - enhanced: true para la segunda oportunidad mejorada (CLOCK-ESC).
  * Retorna: Puntero a la lista creada.
  */
-FrameList* createFrameList() {
+static FrameList* createFrameList(int capacity, bool enhanced) {
     FrameList *frameList = (FrameList *)malloc(sizeof(FrameList));
     if (frameList != NULL) {
+        frameList->pages = (int *)malloc((size_t)capacity * sizeof(int));
+        frameList->valid = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        frameList->reference = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        frameList->prefetched = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        frameList->dirty = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        if (frameList->pages == NULL || frameList->valid == NULL || frameList->reference == NULL ||
+            frameList->prefetched == NULL || frameList->dirty == NULL) {
+            destroyFrameList(frameList);
+            return NULL;
+        }
+        frameList->capacity = capacity;
         frameList->numFrames = 0;
+        frameList->stats = (SimStats){0};
         frameList->clockHand = 0;  // Inicializar el puntero del reloj en 0
-        for (int i = 0; i < NUM_FRAMES; i++) {
-            frameList->frames[i].page = -1;
-            frameList->frames[i].valid = false;
-            frameList->frames[i].reference = false;
+        frameList->enhanced = enhanced;
+        frameList->writeBack.count = 0;
+        for (int i = 0; i < capacity; i++) {
+            frameList->pages[i] = -1;
         }
     }
     return frameList;
@@ -58,16 +116,191 @@ FrameList* createFrameList() {
  * Descripción: Busca un frame en la lista por su número de página.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - page: Número de la página que se busca.
+ *  - page: Número de la página que se busca (no negativa: -1 marca los frames vacíos).
  * Retorna: Índice del frame encontrado o -1 si no está en la lista.
  */
-int findFrame(FrameList *frameList, int page) {
-    for (int i = 0; i < NUM_FRAMES; i++) {
-        if (frameList->frames[i].page == page) {
-            return i;
+static int findFrame(FrameList *frameList, int page) {
+    int index = findPageIndex(frameList->pages, frameList->capacity, page);
+    INSTRUMENT(frameList->stats.lookups++);
+    INSTRUMENT(frameList->stats.lookupSteps += index >= 0 ? (uint64_t)index + 1 : (uint64_t)frameList->capacity);
+    return index;
+}
+
+/*
+ * Función: advanceHand
+ * Descripción: Avanza el puntero del reloj hasta un frame vacío o con bit de referencia en 0,
+ *              poniendo a 0 los bits de referencia que encuentra en el camino.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Índice del frame encontrado; el puntero queda en el frame siguiente.
+ */
+static int advanceHand(FrameList *frameList) {
+    int hand = frameList->clockHand;
+    // Los frames vacíos tienen el bit de referencia en 0, así que la víctima es el siguiente 0 desde el
+    // puntero; el recorrido limpia una palabra de 64 bits por paso en lugar de un frame
+    int victim = sweepZeroBit(frameList->reference, hand, frameList->capacity);
+    INSTRUMENT(frameList->stats.handSteps += victim >= 0 ? (uint64_t)(victim - hand) + 1 :
+                                                          (uint64_t)(frameList->capacity - hand));
+    if (victim < 0) {
+        victim = sweepZeroBit(frameList->reference, 0, hand);
+        INSTRUMENT(frameList->stats.handSteps += victim >= 0 ? (uint64_t)victim + 1 : (uint64_t)hand + 1);
+    }
+    if (victim < 0) {
+        victim = hand;  // Todos los bits estaban a 1: tras la vuelta completa gana el frame del puntero
+    }
+    frameList->clockHand = (victim + 1) % frameList->capacity;
+    return victim;
+}
+
+/*
+ * Función: findCleanFrame
+ * Descripción: Busca el primer frame de [start, end) con los bits de referencia y de sucio a 0, palabra a
+ *              palabra, sin modificar ningún bit.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - start: Primer frame del rango.
+ *  - end: Frame siguiente al último del rango.
+ *  - occupied: true para saltar también los frames vacíos.
+ * Retorna: Índice del frame encontrado, o -1 si no hay ninguno.
+ */
+static int findCleanFrame(const FrameList *frameList, int start, int end, bool occupied) {
+    if (start >= end) {
+        return -1;
+    }
+    size_t word = (size_t)start / BITS_PER_WORD;
+    size_t lastWord = (size_t)(end - 1) / BITS_PER_WORD;
+    uint64_t mask = ~(uint64_t)0 << (start % BITS_PER_WORD);
+    for (;; word++, mask = ~(uint64_t)0) {
+        if (word == lastWord) {
+            mask &= ~(uint64_t)0 >> (BITS_PER_WORD - 1 - (end - 1) % BITS_PER_WORD);
+        }
+        uint64_t busy = frameList->reference[word] | frameList->dirty[word] |
+                        (occupied ? ~frameList->valid[word] : 0);
+        uint64_t clean = ~busy & mask;
+        if (clean != 0) {
+            return (int)(word * BITS_PER_WORD) + __builtin_ctzll(clean);
+        }
+        if (word == lastWord) {
+            return -1;
+        }
+    }
+}
+
+/*
+ * Función: advanceHandEnhanced
+ * Descripción: Elige la víctima de la segunda oportunidad mejorada (ver la descripción del archivo).
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - occupied: true para no elegir en el paso 1 frames vacíos (evict necesita un frame ocupado).
+ * Retorna: Índice del frame encontrado; el puntero queda en el frame siguiente.
+ */
+static int advanceHandEnhanced(FrameList *frameList, bool occupied) {
+    int hand = frameList->clockHand;
+    int capacity = frameList->capacity;
+    int victim = findCleanFrame(frameList, hand, capacity, occupied);
+    if (victim < 0) {
+        victim = findCleanFrame(frameList, 0, hand, occupied);
+    }
+    int laps = 0;
+    if (victim < 0) {   // Paso 2: la primera sin referenciar, limpiando los bits del camino
+        laps = 1;
+        victim = sweepZeroBit(frameList->reference, hand, capacity);
+        if (victim < 0) {
+            victim = sweepZeroBit(frameList->reference, 0, hand);
+        }
+    }
+    if (victim < 0) {   // Paso 3: todas estaban referenciadas y ya no lo están
+        laps = 2;
+        victim = findCleanFrame(frameList, hand, capacity, occupied);
+        if (victim < 0) {
+            victim = findCleanFrame(frameList, 0, hand, occupied);
         }
     }
-    return -1;
+    if (victim < 0) {
+        laps = 3;
+        victim = hand;  // Todos los frames están sucios: gana el del puntero
+    }
+    (void)laps;     // Vueltas completas del puntero, solo para la instrumentación
+    INSTRUMENT(frameList->stats.handSteps += (uint64_t)laps * (uint64_t)capacity +
+                                             (uint64_t)((victim - hand + capacity) % capacity) + 1);
+    frameList->clockHand = (victim + 1) % capacity;
+    return victim;
+}
+
+/*
+ * Función: chooseVictim
+ * Descripción: Avanza el reloj de la variante de la lista hasta su víctima.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - occupied: true si la víctima tiene que ser un frame ocupado (solo lo tiene en cuenta CLOCK-ESC).
+ * Retorna: Índice del frame encontrado; el puntero queda en el frame siguiente.
+ */
+static int chooseVictim(FrameList *frameList, bool occupied) {
+    return frameList->enhanced ? advanceHandEnhanced(frameList, occupied) : advanceHand(frameList);
+}
+
+/*
+ * Función: releaseVictim
+ * Descripción: Cuenta el desalojo del frame ocupado elegido como víctima: la lectura anticipada
+ *              desperdiciada si no llegó a pedirse y la escritura en disco si está sucio.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - victim: Frame ocupado que se desaloja.
+ */
+static void releaseVictim(FrameList *frameList, int victim) {
+    frameList->stats.evictions++;
+    if (testBit(frameList->prefetched, victim)) {
+        frameList->stats.prefetchWasted++;  // Leída por adelantado y nunca pedida
+        clearBit(frameList->prefetched, victim);
+    }
+    if (testBit(frameList->dirty, victim)) {
+        recordWriteBack(&frameList->writeBack, &frameList->stats, frameList->pages[victim]);
+        clearBit(frameList->dirty, victim);
+    }
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja el siguiente frame ocupado con bit de referencia en 0 según el reloj.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Página desalojada, o -1 si no hay frames ocupados.
+ */
+static int evictFrame(FrameList *frameList) {
+    if (frameList->numFrames == 0) {
+        return -1;
+    }
+    int victim;
+    do {
+        victim = chooseVictim(frameList, true);
+    } while (!testBit(frameList->valid, victim));
+
+    int page = frameList->pages[victim];
+    releaseVictim(frameList, victim);
+    frameList->pages[victim] = -1;
+    clearBit(frameList->valid, victim);
+    clearBit(frameList->reference, victim);
+    frameList->numFrames--;
+    return page;
+}
+
+/*
+ * Función: occupyFrame
+ * Descripción: Guarda una página en el frame elegido por el reloj, contando el desalojo si estaba ocupado.
+ *              El frame queda limpio y sin la marca de lectura anticipada.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - frameIndex: Frame elegido por chooseVictim.
+ *  - page: Número de la página.
+ */
+static void occupyFrame(FrameList *frameList, int frameIndex, int page) {
+    if (testBit(frameList->valid, frameIndex)) {
+        releaseVictim(frameList, frameIndex);
+    } else {
+        frameList->numFrames++;
+    }
+    frameList->pages[frameIndex] = page;
+    setBit(frameList->valid, frameIndex);
 }
 
 /*
@@ -76,31 +309,57 @@ int findFrame(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  *  - page: Número de la página a cargar.
+ *  - write: true si el acceso modifica la página.
+ * Retorna: true si la página ya estaba en memoria (acierto).
  */
-void loadPage(FrameList *frameList, int page) {
+static bool loadPage(FrameList *frameList, int page, bool write) {
     int frameIndex = findFrame(frameList, page);
+    frameList->stats.accesses++;
+    frameList->stats.writes += write;
 
     if (frameIndex != -1) {
         // La página ya está en memoria, actualizar el bit de referencia
-        frameList->frames[frameIndex].reference = true;
-    } else {
-        // La página no está en memoria, buscar un frame para reemplazar
-        while (true) {
-            if (!frameList->frames[frameList->clockHand].valid || 
-                !frameList->frames[frameList->clockHand].reference) {
-                // Encontrar un frame vacío o con bit de referencia en 0
-                frameList->frames[frameList->clockHand].page = page;
-                frameList->frames[frameList->clockHand].valid = true;
-                frameList->frames[frameList->clockHand].reference = true;
-                frameList->clockHand = (frameList->clockHand + 1) % NUM_FRAMES;
-                break;
-            } else {
-                // Poner el bit de referencia en 0 y avanzar el puntero del reloj
-                frameList->frames[frameList->clockHand].reference = false;
-                frameList->clockHand = (frameList->clockHand + 1) % NUM_FRAMES;
-            }
+        frameList->stats.hits++;
+        if (testBit(frameList->prefetched, frameIndex)) {
+            clearBit(frameList->prefetched, frameIndex);
+            frameList->stats.prefetchHits++;
         }
+        if (write) {
+            setBit(frameList->dirty, frameIndex);
+        }
+        setBit(frameList->reference, frameIndex);
+        return true;
+    }
+
+    // La página no está en memoria: el reloj elige un frame vacío o la víctima
+    frameList->stats.misses++;
+    frameIndex = chooseVictim(frameList, false);
+    occupyFrame(frameList, frameIndex, page);
+    if (write) {
+        setBit(frameList->dirty, frameIndex);
+    }
+    setBit(frameList->reference, frameIndex);
+    return false;
+}
+
+/*
+ * Función: prefetchPage
+ * Descripción: Carga una página por adelantado, sin contarla como acceso.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página a cargar.
+ * Retorna: true si se cargó (false si ya estaba en memoria).
+ */
+static bool prefetchPage(FrameList *frameList, int page) {
+    if (findFrame(frameList, page) != -1) {
+        return false;
     }
+    int frameIndex = chooseVictim(frameList, false);
+    occupyFrame(frameList, frameIndex, page);
+    setBit(frameList->reference, frameIndex);
+    setBit(frameList->prefetched, frameIndex);
+    frameList->stats.prefetches++;
+    return true;
 }
 
 /*
@@ -109,37 +368,114 @@ void loadPage(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  */
-void printFrameList(FrameList *frameList) {
+static void printFrameList(FrameList *frameList) {
     printf("Estado actual de los frames:\n");
-    for (int i = 0; i < NUM_FRAMES; i++) {
-        printf("Frame %d - Página: %d, Estado: %s, Referencia: %d\n", 
-               i, frameList->frames[i].page,
-               frameList->frames[i].valid ? "Ocupado" : "Vacío", 
-               frameList->frames[i].reference);
+    for (int i = 0; i < frameList->capacity; i++) {
+        printf("Frame %d - Página: %d, Estado: %s, Referencia: %d, Sucio: %d\n", 
+               i, frameList->pages[i],
+               testBit(frameList->valid, i) ? "Ocupado" : "Vacío", 
+               testBit(frameList->reference, i), testBit(frameList->dirty, i));
     }
     printf("\n");
 }
 
 /*
- * Función: main
- * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo Clock.
+ * Funciones: clockCreate, clockEnhancedCreate, clockDestroy, clockAccess, clockEvict, clockStats,
+ *            clockPrint, clockSave, clockRestore, clockPrefetch, clockWrite
+ * Descripción: Adaptan las funciones del algoritmo CLOCK a la interfaz común PolicyOps; las dos variantes
+ *            solo difieren en cómo elige el reloj la víctima. El checkpoint guarda el array de páginas,
+ *            los cuatro mapas de bits, el puntero del reloj y las víctimas sucias pendientes.
  */
-int main() {
-    FrameList *frameList = createFrameList();  // Inicializar la lista de frames
+static void* clockCreate(int numFrames) {
+    return createFrameList(numFrames, false);
+}
 
-    // Cargar páginas en memoria
-    loadPage(frameList, 1);
-    loadPage(frameList, 2);
-    loadPage(frameList, 3);
-    loadPage(frameList, 4);
-    printFrameList(frameList);  // Imprimir estado actual de los frames
+static void* clockEnhancedCreate(int numFrames) {
+    return createFrameList(numFrames, true);
+}
 
-    // Intentar cargar otra página con todos los frames ocupados
-    loadPage(frameList, 5);
-    printFrameList(frameList);  // Imprimir estado tras la sustitución
+static void clockDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
 
-    // Liberar la memoria utilizada
-    free(frameList);
+static bool clockAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page, false);
+}
+
+static bool clockWrite(void *state, int page) {
+    return loadPage((FrameList *)state, page, true);
+}
+
+static int clockEvict(void *state) {
+    return evictFrame((FrameList *)state);
+}
+
+static const SimStats* clockStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
+
+static void clockPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+static bool clockPrefetch(void *state, int page) {
+    return prefetchPage((FrameList *)state, page);
+}
+
+static bool clockSave(void *state, FILE *out) {
+    FrameList *frameList = (FrameList *)state;
+    size_t words = BITMAP_WORDS(frameList->capacity);
+    return saveBlock(out, frameList, sizeof(FrameList)) &&
+           saveBlock(out, frameList->pages, (size_t)frameList->capacity * sizeof(int)) &&
+           saveBlock(out, frameList->valid, words * sizeof(uint64_t)) &&
+           saveBlock(out, frameList->reference, words * sizeof(uint64_t)) &&
+           saveBlock(out, frameList->prefetched, words * sizeof(uint64_t)) &&
+           saveBlock(out, frameList->dirty, words * sizeof(uint64_t));
+}
+
+static bool clockRestore(void *state, PolicyImage *image) {
+    FrameList *frameList = (FrameList *)state;
+    FrameList saved;
+    if (!loadBlock(image, &saved, sizeof(FrameList)) || saved.capacity != frameList->capacity ||
+        saved.enhanced != frameList->enhanced) {
+        return false;
+    }
+    saved.pages = frameList->pages;  // Los punteros guardados no valen: se conservan los arrays propios
+    saved.valid = frameList->valid;
+    saved.reference = frameList->reference;
+    saved.prefetched = frameList->prefetched;
+    saved.dirty = frameList->dirty;
+    size_t words = BITMAP_WORDS(saved.capacity);
+    if (!loadBlock(image, saved.pages, (size_t)saved.capacity * sizeof(int)) ||
+        !loadBlock(image, saved.valid, words * sizeof(uint64_t)) ||
+        !loadBlock(image, saved.reference, words * sizeof(uint64_t)) ||
+        !loadBlock(image, saved.prefetched, words * sizeof(uint64_t)) ||
+        !loadBlock(image, saved.dirty, words * sizeof(uint64_t))) {
+        return false;
+    }
+    *frameList = saved;
+    return true;
+}
+
+const PolicyOps clockPolicy = {
+    "CLOCK", clockCreate, clockDestroy, clockAccess, clockEvict, clockStats, clockPrint,
+    clockSave, clockRestore, NULL, clockPrefetch, clockWrite
+};
+
+const PolicyOps clockEnhancedPolicy = {
+    "CLOCK-ESC", clockEnhancedCreate, clockDestroy, clockAccess, clockEvict, clockStats, clockPrint,
+    clockSave, clockRestore, NULL, clockPrefetch, clockWrite
+};
 
-    return 0;
+#ifndef POLICY_LIBRARY
+/*
+ * Función: main
+ * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo CLOCK.
+ *              Uso: LRU-CLOCK [-p CLOCK|CLOCK-ESC,...] [-t traza] [-d cadaN] [-q] [numFrames] [página ...]
+ *              (ver driver.h).
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *policies[] = { &clockPolicy, &clockEnhancedPolicy };
+    return runDriver(argc, argv, policies, 2);
 }
+#endif
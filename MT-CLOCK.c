@@ -0,0 +1,527 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Variante concurrente del algoritmo Clock de LRU-CLOCK.c: varios hilos acceden a la misma memoria
+ * física sin ningún cerrojo global.
+ *  - Las páginas se buscan en un índice hash de direccionamiento abierto (página -> frame) con sondeo
+ *    lineal, cuyas cubetas son palabras atómicas. Solo el hilo que reclama un frame borra la entrada de
+ *    su página anterior (la cubeta pasa a SLOT_DELETED, nunca otra vez a vacía) e inserta la nueva con
+ *    un CAS sobre una cubeta libre; cada entrada encontrada se confirma con la página del frame, así que
+ *    una entrada de un frame a medio reemplazar se ignora. La búsqueda no recorre más cubetas que la
+ *    mayor distancia a la que se ha insertado desde la cubeta inicial de la página.
+ *  - Un acierto solo pone a 1 el bit de referencia del frame con un OR atómico (y solo si estaba a 0,
+ *    para no escribir una línea de caché compartida en cada acierto); no modifica ninguna estructura.
+ *  - El puntero del reloj es un contador atómico: cada hilo que busca víctima avanza una posición con
+ *    fetch_add, así que varios hilos recorren el reloj a la vez sin pisarse.
+ *  - Un fallo reclama su frame con un CAS sobre la página del frame (de la página observada a
+ *    FRAME_BUSY); solo el hilo que gana el CAS escribe la página nueva. Antes de publicarla vuelve a
+ *    buscar la página, por si otro hilo la cargó mientras tanto, y en ese caso devuelve el frame intacto
+ *    (aún queda una ventana mínima en la que dos hilos cargan la misma página en dos frames; la copia
+ *    que deje de usarse acaba desalojándose como cualquier otra).
+ * Con un solo hilo las decisiones son exactamente las de LRU-CLOCK.c. Con varios, un acierto que llega
+ * mientras otro hilo reemplaza el mismo frame puede contarse como acierto o dejar a 1 el bit del frame
+ * nuevo; son las mismas aproximaciones que hace el hardware con los bits de referencia.
+ *
+ * Como biblioteca (-DPOLICY_LIBRARY) exporta mtClockPolicy para usarla en un solo hilo desde el driver
+ * común; el main reparte entre varios hilos los lotes de una traza, que se decodifica una sola vez: cada
+ * hilo toma el siguiente lote con un cerrojo y lo simula fuera de él.
+ *
+ * Compilación: gcc -O2 -pthread MT-CLOCK.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o MT-CLOCK
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "policy.h"
+#include "driver.h"
+
+#define FRAME_EMPTY (-1)    // Página de un frame vacío
+#define FRAME_BUSY (-2)     // Página de un frame reclamado por un hilo que lo está reemplazando
+#define REF_BITS 64         // Bits de referencia por palabra
+#define SLOT_EMPTY 0        // Cubeta del índice que nunca se ha usado
+#define SLOT_DELETED 1      // Cubeta del índice cuya entrada se borró (se reutiliza al insertar)
+
+// Memoria física compartida por todos los hilos
+typedef struct FrameList {
+    int capacity;                   // Número de frames disponibles en memoria física
+    _Atomic int *pages;             // Página de cada frame (FRAME_EMPTY o FRAME_BUSY si no hay)
+    _Atomic uint64_t *reference;    // Mapa de bits de referencia, en palabras de 64 bits
+    _Atomic uint64_t *slots;        // Índice página -> frame: (página << 32) | (frame + 2), o SLOT_*
+    _Atomic uint32_t *maxProbe;     // Mayor distancia de inserción desde cada cubeta inicial
+    size_t indexSize;               // Cubetas del índice (potencia de 2, al menos 4 por frame)
+    atomic_uint_fast64_t clockHand; // Posiciones avanzadas por el reloj (módulo capacity)
+    SimStats stats;                 // Contadores del uso en un solo hilo (PolicyOps)
+} FrameList;
+
+/*
+ * Función: destroyFrameList
+ * Descripción: Libera los arrays de frames y la propia lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void destroyFrameList(FrameList *frameList) {
+    free((void *)frameList->pages);
+    free((void *)frameList->reference);
+    free((void *)frameList->slots);
+    free((void *)frameList->maxProbe);
+    free(frameList);
+}
+
+/*
+ * Función: createFrameList
+ * Descripción: Inicializa la memoria física compartida.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ * Retorna: Puntero a la lista creada, o NULL si no hay memoria.
+ */
+static FrameList* createFrameList(int capacity) {
+    FrameList *frameList = (FrameList *)calloc(1, sizeof(FrameList));
+    if (frameList == NULL) {
+        return NULL;
+    }
+    size_t words = ((size_t)capacity + REF_BITS - 1) / REF_BITS;
+    frameList->indexSize = 2;
+    while (frameList->indexSize < 4 * (size_t)capacity) {
+        frameList->indexSize *= 2;
+    }
+    frameList->pages = (_Atomic int *)malloc((size_t)capacity * sizeof(*frameList->pages));
+    frameList->reference = (_Atomic uint64_t *)malloc(words * sizeof(*frameList->reference));
+    frameList->slots = (_Atomic uint64_t *)malloc(frameList->indexSize * sizeof(*frameList->slots));
+    frameList->maxProbe = (_Atomic uint32_t *)malloc(frameList->indexSize * sizeof(*frameList->maxProbe));
+    if (frameList->pages == NULL || frameList->reference == NULL || frameList->slots == NULL ||
+        frameList->maxProbe == NULL) {
+        destroyFrameList(frameList);
+        return NULL;
+    }
+    frameList->capacity = capacity;
+    for (int i = 0; i < capacity; i++) {
+        atomic_init(&frameList->pages[i], FRAME_EMPTY);
+    }
+    for (size_t w = 0; w < words; w++) {
+        atomic_init(&frameList->reference[w], 0);
+    }
+    for (size_t i = 0; i < frameList->indexSize; i++) {
+        atomic_init(&frameList->slots[i], SLOT_EMPTY);
+        atomic_init(&frameList->maxProbe[i], 0);
+    }
+    atomic_init(&frameList->clockHand, 0);
+    return frameList;
+}
+
+/*
+ * Función: hashSlot
+ * Descripción: Cubeta inicial de una página en el índice.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static size_t hashSlot(const FrameList *frameList, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (size_t)h & (frameList->indexSize - 1);
+}
+
+/*
+ * Función: slotEntry
+ * Descripción: Codifica una entrada del índice; frame + 2 la distingue de SLOT_EMPTY y SLOT_DELETED.
+ * Parámetros:
+ *  - page: Número de la página (no negativa).
+ *  - frame: Índice del frame que la contiene.
+ * Retorna: Valor de la cubeta.
+ */
+static inline uint64_t slotEntry(int page, int frame) {
+    return ((uint64_t)(uint32_t)page << 32) | (uint64_t)(frame + 2);
+}
+
+/*
+ * Función: findFrame
+ * Descripción: Busca un frame por su número de página en el índice, sin cerrojo. Una entrada solo vale
+ *              si el frame sigue teniendo esa página; si no, se sigue sondeando.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página que se busca.
+ *  - probes: Recibe el número de cubetas consultadas.
+ * Retorna: Índice del frame encontrado o -1 si no está en la lista.
+ */
+static int findFrame(FrameList *frameList, int page, int *probes) {
+    size_t mask = frameList->indexSize - 1;
+    size_t home = hashSlot(frameList, page);
+    uint32_t limit = atomic_load_explicit(&frameList->maxProbe[home], memory_order_acquire);
+    *probes = 0;
+    for (uint32_t d = 0; d <= limit; d++) {
+        uint64_t entry = atomic_load_explicit(&frameList->slots[(home + d) & mask], memory_order_acquire);
+        (*probes)++;
+        if (entry == SLOT_EMPTY) {
+            break;  // Las cubetas nunca vuelven a estar vacías: la página no está más adelante
+        }
+        if (entry != SLOT_DELETED && (uint32_t)(entry >> 32) == (uint32_t)page) {
+            int frame = (int)(uint32_t)entry - 2;
+            if (atomic_load_explicit(&frameList->pages[frame], memory_order_acquire) == page) {
+                return frame;
+            }
+        }
+    }
+    return -1;
+}
+
+/*
+ * Función: indexInsert
+ * Descripción: Anota en el índice que un frame reclamado por el hilo va a contener una página: toma con
+ *              un CAS la primera cubeta vacía o borrada y amplía la distancia de sondeo de la inicial.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ *  - frame: Índice del frame, reclamado por el hilo que llama.
+ */
+static void indexInsert(FrameList *frameList, int page, int frame) {
+    size_t mask = frameList->indexSize - 1;
+    size_t home = hashSlot(frameList, page);
+    uint64_t entry = slotEntry(page, frame);
+    // Hay a lo sumo una entrada por frame y 4 cubetas por frame: siempre queda alguna libre
+    for (uint32_t d = 0;; d++) {
+        _Atomic uint64_t *slot = &frameList->slots[(home + d) & mask];
+        uint64_t seen = atomic_load_explicit(slot, memory_order_relaxed);
+        if ((seen == SLOT_EMPTY || seen == SLOT_DELETED) &&
+            atomic_compare_exchange_strong_explicit(slot, &seen, entry, memory_order_release, memory_order_relaxed)) {
+            _Atomic uint32_t *limit = &frameList->maxProbe[home];
+            uint32_t current = atomic_load_explicit(limit, memory_order_relaxed);
+            while (current < d && !atomic_compare_exchange_weak_explicit(limit, &current, d, memory_order_release,
+                                                                         memory_order_relaxed)) {
+            }
+            return;
+        }
+    }
+}
+
+/*
+ * Función: indexRemove
+ * Descripción: Borra del índice la entrada de un frame reclamado por el hilo. Ningún otro hilo escribe
+ *              en esa cubeta (solo se insertan entradas en cubetas libres), así que basta un store.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Página que tenía el frame.
+ *  - frame: Índice del frame.
+ */
+static void indexRemove(FrameList *frameList, int page, int frame) {
+    size_t mask = frameList->indexSize - 1;
+    size_t home = hashSlot(frameList, page);
+    uint64_t entry = slotEntry(page, frame);
+    uint32_t limit = atomic_load_explicit(&frameList->maxProbe[home], memory_order_acquire);
+    for (uint32_t d = 0; d <= limit; d++) {
+        _Atomic uint64_t *slot = &frameList->slots[(home + d) & mask];
+        if (atomic_load_explicit(slot, memory_order_relaxed) == entry) {
+            atomic_store_explicit(slot, SLOT_DELETED, memory_order_release);
+            return;
+        }
+    }
+}
+
+/*
+ * Función: setReference
+ * Descripción: Pone a 1 el bit de referencia de un frame con un OR atómico si aún no lo estaba.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame.
+ */
+static void setReference(FrameList *frameList, int index) {
+    _Atomic uint64_t *word = &frameList->reference[index / REF_BITS];
+    uint64_t bit = (uint64_t)1 << (index % REF_BITS);
+    if ((atomic_load_explicit(word, memory_order_relaxed) & bit) == 0) {
+        atomic_fetch_or_explicit(word, bit, memory_order_relaxed);
+    }
+}
+
+/*
+ * Función: claimVictim
+ * Descripción: Avanza el reloj (una posición por fetch_add) poniendo a 0 los bits de referencia a 1,
+ *              hasta reclamar con un CAS un frame cuyo bit estaba a 0.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - occupiedOnly: Si es true, salta los frames vacíos (desalojo explícito).
+ *  - oldPage: Recibe la página que tenía el frame reclamado (FRAME_EMPTY si estaba vacío).
+ * Retorna: Índice del frame reclamado, que queda con página FRAME_BUSY.
+ */
+static int claimVictim(FrameList *frameList, bool occupiedOnly, int *oldPage) {
+    for (;;) {
+        uint64_t step = atomic_fetch_add_explicit(&frameList->clockHand, 1, memory_order_relaxed);
+        int hand = (int)(step % (uint64_t)frameList->capacity);
+        _Atomic uint64_t *word = &frameList->reference[hand / REF_BITS];
+        uint64_t bit = (uint64_t)1 << (hand % REF_BITS);
+
+        int page = atomic_load_explicit(&frameList->pages[hand], memory_order_acquire);
+        if (page == FRAME_BUSY || (occupiedOnly && page == FRAME_EMPTY)) {
+            continue;  // Otro hilo lo está reemplazando, o no hay nada que desalojar en él
+        }
+        if (atomic_load_explicit(word, memory_order_relaxed) & bit) {
+            // Segunda oportunidad: poner el bit de referencia en 0 y seguir avanzando
+            atomic_fetch_and_explicit(word, ~bit, memory_order_relaxed);
+            continue;
+        }
+        if (atomic_compare_exchange_strong_explicit(&frameList->pages[hand], &page, FRAME_BUSY,
+                                                    memory_order_acq_rel, memory_order_relaxed)) {
+            *oldPage = page;
+            return hand;
+        }
+        // Otro hilo reclamó el frame antes: probar con el siguiente
+    }
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja el siguiente frame ocupado con bit de referencia en 0 según el reloj.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - stats: Contadores del hilo que desaloja.
+ * Retorna: Página desalojada, o -1 si no hay frames ocupados.
+ */
+static int evictFrame(FrameList *frameList, SimStats *stats) {
+    bool occupied = false;
+    for (int i = 0; i < frameList->capacity && !occupied; i++) {
+        int page = atomic_load_explicit(&frameList->pages[i], memory_order_relaxed);
+        occupied = page != FRAME_EMPTY && page != FRAME_BUSY;
+    }
+    if (!occupied) {
+        return -1;
+    }
+    int page;
+    int victim = claimVictim(frameList, true, &page);
+    indexRemove(frameList, page, victim);
+    atomic_fetch_and_explicit(&frameList->reference[victim / REF_BITS],
+                              ~((uint64_t)1 << (victim % REF_BITS)), memory_order_relaxed);
+    atomic_store_explicit(&frameList->pages[victim], FRAME_EMPTY, memory_order_release);
+    stats->evictions++;
+    return page;
+}
+
+/*
+ * Función: loadPage
+ * Descripción: Referencia una página desde cualquier hilo.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames compartida.
+ *  - page: Número de la página a cargar.
+ *  - stats: Contadores del hilo que accede (no se comparten entre hilos).
+ * Retorna: true si la página ya estaba en memoria (acierto).
+ */
+static bool loadPage(FrameList *frameList, int page, SimStats *stats) {
+    stats->accesses++;
+    int probes;
+    int frameIndex = findFrame(frameList, page, &probes);
+    INSTRUMENT(stats->lookups++);
+    INSTRUMENT(stats->lookupSteps += (uint64_t)probes);
+    if (frameIndex != -1) {
+        stats->hits++;
+        setReference(frameList, frameIndex);
+        return true;
+    }
+
+    stats->misses++;
+    int oldPage;
+    frameIndex = claimVictim(frameList, false, &oldPage);
+    if (findFrame(frameList, page, &probes) != -1) {
+        // Otro hilo cargó la página mientras se buscaba víctima: devolver el frame sin tocarlo
+        atomic_store_explicit(&frameList->pages[frameIndex], oldPage, memory_order_release);
+        return false;
+    }
+    if (oldPage != FRAME_EMPTY) {
+        indexRemove(frameList, oldPage, frameIndex);
+        stats->evictions++;
+    }
+    indexInsert(frameList, page, frameIndex);
+    setReference(frameList, frameIndex);
+    atomic_store_explicit(&frameList->pages[frameIndex], page, memory_order_release);
+    return false;
+}
+
+/*
+ * Función: printFrameList
+ * Descripción: Imprime el estado actual de los frames en memoria.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void printFrameList(FrameList *frameList) {
+    printf("Estado actual de los frames:\n");
+    for (int i = 0; i < frameList->capacity; i++) {
+        int page = atomic_load(&frameList->pages[i]);
+        uint64_t word = atomic_load(&frameList->reference[i / REF_BITS]);
+        printf("Frame %d - Página: %d, Estado: %s, Referencia: %d\n",
+               i, page < 0 ? -1 : page, page == FRAME_EMPTY ? "Vacío" : (page == FRAME_BUSY ? "Reclamado" : "Ocupado"),
+               (int)((word >> (i % REF_BITS)) & 1u));
+    }
+    printf("\n");
+}
+
+/*
+ * Funciones: mtClockCreate, mtClockDestroy, mtClockAccess, mtClockEvict, mtClockStats, mtClockPrint
+ * Descripción: Adaptan la variante concurrente a la interfaz común PolicyOps (uso desde un solo hilo).
+ */
+static void* mtClockCreate(int numFrames) {
+    return createFrameList(numFrames);
+}
+
+static void mtClockDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
+
+static bool mtClockAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page, &((FrameList *)state)->stats);
+}
+
+static int mtClockEvict(void *state) {
+    return evictFrame((FrameList *)state, &((FrameList *)state)->stats);
+}
+
+static const SimStats* mtClockStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
+
+static void mtClockPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+const PolicyOps mtClockPolicy = {
+    "CLOCK-MT", mtClockCreate, mtClockDestroy, mtClockAccess, mtClockEvict, mtClockStats, mtClockPrint,
+    NULL, NULL, NULL, NULL, NULL  // Sin checkpoints ni lectura anticipada: el estado se comparte entre hilos
+};
+
+#ifndef POLICY_LIBRARY
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+// Traza de la que los hilos toman lotes consecutivos
+typedef struct TraceFeed {
+    TraceReader *trace;         // Lector único de la traza
+    pthread_mutex_t lock;       // Protege el cursor del lector
+} TraceFeed;
+
+// Trabajo de un hilo: los lotes que vaya tomando de la traza compartida
+typedef struct Worker {
+    FrameList *frameList;       // Memoria compartida
+    TraceFeed *feed;            // Traza compartida
+    SimStats stats;             // Contadores propios del hilo
+    bool ok;                    // El hilo recorrió su parte sin errores
+} Worker;
+
+/*
+ * Función: replayWorker
+ * Descripción: Hilo de la simulación: toma el siguiente lote de la traza con el cerrojo y, ya fuera de
+ *              él, lo referencia sobre la memoria compartida, hasta agotar la traza.
+ * Parámetros:
+ *  - arg: Puntero a Worker.
+ * Retorna: NULL.
+ */
+static void* replayWorker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    worker->ok = pages != NULL;
+    while (worker->ok) {
+        pthread_mutex_lock(&worker->feed->lock);
+        size_t count = readPages(worker->feed->trace, pages, TRACE_BATCH_SIZE);
+        pthread_mutex_unlock(&worker->feed->lock);
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            loadPage(worker->frameList, pages[i], &worker->stats);
+        }
+    }
+    free(pages);
+    return NULL;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: MT-CLOCK [-j hilos] [-q] -t traza numFrames
+ *              Los hilos se reparten los lotes de la traza, en cualquier formato, y comparten la memoria.
+ */
+int main(int argc, char *argv[]) {
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *tracePath = NULL;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:qt:")) != -1) {
+        if (opt == 'j') {
+            numThreads = parseCount(optarg, INT_MAX);
+        } else if (opt == 'q') {
+            quiet = true;
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            numThreads = 0;
+        }
+    }
+    int numFrames = optind < argc ? (int)parseCount(argv[optind], INT_MAX) : 0;
+    if (numThreads <= 0 || tracePath == NULL || numFrames <= 0) {
+        fprintf(stderr, "Uso: %s [-j hilos] [-q] -t traza numFrames\n", argv[0]);
+        return 1;
+    }
+
+    TraceFeed feed = { openTrace(tracePath), PTHREAD_MUTEX_INITIALIZER };
+    if (feed.trace == NULL) {
+        return 1;
+    }
+    FrameList *frameList = createFrameList(numFrames);
+    Worker *workers = (Worker *)calloc((size_t)numThreads, sizeof(Worker));
+    pthread_t *threads = (pthread_t *)malloc((size_t)numThreads * sizeof(pthread_t));
+    if (frameList == NULL || workers == NULL || threads == NULL) {
+        fprintf(stderr, "No hay memoria para %d frames y %ld hilos\n", numFrames, numThreads);
+        free(threads);
+        free(workers);
+        if (frameList != NULL) {
+            destroyFrameList(frameList);
+        }
+        closeTrace(feed.trace);
+        return 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long started = 0;
+    for (; started < numThreads; started++) {
+        workers[started] = (Worker){ frameList, &feed, {0}, false };
+        if (pthread_create(&threads[started], NULL, replayWorker, &workers[started]) != 0) {
+            break;
+        }
+    }
+    for (long t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    // Combinar los contadores de todos los hilos
+    bool ok = started == numThreads && !traceFailed(feed.trace);
+    SimStats total = {0};
+    for (long t = 0; t < started; t++) {
+        ok = ok && workers[t].ok;
+        addStats(&total, &workers[t].stats);
+    }
+    if (!ok) {
+        fprintf(stderr, "La simulación concurrente falló\n");
+    }
+    if (!quiet) {
+        printFrameList(frameList);
+    }
+    printStats(mtClockPolicy.name, numFrames, &total);
+    fprintf(stderr, "%ld hilos: %.3f s, %.0f accesos/s\n", started, seconds,
+            seconds > 0.0 ? (double)total.accesses / seconds : 0.0);
+
+    free(threads);
+    free(workers);
+    destroyFrameList(frameList);
+    closeTrace(feed.trace);
+    return ok ? 0 : 1;
+}
+#endif
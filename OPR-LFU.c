@@ -8,123 +8,645 @@
  * Para lograr esto, cada frame (marco) tiene un contador de frecuencia que se incrementa cada vez que la página es utilizada.
  * Si es necesario reemplazar una página, se selecciona el frame con la frecuencia más baja.
  * 
- * La implementación utiliza una lista doblemente enlazada para mantener los frames en memoria. Cada vez que una página es 
- * accedida o reemplazada, se imprime el estado de la memoria para fines de depuración.
+ * La implementación agrupa los frames en cubetas de frecuencia: una lista doblemente enlazada de nodos de frecuencia,
+ * ordenada de menor a mayor, donde cada nodo contiene la lista de frames con esa frecuencia (el más recientemente usado
+ * al frente). Así, incrementar la frecuencia de un frame y desalojar el menos frecuente cuestan tiempo constante; los
+ * empates se resuelven desalojando el frame menos recientemente usado de la cubeta. Un índice hash (página -> Frame*)
+ * evita recorrer la memoria para localizar una página. Frames y cubetas provienen de pools de capacidad fija
+ * reservados al crear la lista, con listas libres intrusivas, de modo que ningún acceso llama a malloc/free. Cada vez que una página es accedida o reemplazada, se imprime
+ * el estado de la memoria para fines de depuración.
+ * 
+ * Para simular memorias de cientos de millones de frames la representación es compacta: frames y cubetas
+ * se enlazan con índices de 32 bits dentro de sus arrays en lugar de punteros, un frame vacío se marca
+ * con la página EMPTY_PAGE en lugar de un campo valid, y la frecuencia vive solo en la cubeta, en un
+ * contador de 16 bits que satura en FREQUENCY_MAX. Cada frame ocupa 20 bytes más 8 del índice hash y dos
+ * bits: el del mapa de páginas modificadas (ops->write), que al desalojarlas encola su escritura en disco
+ * (WriteBack, ver stats.h), y el del mapa que marca las leídas por adelantado (driver -a, ver prefetch.h).
+ * Las páginas leídas por adelantado entran con frecuencia 1 y su primera referencia cuenta como la carga:
+ * no sube la frecuencia, solo las pasa al frente de su cubeta, para que la lectura anticipada no les dé
+ * ventaja sobre las cargas por demanda.
+ * 
+ * LFU puro nunca olvida: una página muy usada al principio de la traza conserva su frame para siempre.
+ * Por eso hay dos variantes con envejecimiento:
+ *  - LFU-AGE divide a la mitad la frecuencia de todos los frames cada AGING_FACTOR * capacity accesos,
+ *    fusionando las cubetas que quedan con la misma frecuencia; así las frecuencias miden el uso
+ *    reciente y quedan acotadas.
+ *  - LFU-TINY añade un filtro de admisión TinyLFU: un sketch Count-Min de tamaño fijo, con contadores de
+ *    4 bits que también se dividen a la mitad en cada periodo, estima la frecuencia de cualquier página,
+ *    esté o no en memoria. Con la memoria llena, una página nueva solo entra si el sketch la estima más
+ *    frecuente que la víctima, de modo que las páginas vistas una sola vez no desplazan a las populares.
+ *    Una escritura que el filtro no admite va directa a disco y cuenta como escritura de una víctima sucia.
+ * 
+ * Los tipos y funciones del algoritmo son privados; se exportan a través de lfuPolicy (policy.h) y el
+ * main se omite al compilar con -DPOLICY_LIBRARY para enlazarlo junto a los demás en el simulador.
+ * 
+ * Compilación: gcc -O2 -pthread OPR-LFU.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o OPR-LFU
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
-#define NUM_FRAMES 4   // Número de frames disponibles en memoria física
-#define NUM_PAGES 10   // Número total de páginas virtuales
+#include "policy.h"
+#include "driver.h"
+#include "checkpoint.h"
+#include "framescan.h"
 
-// Estructura que representa un frame en memoria física
+#define AGING_FACTOR 10         // LFU-AGE y LFU-TINY envejecen las frecuencias cada AGING_FACTOR * capacity accesos
+#define SKETCH_DEPTH 4          // Filas del sketch Count-Min
+#define SKETCH_COUNTER_MAX 15   // Los contadores del sketch son de 4 bits, 16 por palabra
+#define NO_INDEX UINT32_MAX     // Índice nulo en los enlaces entre frames y cubetas
+#define EMPTY_PAGE -1           // Página de los frames vacíos (hace las veces del bit de ocupado)
+#define FREQUENCY_MAX UINT16_MAX    // Frecuencia máxima: el contador satura en lugar de desbordarse
+
+// Sketch Count-Min con contadores de 4 bits empaquetados (filtro de admisión TinyLFU)
+typedef struct FrequencySketch {
+    uint64_t *words;    // SKETCH_DEPTH filas de width contadores cada una
+    uint32_t mask;      // width - 1 (width es potencia de 2)
+    int wordsPerRow;    // Palabras de 64 bits por fila
+} FrequencySketch;
+
+// Estructura que representa un frame en memoria física (20 bytes; la frecuencia está en su cubeta)
 typedef struct Frame {
-    int page;           // Número de la página almacenada (-1 si está vacío)
-    bool valid;         // Indica si el frame está ocupado (true) o vacío (false)
-    int frequency;      // Contador de frecuencia de uso
-    struct Frame *prev; // Puntero al frame anterior (lista doblemente enlazada)
-    struct Frame *next; // Puntero al frame siguiente (lista doblemente enlazada)
+    int page;           // Número de la página almacenada (EMPTY_PAGE si está vacío)
+    uint32_t prev;      // Frame anterior dentro de su cubeta de frecuencia
+    uint32_t next;      // Frame siguiente dentro de su cubeta de frecuencia (o en la lista libre)
+    uint32_t freqNode;  // Cubeta de frecuencia a la que pertenece el frame
+    uint32_t hashNext;  // Siguiente frame en la misma cubeta del índice hash
 } Frame;
 
+// Nodo de frecuencia: agrupa todos los frames que tienen la misma frecuencia de uso
+typedef struct FreqNode {
+    uint32_t head;          // Frame más recientemente usado de la cubeta
+    uint32_t tail;          // Frame menos recientemente usado de la cubeta
+    uint32_t prev;          // Cubeta con la frecuencia inmediatamente menor
+    uint32_t next;          // Cubeta con la frecuencia inmediatamente mayor
+    uint16_t frequency;     // Frecuencia compartida por los frames de la cubeta (satura en FREQUENCY_MAX)
+} FreqNode;
+
 // Estructura para administrar la lista de frames en memoria física
 typedef struct FrameList {
+    int capacity;       // Número de frames disponibles en memoria física
     int numFrames;      // Número de frames ocupados actualmente
-    Frame *head;        // Primer frame de la lista (más reciente)
-    Frame *tail;        // Último frame de la lista (menos reciente)
+    uint32_t head;      // Cubeta de menor frecuencia (de ella sale la víctima)
+    uint32_t *buckets;  // Cubetas del índice hash página -> frame
+    int numBuckets;     // Número de cubetas (potencia de 2)
+    Frame *frames;      // Array contiguo de capacity frames reservado al crear la lista
+    uint64_t *prefetched;   // Mapa de bits: frame cargado por lectura anticipada y todavía no referenciado
+    uint64_t *dirty;        // Mapa de bits: frame modificado desde que se cargó
+    WriteBack writeBack;    // Víctimas sucias pendientes de agrupar en operaciones de disco
+    uint32_t freeFrames;    // Lista libre intrusiva (enlazada por next) de frames sin usar
+    FreqNode *nodes;        // Array de cubetas de frecuencia
+    uint32_t freeNodes;     // Lista libre intrusiva de cubetas sin usar
+    uint64_t agingPeriod;   // Accesos entre envejecimientos (0 = LFU puro, sin envejecimiento)
+    FrequencySketch *sketch;    // Filtro de admisión TinyLFU (NULL si no se usa)
+    uint64_t rejected;      // Páginas que el filtro de admisión no dejó entrar
+    SimStats stats;     // Contadores de accesos, aciertos, fallos y desalojos
 } FrameList;
 
 /*
  * Función: createFrame
- * Descripción: Crea e inicializa un frame vacío.
- * Retorna: Puntero al frame creado.
+ * Descripción: Toma un frame vacío de la lista libre.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Índice del frame obtenido, o NO_INDEX si no quedan frames libres.
+ */
+static uint32_t createFrame(FrameList *frameList) {
+    uint32_t index = frameList->freeFrames;
+    if (index != NO_INDEX) {
+        Frame *frame = &frameList->frames[index];
+        frameList->freeFrames = frame->next;
+        frame->page = EMPTY_PAGE;
+        frame->prev = NO_INDEX;
+        frame->next = NO_INDEX;
+        frame->freqNode = NO_INDEX;
+        frame->hashNext = NO_INDEX;
+    }
+    return index;
+}
+
+/*
+ * Función: createFreqNode
+ * Descripción: Toma una cubeta de frecuencia vacía de la lista libre.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - frequency: Frecuencia que representa la cubeta.
+ * Retorna: Índice de la cubeta obtenida, o NO_INDEX si no quedan cubetas libres.
+ */
+static uint32_t createFreqNode(FrameList *frameList, uint16_t frequency) {
+    uint32_t index = frameList->freeNodes;
+    if (index != NO_INDEX) {
+        FreqNode *node = &frameList->nodes[index];
+        frameList->freeNodes = node->next;
+        node->frequency = frequency;
+        node->head = NO_INDEX;
+        node->tail = NO_INDEX;
+        node->prev = NO_INDEX;
+        node->next = NO_INDEX;
+    }
+    return index;
+}
+
+/*
+ * Función: createSketch
+ * Descripción: Crea un sketch Count-Min con contadores a 0, con al menos 4 contadores por frame en cada fila.
+ * Parámetros:
+ *  - capacity: Número de frames de la memoria a la que filtra.
+ * Retorna: Puntero al sketch creado, o NULL si no hay memoria.
+ */
+static FrequencySketch* createSketch(int capacity) {
+    FrequencySketch *sketch = (FrequencySketch *)malloc(sizeof(FrequencySketch));
+    if (sketch != NULL) {
+        uint32_t width = 64;
+        while (width < 4 * (uint32_t)capacity) {
+            width <<= 1;
+        }
+        sketch->mask = width - 1;
+        sketch->wordsPerRow = (int)(width / 16);
+        sketch->words = (uint64_t *)calloc((size_t)SKETCH_DEPTH * sketch->wordsPerRow, sizeof(uint64_t));
+        if (sketch->words == NULL) {
+            free(sketch);
+            return NULL;
+        }
+    }
+    return sketch;
+}
+
+/*
+ * Función: destroySketch
+ * Descripción: Libera un sketch Count-Min.
+ * Parámetros:
+ *  - sketch: Puntero al sketch (puede ser NULL).
+ */
+static void destroySketch(FrequencySketch *sketch) {
+    if (sketch != NULL) {
+        free(sketch->words);
+        free(sketch);
+    }
+}
+
+/*
+ * Función: sketchSlot
+ * Descripción: Calcula la posición del contador de una página en una fila del sketch. Las filas usan
+ *              doble hashing sobre la mezcla de MurmurHash3, independiente del hash del índice.
+ * Parámetros:
+ *  - sketch: Puntero al sketch.
+ *  - page: Número de la página.
+ *  - row: Fila del sketch.
+ *  - word: Recibe el índice de la palabra que contiene el contador.
+ * Retorna: Desplazamiento en bits del contador dentro de su palabra.
+ */
+static int sketchSlot(const FrequencySketch *sketch, int page, int row, size_t *word) {
+    uint32_t h = (uint32_t)page;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    uint32_t slot = (h + (uint32_t)row * ((h >> 17) | (h << 15) | 1u)) & sketch->mask;
+    *word = (size_t)row * sketch->wordsPerRow + slot / 16;
+    return (int)(slot % 16) * 4;
+}
+
+/*
+ * Función: sketchIncrement
+ * Descripción: Cuenta una referencia a una página en cada fila del sketch (los contadores saturan en 15).
+ * Parámetros:
+ *  - sketch: Puntero al sketch.
+ *  - page: Número de la página referenciada.
+ */
+static void sketchIncrement(FrequencySketch *sketch, int page) {
+    for (int row = 0; row < SKETCH_DEPTH; row++) {
+        size_t word;
+        int shift = sketchSlot(sketch, page, row, &word);
+        if (((sketch->words[word] >> shift) & 0xF) < SKETCH_COUNTER_MAX) {
+            sketch->words[word] += (uint64_t)1 << shift;
+        }
+    }
+}
+
+/*
+ * Función: sketchEstimate
+ * Descripción: Estima la frecuencia reciente de una página como el mínimo de sus contadores.
+ * Parámetros:
+ *  - sketch: Puntero al sketch.
+ *  - page: Número de la página.
+ * Retorna: Frecuencia estimada (entre 0 y 15).
+ */
+static int sketchEstimate(const FrequencySketch *sketch, int page) {
+    int estimate = SKETCH_COUNTER_MAX;
+    for (int row = 0; row < SKETCH_DEPTH; row++) {
+        size_t word;
+        int shift = sketchSlot(sketch, page, row, &word);
+        int count = (int)((sketch->words[word] >> shift) & 0xF);
+        if (count < estimate) {
+            estimate = count;
+        }
+    }
+    return estimate;
+}
+
+/*
+ * Función: sketchHalve
+ * Descripción: Divide a la mitad todos los contadores del sketch, 16 contadores por palabra.
+ * Parámetros:
+ *  - sketch: Puntero al sketch.
  */
-Frame* createFrame() {
-    Frame *frame = (Frame *)malloc(sizeof(Frame));
-    if (frame != NULL) {
-        frame->page = -1;
-        frame->valid = false;
-        frame->frequency = 0;
-        frame->prev = NULL;
-        frame->next = NULL;
+static void sketchHalve(FrequencySketch *sketch) {
+    size_t numWords = (size_t)SKETCH_DEPTH * sketch->wordsPerRow;
+    for (size_t i = 0; i < numWords; i++) {
+        sketch->words[i] = (sketch->words[i] >> 1) & 0x7777777777777777ull;
     }
-    return frame;
+}
+
+/*
+ * Función: numFreqNodes
+ * Descripción: Cubetas de frecuencia que se reservan para una capacidad dada. Nunca hay más que
+ *              frecuencias distintas, más una porque incrementFrequency crea la nueva antes de liberar
+ *              la anterior.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ * Retorna: Número de cubetas.
+ */
+static int numFreqNodes(int capacity) {
+    return (capacity < FREQUENCY_MAX ? capacity : FREQUENCY_MAX) + 1;
 }
 
 /*
  * Función: createFrameList
  * Descripción: Inicializa una lista vacía de frames en memoria física.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ *  - aging: true para envejecer las frecuencias periódicamente (LFU-AGE).
+ *  - admission: true para filtrar las páginas nuevas con TinyLFU (LFU-TINY).
  * Retorna: Puntero a la lista creada.
  */
-FrameList* createFrameList() {
+static FrameList* createFrameList(int capacity, bool aging, bool admission) {
     FrameList *frameList = (FrameList *)malloc(sizeof(FrameList));
     if (frameList != NULL) {
+        frameList->capacity = capacity;
         frameList->numFrames = 0;
-        frameList->head = NULL;
-        frameList->tail = NULL;
+        frameList->agingPeriod = aging ? (uint64_t)AGING_FACTOR * (uint64_t)capacity : 0;
+        frameList->rejected = 0;
+        frameList->stats = (SimStats){0};
+        frameList->writeBack.count = 0;
+        frameList->head = NO_INDEX;
+
+        // Al menos el doble de cubetas que frames para mantener las cadenas cortas
+        frameList->numBuckets = 1;
+        while (frameList->numBuckets < 2 * capacity) {
+            frameList->numBuckets <<= 1;
+        }
+        int numNodes = numFreqNodes(capacity);
+        frameList->buckets = (uint32_t *)malloc((size_t)frameList->numBuckets * sizeof(uint32_t));
+        frameList->frames = (Frame *)malloc((size_t)capacity * sizeof(Frame));
+        frameList->nodes = (FreqNode *)malloc((size_t)numNodes * sizeof(FreqNode));
+        frameList->prefetched = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        frameList->dirty = (uint64_t *)calloc(BITMAP_WORDS(capacity), sizeof(uint64_t));
+        frameList->sketch = admission ? createSketch(capacity) : NULL;
+        if (frameList->buckets == NULL || frameList->frames == NULL || frameList->nodes == NULL ||
+            frameList->prefetched == NULL || frameList->dirty == NULL || (admission && frameList->sketch == NULL)) {
+            free(frameList->buckets);
+            free(frameList->frames);
+            free(frameList->nodes);
+            free(frameList->prefetched);
+            free(frameList->dirty);
+            destroySketch(frameList->sketch);
+            free(frameList);
+            return NULL;
+        }
+        for (int i = 0; i < frameList->numBuckets; i++) {
+            frameList->buckets[i] = NO_INDEX;
+        }
+
+        // Encadenar los arrays en sus listas libres, en orden de índice
+        frameList->freeFrames = NO_INDEX;
+        for (int i = capacity - 1; i >= 0; i--) {
+            frameList->frames[i].page = EMPTY_PAGE;
+            frameList->frames[i].next = frameList->freeFrames;
+            frameList->freeFrames = (uint32_t)i;
+        }
+        frameList->freeNodes = NO_INDEX;
+        for (int i = numNodes - 1; i >= 0; i--) {
+            frameList->nodes[i].next = frameList->freeNodes;
+            frameList->freeNodes = (uint32_t)i;
+        }
     }
     return frameList;
 }
 
 /*
- * Función: insertFrame
- * Descripción: Inserta un frame al frente de la lista de frames.
+ * Función: destroyFrameList
+ * Descripción: Libera los arrays de frames y cubetas, el índice hash y la propia lista.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - frame: Puntero al frame a insertar.
  */
-void insertFrame(FrameList *frameList, Frame *frame) {
-    if (frameList->head == NULL) {
-        frameList->head = frame;
-        frameList->tail = frame;
+static void destroyFrameList(FrameList *frameList) {
+    free(frameList->frames);
+    free(frameList->nodes);
+    free(frameList->buckets);
+    free(frameList->prefetched);
+    free(frameList->dirty);
+    destroySketch(frameList->sketch);
+    free(frameList);
+}
+
+/*
+ * Función: hashPage
+ * Descripción: Calcula la cubeta del índice hash que corresponde a una página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static int hashPage(const FrameList *frameList, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (int)(h & (uint32_t)(frameList->numBuckets - 1));
+}
+
+/*
+ * Función: indexInsert
+ * Descripción: Registra un frame en el índice hash bajo su número de página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame que se va a registrar.
+ */
+static void indexInsert(FrameList *frameList, uint32_t index) {
+    int bucket = hashPage(frameList, frameList->frames[index].page);
+    frameList->frames[index].hashNext = frameList->buckets[bucket];
+    frameList->buckets[bucket] = index;
+}
+
+/*
+ * Función: indexRemove
+ * Descripción: Quita un frame del índice hash.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame que se va a quitar.
+ */
+static void indexRemove(FrameList *frameList, uint32_t index) {
+    uint32_t *link = &frameList->buckets[hashPage(frameList, frameList->frames[index].page)];
+    while (*link != NO_INDEX) {
+        if (*link == index) {
+            *link = frameList->frames[index].hashNext;
+            frameList->frames[index].hashNext = NO_INDEX;
+            return;
+        }
+        link = &frameList->frames[*link].hashNext;
+    }
+}
+
+/*
+ * Función: linkFrame
+ * Descripción: Coloca un frame al frente (más reciente) de una cubeta de frecuencia.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - nodeIndex: Cubeta de frecuencia destino.
+ *  - index: Índice del frame a colocar.
+ */
+static void linkFrame(FrameList *frameList, uint32_t nodeIndex, uint32_t index) {
+    FreqNode *node = &frameList->nodes[nodeIndex];
+    Frame *frame = &frameList->frames[index];
+    frame->freqNode = nodeIndex;
+    frame->prev = NO_INDEX;
+    frame->next = node->head;
+    if (node->head != NO_INDEX) {
+        frameList->frames[node->head].prev = index;
     } else {
-        frame->next = frameList->head;
-        frameList->head->prev = frame;
-        frameList->head = frame;
+        node->tail = index;
     }
-    frameList->numFrames++;
+    node->head = index;
 }
 
 /*
- * Función: removeFrame
- * Descripción: Elimina un frame específico de la lista.
+ * Función: unlinkFrame
+ * Descripción: Saca un frame de su cubeta de frecuencia y elimina la cubeta si queda vacía.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
- *  - frame: Puntero al frame a eliminar.
+ *  - index: Índice del frame a desconectar.
  */
-void removeFrame(FrameList *frameList, Frame *frame) {
-    if (frame->prev != NULL) {
-        frame->prev->next = frame->next;
+static void unlinkFrame(FrameList *frameList, uint32_t index) {
+    Frame *frames = frameList->frames;
+    Frame *frame = &frames[index];
+    uint32_t nodeIndex = frame->freqNode;
+    FreqNode *node = &frameList->nodes[nodeIndex];
+    if (frame->prev != NO_INDEX) {
+        frames[frame->prev].next = frame->next;
     } else {
-        frameList->head = frame->next;
+        node->head = frame->next;
     }
-    if (frame->next != NULL) {
-        frame->next->prev = frame->prev;
+    if (frame->next != NO_INDEX) {
+        frames[frame->next].prev = frame->prev;
     } else {
-        frameList->tail = frame->prev;
+        node->tail = frame->prev;
     }
+    frame->prev = NO_INDEX;
+    frame->next = NO_INDEX;
+    frame->freqNode = NO_INDEX;
+
+    if (node->head == NO_INDEX) {
+        if (node->prev != NO_INDEX) {
+            frameList->nodes[node->prev].next = node->next;
+        } else {
+            frameList->head = node->next;
+        }
+        if (node->next != NO_INDEX) {
+            frameList->nodes[node->next].prev = node->prev;
+        }
+
+        // Devolver la cubeta vacía a su lista libre
+        node->next = frameList->freeNodes;
+        frameList->freeNodes = nodeIndex;
+    }
+}
+
+/*
+ * Función: insertFrame
+ * Descripción: Inserta un frame nuevo (frecuencia 1) en la cubeta de menor frecuencia.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame a insertar.
+ */
+static void insertFrame(FrameList *frameList, uint32_t index) {
+    uint32_t nodeIndex = frameList->head;
+    if (nodeIndex == NO_INDEX || frameList->nodes[nodeIndex].frequency != 1) {
+        nodeIndex = createFreqNode(frameList, 1);
+        frameList->nodes[nodeIndex].next = frameList->head;
+        if (frameList->head != NO_INDEX) {
+            frameList->nodes[frameList->head].prev = nodeIndex;
+        }
+        frameList->head = nodeIndex;
+    }
+    linkFrame(frameList, nodeIndex, index);
+    indexInsert(frameList, index);
+    frameList->numFrames++;
+}
+
+/*
+ * Función: touchFrame
+ * Descripción: Pasa un frame al frente de su cubeta de frecuencia, sin cambiar su frecuencia.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame accedido.
+ */
+static void touchFrame(FrameList *frameList, uint32_t index) {
+    uint32_t nodeIndex = frameList->frames[index].freqNode;
+    if (frameList->nodes[nodeIndex].head != index) {  // La cubeta tiene otro frame más, así que no se libera
+        unlinkFrame(frameList, index);
+        linkFrame(frameList, nodeIndex, index);
+    }
+}
+
+/*
+ * Función: incrementFrequency
+ * Descripción: Incrementa la frecuencia de un frame moviéndolo a la cubeta siguiente. En FREQUENCY_MAX
+ *              el contador satura y el frame solo pasa al frente de su cubeta.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame accedido.
+ */
+static void incrementFrequency(FrameList *frameList, uint32_t index) {
+    uint32_t nodeIndex = frameList->frames[index].freqNode;
+    FreqNode *node = &frameList->nodes[nodeIndex];
+    if (node->frequency == FREQUENCY_MAX) {
+        touchFrame(frameList, index);
+        return;
+    }
+    uint16_t frequency = (uint16_t)(node->frequency + 1);
+    uint32_t target = node->next;
+
+    if (target == NO_INDEX || frameList->nodes[target].frequency != frequency) {
+        // Crear la cubeta de la nueva frecuencia justo después de la actual
+        target = createFreqNode(frameList, frequency);
+        frameList->nodes[target].prev = nodeIndex;
+        frameList->nodes[target].next = node->next;
+        if (node->next != NO_INDEX) {
+            frameList->nodes[node->next].prev = target;
+        }
+        node->next = target;
+    }
+    unlinkFrame(frameList, index);  // Puede liberar la cubeta anterior si queda vacía
+    linkFrame(frameList, target, index);
+}
+
+/*
+ * Función: ageFrequencies
+ * Descripción: Divide a la mitad la frecuencia de todos los frames (como mínimo 1). Las cubetas siguen
+ *              ordenadas; las que quedan con la misma frecuencia se fusionan poniendo los frames de la
+ *              cubeta que era más frecuente del lado reciente, para que salgan después.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void ageFrequencies(FrameList *frameList) {
+    Frame *frames = frameList->frames;
+    FreqNode *nodes = frameList->nodes;
+    uint32_t previous = NO_INDEX;
+    uint32_t nodeIndex = frameList->head;
+    while (nodeIndex != NO_INDEX) {
+        FreqNode *node = &nodes[nodeIndex];
+        uint32_t next = node->next;
+        INSTRUMENT(frameList->stats.scanSteps++);
+        uint16_t frequency = (uint16_t)(node->frequency / 2 > 1 ? node->frequency / 2 : 1);
+        if (previous != NO_INDEX && nodes[previous].frequency == frequency) {
+            for (uint32_t i = node->head; i != NO_INDEX; i = frames[i].next) {
+                frames[i].freqNode = previous;
+            }
+            frames[node->tail].next = nodes[previous].head;
+            frames[nodes[previous].head].prev = node->tail;
+            nodes[previous].head = node->head;
+
+            nodes[previous].next = next;
+            if (next != NO_INDEX) {
+                nodes[next].prev = previous;
+            }
+            node->next = frameList->freeNodes;
+            frameList->freeNodes = nodeIndex;
+        } else {
+            node->frequency = frequency;
+            previous = nodeIndex;
+        }
+        nodeIndex = next;
+    }
+}
+
+/*
+ * Función: removeFrame
+ * Descripción: Elimina un frame específico de la lista y lo devuelve a la lista libre.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - index: Índice del frame a eliminar.
+ */
+static void removeFrame(FrameList *frameList, uint32_t index) {
+    unlinkFrame(frameList, index);
+    indexRemove(frameList, index);
     frameList->numFrames--;
-    free(frame);  // Liberar la memoria del frame eliminado
+
+    // Devolver el frame a la lista libre para reciclarlo
+    frameList->frames[index].page = EMPTY_PAGE;
+    frameList->frames[index].next = frameList->freeFrames;
+    frameList->freeFrames = index;
 }
 
 /*
  * Función: findFrame
- * Descripción: Busca un frame por número de página.
+ * Descripción: Busca un frame por número de página a través del índice hash.
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  *  - page: Número de la página a buscar.
- * Retorna: Puntero al frame encontrado o NULL si no está.
+ * Retorna: Índice del frame encontrado o NO_INDEX si no está.
  */
-Frame* findFrame(FrameList *frameList, int page) {
-    Frame *current = frameList->head;
-    while (current != NULL) {
-        if (current->page == page) {
+static uint32_t findFrame(FrameList *frameList, int page) {
+    uint32_t current = frameList->buckets[hashPage(frameList, page)];
+    INSTRUMENT(frameList->stats.lookups++);
+    while (current != NO_INDEX) {
+        INSTRUMENT(frameList->stats.lookupSteps++);
+        if (frameList->frames[current].page == page) {
             return current;
         }
-        current = current->next;
+        current = frameList->frames[current].hashNext;
     }
-    return NULL;
+    return NO_INDEX;
+}
+
+/*
+ * Función: victimPage
+ * Descripción: Devuelve la página que desalojaría LFU: la menos reciente de la cubeta de menor frecuencia.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames (no vacía).
+ * Retorna: Número de página de la víctima.
+ */
+static int victimPage(const FrameList *frameList) {
+    return frameList->frames[frameList->nodes[frameList->head].tail].page;
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja el frame LFU: el menos reciente de la cubeta de menor frecuencia.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Página desalojada, o -1 si la lista está vacía.
+ */
+static int evictFrame(FrameList *frameList) {
+    if (frameList->head == NO_INDEX) {
+        return -1;
+    }
+    uint32_t lfuFrame = frameList->nodes[frameList->head].tail;
+    INSTRUMENT(frameList->stats.scanSteps++);  // La cubeta de menor frecuencia es siempre la primera
+    int page = frameList->frames[lfuFrame].page;
+    if (testBit(frameList->prefetched, (int)lfuFrame)) {
+        frameList->stats.prefetchWasted++;  // Leída por adelantado y nunca pedida
+        clearBit(frameList->prefetched, (int)lfuFrame);
+    }
+    if (testBit(frameList->dirty, (int)lfuFrame)) {
+        recordWriteBack(&frameList->writeBack, &frameList->stats, page);
+        clearBit(frameList->dirty, (int)lfuFrame);
+    }
+    removeFrame(frameList, lfuFrame);  // Eliminar el frame LFU
+    frameList->stats.evictions++;
+    return page;
 }
 
 /*
@@ -133,31 +655,87 @@ Frame* findFrame(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  *  - page: Número de la página a cargar.
+ *  - write: true si el acceso modifica la página.
+ * Retorna: true si la página ya estaba en memoria (acierto).
  */
-void loadPage(FrameList *frameList, int page) {
-    Frame *frame = findFrame(frameList, page);
-    if (frame != NULL) {
-        frame->frequency++;  // Incrementar la frecuencia si la página ya está en memoria
-    } else {
-        frame = createFrame();
-        frame->page = page;
-        frame->valid = true;
-        frame->frequency = 1;
-
-        if (frameList->numFrames == NUM_FRAMES) {
-            // Encontrar el frame con menor frecuencia de uso
-            Frame *lfuFrame = frameList->head;
-            Frame *current = frameList->head;
-            while (current != NULL) {
-                if (current->frequency < lfuFrame->frequency) {
-                    lfuFrame = current;
-                }
-                current = current->next;
+static bool loadPage(FrameList *frameList, int page, bool write) {
+    uint32_t frame = findFrame(frameList, page);
+    frameList->stats.accesses++;
+    frameList->stats.writes += write;
+    if (frameList->sketch != NULL) {
+        sketchIncrement(frameList->sketch, page);
+    }
+    if (frameList->agingPeriod != 0 && frameList->stats.accesses % frameList->agingPeriod == 0) {
+        ageFrequencies(frameList);
+        if (frameList->sketch != NULL) {
+            sketchHalve(frameList->sketch);
+        }
+    }
+    if (frame != NO_INDEX) {
+        frameList->stats.hits++;
+        if (write) {
+            setBit(frameList->dirty, (int)frame);
+        }
+        if (testBit(frameList->prefetched, (int)frame)) {
+            // Primera referencia a una página leída por adelantado: equivale a su carga
+            clearBit(frameList->prefetched, (int)frame);
+            frameList->stats.prefetchHits++;
+            touchFrame(frameList, frame);
+            return true;
+        }
+        incrementFrequency(frameList, frame);  // Incrementar la frecuencia si la página ya está en memoria
+        return true;
+    }
+    frameList->stats.misses++;
+
+    // Con la memoria llena, el frame desalojado vuelve a la lista libre y se reutiliza de inmediato
+    if (frameList->numFrames == frameList->capacity) {
+        // TinyLFU: la página solo entra si es más frecuente que la víctima según el sketch
+        if (frameList->sketch != NULL && frameList->head != NO_INDEX &&
+            sketchEstimate(frameList->sketch, page) <= sketchEstimate(frameList->sketch, victimPage(frameList))) {
+            frameList->rejected++;
+            if (write) {
+                recordWriteBack(&frameList->writeBack, &frameList->stats, page);  // Escritura directa a disco
             }
-            removeFrame(frameList, lfuFrame);  // Eliminar el frame LFU
+            return false;
+        }
+        evictFrame(frameList);
+    }
+    frame = createFrame(frameList);
+    frameList->frames[frame].page = page;
+    insertFrame(frameList, frame);  // Insertar el nuevo frame en la cubeta de frecuencia 1
+    if (write) {
+        setBit(frameList->dirty, (int)frame);
+    }
+    return false;
+}
+
+/*
+ * Función: prefetchPage
+ * Descripción: Carga una página por adelantado en la cubeta de frecuencia 1, sin contarla como acceso
+ *              ni en el sketch. Con el filtro TinyLFU pasa por la misma admisión que una carga por demanda.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página a cargar.
+ * Retorna: true si se cargó (false si ya estaba en memoria o el filtro no la admitió).
+ */
+static bool prefetchPage(FrameList *frameList, int page) {
+    if (findFrame(frameList, page) != NO_INDEX) {
+        return false;
+    }
+    if (frameList->numFrames == frameList->capacity) {
+        if (frameList->sketch != NULL && frameList->head != NO_INDEX &&
+            sketchEstimate(frameList->sketch, page) <= sketchEstimate(frameList->sketch, victimPage(frameList))) {
+            return false;
         }
-        insertFrame(frameList, frame);  // Insertar el nuevo frame al frente
+        evictFrame(frameList);
     }
+    uint32_t frame = createFrame(frameList);
+    frameList->frames[frame].page = page;
+    insertFrame(frameList, frame);
+    setBit(frameList->prefetched, (int)frame);
+    frameList->stats.prefetches++;
+    return true;
 }
 
 /*
@@ -166,33 +744,136 @@ void loadPage(FrameList *frameList, int page) {
  * Parámetros:
  *  - frameList: Puntero a la lista de frames.
  */
-void printFrameList(FrameList *frameList) {
+static void printFrameList(FrameList *frameList) {
     printf("Estado actual de la lista de frames:\n");
-    Frame *current = frameList->head;
-    while (current != NULL) {
-        printf("Página: %d, Frecuencia: %d, Estado: %s\n", 
-               current->page, current->frequency, 
-               current->valid ? "Ocupado" : "Vacío");
-        current = current->next;
+    for (uint32_t node = frameList->head; node != NO_INDEX; node = frameList->nodes[node].next) {
+        uint32_t current = frameList->nodes[node].head;
+        while (current != NO_INDEX) {
+            const Frame *frame = &frameList->frames[current];
+            printf("Página: %d, Frecuencia: %d, Estado: %s, Sucio: %d\n",
+                   frame->page, frameList->nodes[node].frequency,
+                   frame->page != EMPTY_PAGE ? "Ocupado" : "Vacío", testBit(frameList->dirty, (int)current));
+            current = frame->next;
+        }
+    }
+    if (frameList->sketch != NULL) {
+        printf("Admisiones rechazadas: %llu\n", (unsigned long long)frameList->rejected);
     }
     printf("\n");
 }
 
 /*
- * Función: main
- * Descripción: Función principal que simula la carga de páginas utilizando LFU.
+ * Funciones: lfuCreate, lfuAgeCreate, lfuTinyCreate, lfuDestroy, lfuAccess, lfuEvict, lfuStats, lfuPrint,
+ *            lfuSave, lfuRestore, lfuPrefetch, lfuWrite
+ * Descripción: Adaptan las funciones del algoritmo LFU a la interfaz común PolicyOps; las variantes
+ *              solo difieren en el envejecimiento y el filtro de admisión con que se crea la lista. El
+ *              checkpoint guarda los frames, las cubetas de frecuencia, el índice hash, los mapas de
+ *              lecturas anticipadas y de páginas modificadas y el sketch.
  */
-int main() {
-    FrameList *frameList = createFrameList();  // Inicializar la lista de frames
+static void* lfuCreate(int numFrames) {
+    return createFrameList(numFrames, false, false);
+}
 
-    int pageAccesses[NUM_PAGES] = {1, 2, 3, 4, 5, 1, 2, 1, 3, 4};  // Accesos simulados
+static void* lfuAgeCreate(int numFrames) {
+    return createFrameList(numFrames, true, false);
+}
+
+static void* lfuTinyCreate(int numFrames) {
+    return createFrameList(numFrames, true, true);
+}
+
+static void lfuDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
+
+static bool lfuAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page, false);
+}
+
+static bool lfuWrite(void *state, int page) {
+    return loadPage((FrameList *)state, page, true);
+}
+
+static int lfuEvict(void *state) {
+    return evictFrame((FrameList *)state);
+}
+
+static const SimStats* lfuStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
 
-    for (int i = 0; i < NUM_PAGES; ++i) {
-        loadPage(frameList, pageAccesses[i]);  // Cargar páginas según los accesos
-        printFrameList(frameList);  // Imprimir estado tras cada carga
+static void lfuPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+static bool lfuPrefetch(void *state, int page) {
+    return prefetchPage((FrameList *)state, page);
+}
+
+static bool lfuSave(void *state, FILE *out) {
+    FrameList *frameList = (FrameList *)state;
+    return saveBlock(out, frameList, sizeof(FrameList)) &&
+           saveBlock(out, frameList->frames, (size_t)frameList->capacity * sizeof(Frame)) &&
+           saveBlock(out, frameList->nodes, (size_t)numFreqNodes(frameList->capacity) * sizeof(FreqNode)) &&
+           saveBlock(out, frameList->buckets, (size_t)frameList->numBuckets * sizeof(uint32_t)) &&
+           saveBlock(out, frameList->prefetched, BITMAP_WORDS(frameList->capacity) * sizeof(uint64_t)) &&
+           saveBlock(out, frameList->dirty, BITMAP_WORDS(frameList->capacity) * sizeof(uint64_t)) &&
+           (frameList->sketch == NULL ||
+            saveBlock(out, frameList->sketch->words,
+                      (size_t)SKETCH_DEPTH * frameList->sketch->wordsPerRow * sizeof(uint64_t)));
+}
+
+static bool lfuRestore(void *state, PolicyImage *image) {
+    FrameList *frameList = (FrameList *)state;
+    FrameList saved;
+    if (!loadBlock(image, &saved, sizeof(FrameList)) || saved.capacity != frameList->capacity ||
+        saved.agingPeriod != frameList->agingPeriod || (saved.sketch == NULL) != (frameList->sketch == NULL)) {
+        return false;
+    }
+    saved.frames = frameList->frames;  // Los punteros guardados no valen: se conservan los arrays propios
+    saved.nodes = frameList->nodes;
+    saved.buckets = frameList->buckets;
+    saved.prefetched = frameList->prefetched;
+    saved.dirty = frameList->dirty;
+    saved.sketch = frameList->sketch;
+    if (!loadBlock(image, saved.frames, (size_t)saved.capacity * sizeof(Frame)) ||
+        !loadBlock(image, saved.nodes, (size_t)numFreqNodes(saved.capacity) * sizeof(FreqNode)) ||
+        !loadBlock(image, saved.buckets, (size_t)saved.numBuckets * sizeof(uint32_t)) ||
+        !loadBlock(image, saved.prefetched, BITMAP_WORDS(saved.capacity) * sizeof(uint64_t)) ||
+        !loadBlock(image, saved.dirty, BITMAP_WORDS(saved.capacity) * sizeof(uint64_t)) ||
+        (saved.sketch != NULL &&
+         !loadBlock(image, saved.sketch->words,
+                    (size_t)SKETCH_DEPTH * saved.sketch->wordsPerRow * sizeof(uint64_t)))) {
+        return false;
     }
+    *frameList = saved;
+    return true;
+}
+
+const PolicyOps lfuPolicy = {
+    "LFU", lfuCreate, lfuDestroy, lfuAccess, lfuEvict, lfuStats, lfuPrint,
+    lfuSave, lfuRestore, NULL, lfuPrefetch, lfuWrite
+};
+
+const PolicyOps lfuAgePolicy = {
+    "LFU-AGE", lfuAgeCreate, lfuDestroy, lfuAccess, lfuEvict, lfuStats, lfuPrint,
+    lfuSave, lfuRestore, NULL, lfuPrefetch, lfuWrite
+};
 
-    free(frameList);  // Liberar la memoria utilizada
+const PolicyOps lfuTinyPolicy = {
+    "LFU-TINY", lfuTinyCreate, lfuDestroy, lfuAccess, lfuEvict, lfuStats, lfuPrint,
+    lfuSave, lfuRestore, NULL, lfuPrefetch, lfuWrite
+};
 
-    return 0;
+#ifndef POLICY_LIBRARY
+/*
+ * Función: main
+ * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo LFU.
+ *              Uso: OPR-LFU [-p LFU|LFU-AGE|LFU-TINY,...] [-t traza] [-d cadaN] [-q] [numFrames] [página ...]
+ *              (ver driver.h).
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *policies[] = { &lfuPolicy, &lfuAgePolicy, &lfuTinyPolicy };
+    return runDriver(argc, argv, policies, 3);
 }
+#endif
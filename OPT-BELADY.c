@@ -0,0 +1,469 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Este programa implementa el algoritmo de reemplazo **óptimo de Belady (OPT/MIN)**: ante un fallo con la
+ * memoria llena se desaloja la página cuya próxima referencia está más lejos en el futuro (o que no se
+ * vuelve a referenciar). No es realizable en un sistema real, pero con la traza completa de antemano da
+ * la tasa de aciertos máxima que puede alcanzar cualquier algoritmo con el mismo número de frames, la
+ * cota con la que se comparan LRU, CLOCK y LFU.
+ *
+ * El futuro se conoce mediante la operación lookahead de PolicyOps: el driver entrega la entrada completa
+ * antes de simular y el algoritmo la copia en un array de 32 bits, una posición por referencia. Al
+ * terminar, una pasada hacia atrás sustituye en el mismo array cada página por la posición de su próxima
+ * referencia (NEVER si no vuelve a aparecer), con una tabla hash de la última posición vista de cada
+ * página; el array cuesta 4 bytes por referencia y la tabla, 8 bytes por posición para las páginas
+ * distintas. Durante la simulación la próxima referencia de cada acceso se lee en orden de ese array.
+ *
+ * Los frames residentes forman un montículo de máximos ordenado por su próxima referencia, así que la
+ * víctima está siempre en la raíz: un acierto o un fallo cuestan O(log frames). Un índice hash página ->
+ * frame, como el de CAR-CLOCK.c, localiza las páginas residentes y cada frame recuerda su posición en el
+ * montículo.
+ *
+ * Los tipos y funciones del algoritmo son privados; se exportan a través de optPolicy (policy.h) y el
+ * main se omite al compilar con -DPOLICY_LIBRARY para enlazarlo junto a los demás en el simulador. Solo
+ * admite trazas de menos de 2^32 - 1 referencias y no admite checkpoints.
+ *
+ * Compilación: gcc -O2 -pthread OPT-BELADY.c driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o OPT-BELADY
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "policy.h"
+#include "driver.h"
+
+#define NO_FRAME -1                 // Índice nulo en el índice hash y en la lista de frames libres
+#define NEVER UINT32_MAX            // Próxima referencia de una página que no se vuelve a referenciar
+#define MIN_LAST_CAPACITY 1024      // Posiciones iniciales de la tabla de la pasada hacia atrás
+#define MIN_FUTURE_CAPACITY 65536   // Referencias iniciales del array del futuro
+
+// Estructura para administrar los frames y el futuro de la entrada
+typedef struct FrameList {
+    int capacity;           // Número de frames disponibles en memoria física
+    int numFrames;          // Número de frames actualmente ocupados
+    int *pages;             // Página almacenada en cada frame
+    uint32_t *nextUse;      // Próxima referencia de la página de cada frame
+    int *heap;              // Montículo de máximos de frames ocupados por nextUse
+    int *heapIndex;         // Posición de cada frame ocupado en el montículo
+    int *hashNext;          // Siguiente frame en la misma cubeta (o en la lista libre)
+    int *buckets;           // Cubetas del índice hash página -> frame
+    int numBuckets;         // Número de cubetas (potencia de 2)
+    int freeFrames;         // Primer frame libre, enlazado por hashNext
+    uint32_t *future;       // Página de cada referencia y, tras la pasada hacia atrás, su próxima referencia
+    size_t futureLength;    // Referencias recibidas por lookahead
+    size_t futureCapacity;  // Capacidad de future
+    bool prepared;          // La pasada hacia atrás ya se hizo
+    size_t position;        // Referencias simuladas
+    SimStats stats;         // Contadores de accesos, aciertos, fallos y desalojos
+} FrameList;
+
+/*
+ * Función: destroyFrameList
+ * Descripción: Libera los arrays de frames, el índice hash, el futuro y la propia lista.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void destroyFrameList(FrameList *frameList) {
+    free(frameList->pages);
+    free(frameList->nextUse);
+    free(frameList->heap);
+    free(frameList->heapIndex);
+    free(frameList->hashNext);
+    free(frameList->buckets);
+    free(frameList->future);
+    free(frameList);
+}
+
+/*
+ * Función: createFrameList
+ * Descripción: Inicializa los frames vacíos, todos en la lista libre, sin futuro conocido.
+ * Parámetros:
+ *  - capacity: Número de frames disponibles en memoria física.
+ * Retorna: Puntero a la lista creada.
+ */
+static FrameList* createFrameList(int capacity) {
+    FrameList *frameList = (FrameList *)calloc(1, sizeof(FrameList));
+    if (frameList != NULL) {
+        frameList->numBuckets = 1;
+        while (frameList->numBuckets < 2 * capacity) {
+            frameList->numBuckets <<= 1;
+        }
+        frameList->pages = (int *)malloc((size_t)capacity * sizeof(int));
+        frameList->nextUse = (uint32_t *)malloc((size_t)capacity * sizeof(uint32_t));
+        frameList->heap = (int *)malloc((size_t)capacity * sizeof(int));
+        frameList->heapIndex = (int *)malloc((size_t)capacity * sizeof(int));
+        frameList->hashNext = (int *)malloc((size_t)capacity * sizeof(int));
+        frameList->buckets = (int *)malloc((size_t)frameList->numBuckets * sizeof(int));
+        if (frameList->pages == NULL || frameList->nextUse == NULL || frameList->heap == NULL ||
+            frameList->heapIndex == NULL || frameList->hashNext == NULL || frameList->buckets == NULL) {
+            destroyFrameList(frameList);
+            return NULL;
+        }
+        frameList->capacity = capacity;
+        for (int i = 0; i < frameList->numBuckets; i++) {
+            frameList->buckets[i] = NO_FRAME;
+        }
+        for (int i = 0; i < capacity; i++) {
+            frameList->pages[i] = -1;
+            frameList->hashNext[i] = i + 1 < capacity ? i + 1 : NO_FRAME;
+        }
+        frameList->freeFrames = capacity > 0 ? 0 : NO_FRAME;
+    }
+    return frameList;
+}
+
+/*
+ * Función: hashPage
+ * Descripción: Calcula la cubeta del índice hash que corresponde a una página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static int hashPage(const FrameList *frameList, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (int)(h & (uint32_t)(frameList->numBuckets - 1));
+}
+
+/*
+ * Función: findFrame
+ * Descripción: Busca en el índice hash el frame de una página residente.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página que se busca.
+ * Retorna: Índice del frame, o NO_FRAME si la página no está en memoria.
+ */
+static int findFrame(FrameList *frameList, int page) {
+    int frame = frameList->buckets[hashPage(frameList, page)];
+    INSTRUMENT(frameList->stats.lookups++);
+    while (frame != NO_FRAME) {
+        INSTRUMENT(frameList->stats.lookupSteps++);
+        if (frameList->pages[frame] == page) {
+            break;
+        }
+        frame = frameList->hashNext[frame];
+    }
+    return frame;
+}
+
+/*
+ * Función: indexRemove
+ * Descripción: Quita un frame del índice hash según su página.
+ */
+static void indexRemove(FrameList *frameList, int frame) {
+    int *link = &frameList->buckets[hashPage(frameList, frameList->pages[frame])];
+    while (*link != frame) {
+        link = &frameList->hashNext[*link];
+    }
+    *link = frameList->hashNext[frame];
+}
+
+/*
+ * Funciones: heapPlace, siftUp, siftDown
+ * Descripción: Colocan un frame en una posición del montículo y lo hacen subir o bajar hasta que su
+ *              próxima referencia quede ordenada respecto a la de su padre y sus hijos.
+ */
+static void heapPlace(FrameList *frameList, int position, int frame) {
+    frameList->heap[position] = frame;
+    frameList->heapIndex[frame] = position;
+}
+
+static void siftUp(FrameList *frameList, int position) {
+    int frame = frameList->heap[position];
+    uint32_t key = frameList->nextUse[frame];
+    while (position > 0) {
+        int parent = (position - 1) / 2;
+        if (frameList->nextUse[frameList->heap[parent]] >= key) {
+            break;
+        }
+        heapPlace(frameList, position, frameList->heap[parent]);
+        position = parent;
+    }
+    heapPlace(frameList, position, frame);
+}
+
+static void siftDown(FrameList *frameList, int position) {
+    int frame = frameList->heap[position];
+    uint32_t key = frameList->nextUse[frame];
+    for (;;) {
+        int child = 2 * position + 1;
+        if (child >= frameList->numFrames) {
+            break;
+        }
+        if (child + 1 < frameList->numFrames &&
+            frameList->nextUse[frameList->heap[child + 1]] > frameList->nextUse[frameList->heap[child]]) {
+            child++;
+        }
+        if (frameList->nextUse[frameList->heap[child]] <= key) {
+            break;
+        }
+        heapPlace(frameList, position, frameList->heap[child]);
+        position = child;
+    }
+    heapPlace(frameList, position, frame);
+}
+
+/*
+ * Función: evictFrame
+ * Descripción: Desaloja la página residente cuya próxima referencia está más lejos (la raíz del montículo).
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ * Retorna: Página desalojada, o -1 si no hay frames ocupados.
+ */
+static int evictFrame(FrameList *frameList) {
+    if (frameList->numFrames == 0) {
+        return -1;
+    }
+    int victim = frameList->heap[0];
+    int page = frameList->pages[victim];
+    frameList->numFrames--;
+    if (frameList->numFrames > 0) {
+        heapPlace(frameList, 0, frameList->heap[frameList->numFrames]);
+        siftDown(frameList, 0);
+    }
+    indexRemove(frameList, victim);
+    frameList->pages[victim] = -1;
+    frameList->hashNext[victim] = frameList->freeFrames;
+    frameList->freeFrames = victim;
+    frameList->stats.evictions++;
+    return page;
+}
+
+/*
+ * Función: loadPage
+ * Descripción: Carga una página en memoria utilizando el algoritmo óptimo. Sin futuro conocido (o más
+ *              allá de la entrada recibida) la página se trata como si no se volviera a referenciar.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - page: Número de la página a cargar.
+ * Retorna: true si la página ya estaba en memoria (acierto).
+ */
+static bool loadPage(FrameList *frameList, int page) {
+    size_t position = frameList->position++;
+    uint32_t next = frameList->prepared && position < frameList->futureLength ? frameList->future[position] : NEVER;
+    int frame = findFrame(frameList, page);
+    frameList->stats.accesses++;
+
+    if (frame != NO_FRAME) {
+        // Acierto: la próxima referencia solo puede alejarse, así que el frame sube en el montículo
+        frameList->stats.hits++;
+        frameList->nextUse[frame] = next;
+        siftUp(frameList, frameList->heapIndex[frame]);
+        return true;
+    }
+
+    frameList->stats.misses++;
+    if (frameList->numFrames == frameList->capacity) {
+        evictFrame(frameList);
+    }
+    frame = frameList->freeFrames;
+    frameList->freeFrames = frameList->hashNext[frame];
+    frameList->pages[frame] = page;
+    frameList->nextUse[frame] = next;
+    int bucket = hashPage(frameList, page);
+    frameList->hashNext[frame] = frameList->buckets[bucket];
+    frameList->buckets[bucket] = frame;
+    heapPlace(frameList, frameList->numFrames++, frame);
+    siftUp(frameList, frameList->numFrames - 1);
+    return false;
+}
+
+/*
+ * Función: appendFuture
+ * Descripción: Añade un lote de la entrada al array del futuro, duplicando su capacidad si hace falta.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ *  - pages: Páginas del lote.
+ *  - count: Número de páginas del lote.
+ * Retorna: false si no hay memoria o la entrada no cabe en posiciones de 32 bits.
+ */
+static bool appendFuture(FrameList *frameList, const int *pages, size_t count) {
+    if (count >= (size_t)NEVER - frameList->futureLength) {
+        fprintf(stderr, "OPT: la entrada tiene más de %u referencias\n", NEVER - 1);
+        return false;
+    }
+    if (frameList->futureLength + count > frameList->futureCapacity) {
+        size_t capacity = frameList->futureCapacity > 0 ? frameList->futureCapacity : MIN_FUTURE_CAPACITY;
+        while (capacity < frameList->futureLength + count) {
+            capacity *= 2;
+        }
+        uint32_t *future = (uint32_t *)realloc(frameList->future, capacity * sizeof(uint32_t));
+        if (future == NULL) {
+            fprintf(stderr, "OPT: no hay memoria para %zu referencias\n", capacity);
+            return false;
+        }
+        frameList->future = future;
+        frameList->futureCapacity = capacity;
+    }
+    memcpy(frameList->future + frameList->futureLength, pages, count * sizeof(uint32_t));
+    frameList->futureLength += count;
+    return true;
+}
+
+/*
+ * Función: slotOf
+ * Descripción: Posición inicial de una página en la tabla de la pasada hacia atrás (finalizador fmix32
+ *              de MurmurHash3, para que las páginas consecutivas no formen racimos con el sondeo lineal).
+ */
+static size_t slotOf(uint32_t page, size_t mask) {
+    uint32_t h = page;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return (size_t)h & mask;
+}
+
+/*
+ * Función: buildNextUse
+ * Descripción: Pasada hacia atrás sobre el futuro: cada página se sustituye por la posición de su próxima
+ *              referencia, con una tabla de sondeo lineal (página -> última posición vista) que se
+ *              duplica al superar la mitad de ocupación.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames (con el futuro completo).
+ * Retorna: false si no hay memoria para la tabla.
+ */
+static bool buildNextUse(FrameList *frameList) {
+    size_t capacity = MIN_LAST_CAPACITY;
+    size_t used = 0;
+    uint32_t *keys = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+    uint32_t *last = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+    bool ok = keys != NULL && last != NULL;
+    if (ok) {
+        memset(last, 0xff, capacity * sizeof(uint32_t));  // NEVER: posición libre
+    }
+    for (size_t i = frameList->futureLength; ok && i-- > 0; ) {
+        uint32_t page = frameList->future[i];
+        size_t slot = slotOf(page, capacity - 1);
+        while (last[slot] != NEVER && keys[slot] != page) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        frameList->future[i] = last[slot];
+        if (last[slot] == NEVER) {
+            keys[slot] = page;
+            used++;
+        }
+        last[slot] = (uint32_t)i;
+        if (2 * used <= capacity) {
+            continue;
+        }
+
+        // Duplicar la tabla y reinsertar las páginas ya vistas
+        uint32_t *grownKeys = (uint32_t *)malloc(2 * capacity * sizeof(uint32_t));
+        uint32_t *grownLast = (uint32_t *)malloc(2 * capacity * sizeof(uint32_t));
+        ok = grownKeys != NULL && grownLast != NULL;
+        if (ok) {
+            memset(grownLast, 0xff, 2 * capacity * sizeof(uint32_t));
+            for (size_t s = 0; s < capacity; s++) {
+                if (last[s] == NEVER) {
+                    continue;
+                }
+                size_t target = slotOf(keys[s], 2 * capacity - 1);
+                while (grownLast[target] != NEVER) {
+                    target = (target + 1) & (2 * capacity - 1);
+                }
+                grownKeys[target] = keys[s];
+                grownLast[target] = last[s];
+            }
+            free(keys);
+            free(last);
+            keys = grownKeys;
+            last = grownLast;
+            capacity *= 2;
+        } else {
+            free(grownKeys);
+            free(grownLast);
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "OPT: no hay memoria para la pasada hacia atrás\n");
+    }
+    free(keys);
+    free(last);
+    return ok;
+}
+
+/*
+ * Función: printFrameList
+ * Descripción: Imprime el contenido de los frames en el orden del montículo, con la próxima referencia
+ *              de cada página.
+ * Parámetros:
+ *  - frameList: Puntero a la lista de frames.
+ */
+static void printFrameList(FrameList *frameList) {
+    printf("Estado actual de los frames:\n");
+    for (int i = 0; i < frameList->numFrames; i++) {
+        int frame = frameList->heap[i];
+        if (frameList->nextUse[frame] == NEVER) {
+            printf("Frame %d - Página: %d, Próxima referencia: nunca\n", frame, frameList->pages[frame]);
+        } else {
+            printf("Frame %d - Página: %d, Próxima referencia: %u\n", frame, frameList->pages[frame],
+                   frameList->nextUse[frame]);
+        }
+    }
+    printf("\n");
+}
+
+/*
+ * Funciones: optCreate, optDestroy, optAccess, optEvict, optStats, optPrint, optLookahead
+ * Descripción: Adaptan las funciones del algoritmo óptimo a la interfaz común PolicyOps; optLookahead
+ *              acumula la entrada y hace la pasada hacia atrás al recibir el lote vacío final.
+ */
+static void* optCreate(int numFrames) {
+    return createFrameList(numFrames);
+}
+
+static void optDestroy(void *state) {
+    destroyFrameList((FrameList *)state);
+}
+
+static bool optAccess(void *state, int page) {
+    return loadPage((FrameList *)state, page);
+}
+
+static int optEvict(void *state) {
+    return evictFrame((FrameList *)state);
+}
+
+static const SimStats* optStats(void *state) {
+    return &((FrameList *)state)->stats;
+}
+
+static void optPrint(void *state) {
+    printFrameList((FrameList *)state);
+}
+
+static bool optLookahead(void *state, const int *pages, size_t count) {
+    FrameList *frameList = (FrameList *)state;
+    if (count > 0) {
+        return appendFuture(frameList, pages, count);
+    }
+    frameList->prepared = buildNextUse(frameList);
+    return frameList->prepared;
+}
+
+const PolicyOps optPolicy = {
+    "OPT", optCreate, optDestroy, optAccess, optEvict, optStats, optPrint,
+    NULL, NULL,  // Sin checkpoints: el futuro no forma parte del estado guardado
+    optLookahead, NULL, NULL
+};
+
+#ifndef POLICY_LIBRARY
+/*
+ * Función: main
+ * Descripción: Función principal que simula la carga de páginas en memoria utilizando el algoritmo óptimo.
+ *              Uso: OPT-BELADY [-t traza] [-d cadaN] [-q] [numFrames] [página ...] (ver driver.h).
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *policies[] = { &optPolicy };
+    return runDriver(argc, argv, policies, 1);
+}
+#endif
@@ -0,0 +1,431 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * LRU fragmentado para simulación concurrente. En FIFO-LRU.c cada acierto reordena la lista con
+ * moveToHead, así que varios hilos sobre una sola lista se serializarían en un cerrojo global. Aquí un
+ * hash de la página elige uno de N fragmentos independientes, cada uno con su propia lista LRU (creada
+ * con lruPolicy), su parte de la capacidad y su propio cerrojo; los hilos solo compiten cuando acceden
+ * al mismo fragmento. Los contadores de cada fragmento se suman al final.
+ *
+ * La fragmentación cambia el algoritmo: cada fragmento desaloja su propia página menos usada aunque otro
+ * tenga páginas más antiguas. El main simula después LRU global sobre la misma traza y muestra la
+ * diferencia de tasa de aciertos, para decidir si la ganancia de rendimiento compensa. Con varios hilos
+ * la diferencia incluye también el efecto del entrelazado de los lotes; con -j 1 -s 1 es exactamente 0.
+ *
+ * Como biblioteca (-DPOLICY_LIBRARY) exporta shardedLruPolicy (SHARDED_DEFAULT_SHARDS fragmentos).
+ * El programa necesita FIFO-LRU.c compilado como biblioteca, sin su main:
+ *
+ * Compilación: gcc -O2 -DPOLICY_LIBRARY -c FIFO-LRU.c && \
+ *              gcc -O2 -pthread SHARDED-LRU.c FIFO-LRU.o driver.c timeseries.c checkpoint.c remap.c \
+ *              prefetch.c trace.c stats.c -o SHARDED-LRU
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "policy.h"
+#include "driver.h"
+#include "checkpoint.h"
+
+#define SHARDED_DEFAULT_SHARDS 8    // Fragmentos de shardedLruPolicy
+#define CACHE_LINE 64               // Alineación de cada fragmento, para que los cerrojos no compartan línea
+
+// Un fragmento: su lista LRU y el cerrojo que la protege
+typedef struct Shard {
+    _Alignas(CACHE_LINE) pthread_mutex_t lock;  // Cerrojo del fragmento
+    void *state;                                // Lista LRU creada con lruPolicy
+    int capacity;                               // Frames del fragmento
+} Shard;
+
+// Estado del LRU fragmentado
+typedef struct ShardedLru {
+    Shard *shards;      // Fragmentos (alineados a CACHE_LINE)
+    int numShards;      // Número de fragmentos
+    int capacity;       // Frames totales
+    SimStats stats;     // Suma de los contadores de los fragmentos (ver sumStats)
+} ShardedLru;
+
+/*
+ * Función: shardOf
+ * Descripción: Fragmento de una página (finalizador de MurmurHash3, independiente del hash del índice
+ *              de FIFO-LRU.c para no concentrar las páginas de un fragmento en pocas cubetas).
+ * Parámetros:
+ *  - sharded: Puntero al LRU fragmentado.
+ *  - page: Número de la página.
+ * Retorna: Puntero al fragmento.
+ */
+static Shard* shardOf(ShardedLru *sharded, int page) {
+    uint32_t h = (uint32_t)page;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return &sharded->shards[h % (uint32_t)sharded->numShards];
+}
+
+/*
+ * Función: destroyShardedLru
+ * Descripción: Libera los fragmentos y sus listas.
+ * Parámetros:
+ *  - sharded: Puntero al LRU fragmentado.
+ */
+static void destroyShardedLru(ShardedLru *sharded) {
+    for (int i = 0; sharded->shards != NULL && i < sharded->numShards; i++) {
+        if (sharded->shards[i].state != NULL) {
+            lruPolicy.destroy(sharded->shards[i].state);
+            pthread_mutex_destroy(&sharded->shards[i].lock);
+        }
+    }
+    free(sharded->shards);
+    free(sharded);
+}
+
+/*
+ * Función: createShardedLru
+ * Descripción: Reparte la capacidad entre los fragmentos (los primeros reciben el resto de la división).
+ * Parámetros:
+ *  - capacity: Frames totales.
+ *  - numShards: Número de fragmentos (se reduce a capacity si hay más fragmentos que frames).
+ * Retorna: Puntero al LRU fragmentado, o NULL si no hay memoria.
+ */
+static ShardedLru* createShardedLru(int capacity, int numShards) {
+    ShardedLru *sharded = (ShardedLru *)calloc(1, sizeof(ShardedLru));
+    if (sharded == NULL) {
+        return NULL;
+    }
+    if (numShards > capacity) {
+        numShards = capacity;
+    }
+    sharded->shards = (Shard *)aligned_alloc(CACHE_LINE, (size_t)numShards * sizeof(Shard));
+    if (sharded->shards == NULL) {
+        free(sharded);
+        return NULL;
+    }
+    sharded->numShards = numShards;
+    sharded->capacity = capacity;
+    for (int i = 0; i < numShards; i++) {
+        Shard *shard = &sharded->shards[i];
+        shard->capacity = capacity / numShards + (i < capacity % numShards ? 1 : 0);
+        shard->state = lruPolicy.create(shard->capacity);
+        if (shard->state == NULL) {
+            sharded->numShards = i;
+            destroyShardedLru(sharded);
+            return NULL;
+        }
+        pthread_mutex_init(&shard->lock, NULL);
+    }
+    return sharded;
+}
+
+/*
+ * Función: accessShard
+ * Descripción: Referencia una página en su fragmento, con el cerrojo del fragmento tomado.
+ * Parámetros:
+ *  - sharded: Puntero al LRU fragmentado.
+ *  - page: Número de la página.
+ * Retorna: true si fue un acierto.
+ */
+static bool accessShard(ShardedLru *sharded, int page) {
+    Shard *shard = shardOf(sharded, page);
+    pthread_mutex_lock(&shard->lock);
+    bool hit = lruPolicy.access(shard->state, page);
+    pthread_mutex_unlock(&shard->lock);
+    return hit;
+}
+
+/*
+ * Función: sumStats
+ * Descripción: Suma los contadores de todos los fragmentos en sharded->stats.
+ * Parámetros:
+ *  - sharded: Puntero al LRU fragmentado.
+ * Retorna: Puntero a los contadores sumados.
+ */
+static const SimStats* sumStats(ShardedLru *sharded) {
+    sharded->stats = (SimStats){0};
+    for (int i = 0; i < sharded->numShards; i++) {
+        Shard *shard = &sharded->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        addStats(&sharded->stats, lruPolicy.stats(shard->state));
+        pthread_mutex_unlock(&shard->lock);
+    }
+    return &sharded->stats;
+}
+
+/*
+ * Funciones: shardedCreate, shardedDestroy, shardedAccess, shardedEvict, shardedStats, shardedPrint,
+ *            shardedSave, shardedRestore, shardedPrefetch, shardedWrite
+ * Descripción: Adaptan el LRU fragmentado a la interfaz común PolicyOps. evict desaloja del fragmento
+ *              más lleno, que es el que más tardaría en desalojar por sí solo. El checkpoint es la
+ *              secuencia de los checkpoints de cada fragmento (ver lruPolicy). La lectura anticipada
+ *              carga cada página en su fragmento, como un acceso, y lo mismo las escrituras; cada
+ *              fragmento agrupa solo sus propias víctimas sucias en operaciones de disco.
+ */
+static void* shardedCreate(int numFrames) {
+    return createShardedLru(numFrames, SHARDED_DEFAULT_SHARDS);
+}
+
+static void shardedDestroy(void *state) {
+    destroyShardedLru((ShardedLru *)state);
+}
+
+static bool shardedAccess(void *state, int page) {
+    return accessShard((ShardedLru *)state, page);
+}
+
+static int shardedEvict(void *state) {
+    ShardedLru *sharded = (ShardedLru *)state;
+    Shard *fullest = NULL;
+    uint64_t fullestLoad = 0;
+    for (int i = 0; i < sharded->numShards; i++) {
+        const SimStats *stats = lruPolicy.stats(sharded->shards[i].state);
+        uint64_t load = stats->misses + stats->prefetches - stats->evictions;  // Frames ocupados
+        if (load > fullestLoad) {
+            fullest = &sharded->shards[i];
+            fullestLoad = load;
+        }
+    }
+    if (fullest == NULL) {
+        return -1;
+    }
+    pthread_mutex_lock(&fullest->lock);
+    int page = lruPolicy.evict(fullest->state);
+    pthread_mutex_unlock(&fullest->lock);
+    return page;
+}
+
+static const SimStats* shardedStats(void *state) {
+    return sumStats((ShardedLru *)state);
+}
+
+static void shardedPrint(void *state) {
+    ShardedLru *sharded = (ShardedLru *)state;
+    for (int i = 0; i < sharded->numShards; i++) {
+        printf("Fragmento %d (%d frames)\n", i, sharded->shards[i].capacity);
+        lruPolicy.print(sharded->shards[i].state);
+    }
+}
+
+static bool shardedSave(void *state, FILE *out) {
+    ShardedLru *sharded = (ShardedLru *)state;
+    bool ok = true;
+    for (int i = 0; i < sharded->numShards && ok; i++) {
+        ok = lruPolicy.save(sharded->shards[i].state, out);
+    }
+    return ok;
+}
+
+static bool shardedRestore(void *state, PolicyImage *image) {
+    ShardedLru *sharded = (ShardedLru *)state;
+    bool ok = true;
+    for (int i = 0; i < sharded->numShards && ok; i++) {
+        ok = lruPolicy.restore(sharded->shards[i].state, image);
+    }
+    return ok;
+}
+
+static bool shardedPrefetch(void *state, int page) {
+    Shard *shard = shardOf((ShardedLru *)state, page);
+    pthread_mutex_lock(&shard->lock);
+    bool loaded = lruPolicy.prefetch(shard->state, page);
+    pthread_mutex_unlock(&shard->lock);
+    return loaded;
+}
+
+static bool shardedWrite(void *state, int page) {
+    Shard *shard = shardOf((ShardedLru *)state, page);
+    pthread_mutex_lock(&shard->lock);
+    bool hit = lruPolicy.write(shard->state, page);
+    pthread_mutex_unlock(&shard->lock);
+    return hit;
+}
+
+const PolicyOps shardedLruPolicy = {
+    "LRU-SHARD", shardedCreate, shardedDestroy, shardedAccess, shardedEvict, shardedStats, shardedPrint,
+    shardedSave, shardedRestore, NULL, shardedPrefetch, shardedWrite
+};
+
+#ifndef POLICY_LIBRARY
+#include <time.h>
+#include <unistd.h>
+
+#include "trace.h"
+
+// Traza de la que los hilos toman lotes consecutivos
+typedef struct TraceFeed {
+    TraceReader *trace;         // Lector único de la traza
+    pthread_mutex_t lock;       // Protege el cursor del lector
+} TraceFeed;
+
+// Trabajo de un hilo: los lotes que vaya tomando de la traza compartida
+typedef struct Worker {
+    ShardedLru *sharded;        // LRU fragmentado compartido
+    TraceFeed *feed;            // Traza compartida
+    bool ok;                    // El hilo recorrió su parte sin errores
+} Worker;
+
+/*
+ * Función: replayWorker
+ * Descripción: Hilo de la simulación: toma el siguiente lote de la traza con el cerrojo y, ya fuera de
+ *              él, lo referencia sobre el LRU fragmentado, hasta agotar la traza.
+ * Parámetros:
+ *  - arg: Puntero a Worker.
+ * Retorna: NULL.
+ */
+static void* replayWorker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    worker->ok = pages != NULL;
+    while (worker->ok) {
+        pthread_mutex_lock(&worker->feed->lock);
+        size_t count = readPages(worker->feed->trace, pages, TRACE_BATCH_SIZE);
+        pthread_mutex_unlock(&worker->feed->lock);
+        if (count == 0) {
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            accessShard(worker->sharded, pages[i]);
+        }
+    }
+    free(pages);
+    return NULL;
+}
+
+/*
+ * Función: replayGlobal
+ * Descripción: Simula LRU global (una sola lista) sobre la traza, como referencia, releyéndola desde el
+ *              principio con un lector propio.
+ * Parámetros:
+ *  - tracePath: Ruta de la traza.
+ *  - numFrames: Frames de la memoria.
+ *  - stats: Recibe los contadores.
+ * Retorna: true si la simulación terminó sin errores.
+ */
+static bool replayGlobal(const char *tracePath, int numFrames, SimStats *stats) {
+    TraceReader *cursor = openTrace(tracePath);
+    void *state = lruPolicy.create(numFrames);
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    bool ok = cursor != NULL && state != NULL && pages != NULL;
+    size_t count;
+    while (ok && (count = readPages(cursor, pages, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            lruPolicy.access(state, pages[i]);
+        }
+    }
+    if (ok) {
+        ok = !traceFailed(cursor);
+        *stats = *lruPolicy.stats(state);
+    }
+    free(pages);
+    if (state != NULL) {
+        lruPolicy.destroy(state);
+    }
+    if (cursor != NULL) {
+        closeTrace(cursor);
+    }
+    return ok;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: SHARDED-LRU [-j hilos] [-s fragmentos] [-q] -t traza numFrames
+ *              Los hilos se reparten los lotes de la traza, que se decodifica una sola vez, y comparten
+ *              los fragmentos; la referencia de LRU global vuelve a leer la traza, así que no puede
+ *              venir de la entrada estándar.
+ */
+int main(int argc, char *argv[]) {
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int numShards = SHARDED_DEFAULT_SHARDS;
+    const char *tracePath = NULL;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:s:qt:")) != -1) {
+        if (opt == 'j') {
+            numThreads = parseCount(optarg, INT_MAX);
+        } else if (opt == 's') {
+            numShards = (int)parseCount(optarg, INT_MAX);
+        } else if (opt == 'q') {
+            quiet = true;
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            numThreads = 0;
+        }
+    }
+    int numFrames = optind < argc ? (int)parseCount(argv[optind], INT_MAX) : 0;
+    if (numThreads <= 0 || numShards <= 0 || tracePath == NULL || strcmp(tracePath, "-") == 0 || numFrames <= 0) {
+        fprintf(stderr, "Uso: %s [-j hilos] [-s fragmentos] [-q] -t traza numFrames\n", argv[0]);
+        return 1;
+    }
+
+    TraceFeed feed = { openTrace(tracePath), PTHREAD_MUTEX_INITIALIZER };
+    if (feed.trace == NULL) {
+        return 1;
+    }
+    ShardedLru *sharded = createShardedLru(numFrames, numShards);
+    Worker *workers = (Worker *)calloc((size_t)numThreads, sizeof(Worker));
+    pthread_t *threads = (pthread_t *)malloc((size_t)numThreads * sizeof(pthread_t));
+    if (sharded == NULL || workers == NULL || threads == NULL) {
+        fprintf(stderr, "No hay memoria para %d frames y %ld hilos\n", numFrames, numThreads);
+        free(threads);
+        free(workers);
+        if (sharded != NULL) {
+            destroyShardedLru(sharded);
+        }
+        closeTrace(feed.trace);
+        return 1;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long started = 0;
+    for (; started < numThreads; started++) {
+        workers[started] = (Worker){ sharded, &feed, false };
+        if (pthread_create(&threads[started], NULL, replayWorker, &workers[started]) != 0) {
+            break;
+        }
+    }
+    for (long t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+
+    bool ok = started == numThreads && !traceFailed(feed.trace);
+    for (long t = 0; t < started; t++) {
+        ok = ok && workers[t].ok;
+    }
+    SimStats global;
+    ok = ok && replayGlobal(tracePath, numFrames, &global);
+    if (!ok) {
+        fprintf(stderr, "La simulación fragmentada falló\n");
+    } else {
+        if (!quiet) {
+            shardedPrint(sharded);
+        }
+        const SimStats *total = sumStats(sharded);
+        printStats(shardedLruPolicy.name, numFrames, total);
+        printStats(lruPolicy.name, numFrames, &global);
+        printf("Divergencia: %d fragmentos, tasa_aciertos %+.6f respecto a LRU global (%+lld aciertos)\n",
+               sharded->numShards, hitRatio(total) - hitRatio(&global),
+               (long long)total->hits - (long long)global.hits);
+        fprintf(stderr, "%ld hilos: %.3f s, %.0f accesos/s\n", started, seconds,
+                seconds > 0.0 ? (double)total->accesses / seconds : 0.0);
+    }
+
+    free(threads);
+    free(workers);
+    destroyShardedLru(sharded);
+    closeTrace(feed.trace);
+    return ok ? 0 : 1;
+}
+#endif
@@ -0,0 +1,913 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Memoria física compartida por varios procesos (inquilinos). La traza etiqueta cada referencia con su
+ * proceso (páginas "proceso:página", ver tagPage en trace.h) y cada proceso tiene su propia tabla de
+ * páginas: un índice hash página -> frame que crece con él. Los frames salen de un único pool común y
+ * el reemplazo es LRU en uno de dos modos:
+ *  - Global (-g): una sola lista LRU para todos los frames; un proceso que falla desaloja la página
+ *    menos usada de cualquier proceso, como el reclamo de páginas de un núcleo sin límites por proceso.
+ *  - Repartido (por defecto): cada proceso tiene una cuota de frames y su propia lista LRU, y solo
+ *    desaloja páginas suyas. Al principio la memoria se reparte a partes iguales entre los procesos que
+ *    aparecen en la traza.
+ *
+ * En el modo repartido las cuotas se rebalancean cada -b N referencias según la curva de tasa de fallos
+ * de cada proceso. Un analizador de distancias de pila por proceso (stackdist.h) da, para cada tamaño,
+ * los aciertos que tendría LRU; la memoria se divide en TENANT_UNITS unidades, o UNITS_PER_TENANT por
+ * proceso si son más (sin bajar de un frame por unidad), y se asignan una a una al proceso que más
+ * aciertos gana por unidad, mirando varios pasos por delante para cruzar las mesetas de las curvas no
+ * convexas (reparto por utilidad, UCP). Los aciertos de cada periodo se suman a la mitad
+ * de los acumulados, como el envejecimiento de LFU-AGE, para que las cuotas sigan los cambios de fase.
+ * Cada proceso conserva al menos una unidad. Un proceso que pierde frames desaloja sus páginas menos
+ * usadas hasta su nueva cuota y los que ganan los reciben en su lista libre.
+ *
+ * Sin más interacción que el rebalanceo, el modo repartido se simula en paralelo: el hilo principal
+ * decodifica la traza una sola vez, en bloques que comparten todos los hilos (con doble búfer, para
+ * decodificar el siguiente mientras se simula el actual), y cada hilo solo simula de cada bloque los
+ * procesos que le tocan (proceso % hilos). Un bloque termina en el lote en que toca rebalancear, y el
+ * hilo principal rebalancea cuando todos lo han simulado; como las cuotas solo cambian en esos puntos,
+ * el resultado no depende del número de hilos. El main simula después LRU global sobre la misma traza y
+ * muestra la diferencia.
+ *
+ * Compilación: gcc -O2 -pthread TENANT-LRU.c stackdist.c trace.c stats.c -o TENANT-LRU
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "trace.h"
+#include "stats.h"
+#include "stackdist.h"
+
+#define MAX_TENANTS 1024            // Procesos distintos como máximo (números 0..MAX_TENANTS-1)
+#define TENANT_UNITS 64             // Unidades mínimas en que se reparte la memoria al rebalancear
+#define UNITS_PER_TENANT 4          // Unidades por proceso con muchos procesos, para que haya cuotas que mover
+#define REBALANCE_FACTOR 10         // Por defecto se rebalancea cada REBALANCE_FACTOR * numFrames referencias
+#define MIN_TENANT_BUCKETS 16       // Cubetas iniciales de la tabla de páginas de un proceso
+#define NO_INDEX UINT32_MAX         // Índice nulo en los enlaces entre frames
+#define EMPTY_PAGE -1               // Página de los frames libres
+#define CACHE_LINE 64               // Alineación de cada proceso, para que los hilos no compartan línea
+#define TENANT_CHUNK (16 * TRACE_BATCH_SIZE)  // Referencias por bloque decodificado que comparten los hilos
+
+// Frame del pool común
+typedef struct Frame {
+    int page;           // Página del proceso dueño (EMPTY_PAGE si está libre)
+    int tenant;         // Proceso dueño
+    uint32_t prev;      // Frame anterior (más reciente) en su lista LRU
+    uint32_t next;      // Frame siguiente en su lista LRU, o en la lista libre
+    uint32_t hashNext;  // Siguiente frame en la misma cubeta de la tabla de páginas
+} Frame;
+
+// Lista LRU de frames, de la más reciente (head) a la menos reciente (tail)
+typedef struct LruList {
+    uint32_t head;
+    uint32_t tail;
+} LruList;
+
+// Proceso: tabla de páginas, contadores y, en el modo repartido, su parte de la memoria
+typedef struct Tenant {
+    _Alignas(CACHE_LINE) uint32_t *buckets;    // Tabla de páginas: cubetas del índice página -> frame
+    uint32_t numBuckets;    // Número de cubetas (potencia de 2; 0 si el proceso no aparece en la traza)
+    int resident;           // Frames ocupados con páginas del proceso
+    int quota;              // Frames asignados (modo repartido)
+    LruList lru;            // Lista LRU de sus frames (modo repartido)
+    uint32_t freeFrames;    // Frames asignados y todavía vacíos, enlazados por next (modo repartido)
+    int numFree;            // Frames en freeFrames
+    StackDistance *mrc;     // Distancias de pila de sus referencias (si se rebalancea)
+    uint64_t *lastHits;     // Aciertos acumulados en cada tamaño en el último rebalanceo
+    double *utility;        // Aciertos por tamaño, con los periodos anteriores a la mitad
+    bool failed;            // El analizador se quedó sin memoria
+    SimStats stats;         // Contadores del proceso (los desalojos son de páginas suyas)
+} Tenant;
+
+// Memoria física compartida
+typedef struct TenantPool {
+    Frame *frames;          // Pool común de capacity frames
+    int capacity;           // Frames de la memoria
+    Tenant *tenants;        // Procesos 0..numTenants-1
+    int numTenants;         // 1 + el mayor número de proceso de la traza
+    bool partitioned;       // Reemplazo repartido por cuotas (false: LRU global)
+    LruList lru;            // Lista LRU de todos los frames (modo global)
+    uint32_t freeFrames;    // Frames libres sin asignar a ningún proceso, enlazados por next
+    int units;              // Unidades del reparto (0 si no se rebalancea)
+    int64_t *unitSizes;     // unitSizes[k]: frames de k unidades, k = 0..units
+    uint64_t rebalances;    // Rebalanceos realizados
+} TenantPool;
+
+/*
+ * Función: hashPage
+ * Descripción: Calcula la cubeta de la tabla de páginas de un proceso que corresponde a una página.
+ * Parámetros:
+ *  - tenant: Proceso.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static uint32_t hashPage(const Tenant *tenant, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return h & (tenant->numBuckets - 1);
+}
+
+/*
+ * Funciones: hashFrame, unhashFrame
+ * Descripción: Registran un frame en la tabla de páginas de su proceso y lo quitan de ella.
+ */
+static void hashFrame(TenantPool *pool, uint32_t index) {
+    Tenant *tenant = &pool->tenants[pool->frames[index].tenant];
+    uint32_t bucket = hashPage(tenant, pool->frames[index].page);
+    pool->frames[index].hashNext = tenant->buckets[bucket];
+    tenant->buckets[bucket] = index;
+}
+
+static void unhashFrame(TenantPool *pool, uint32_t index) {
+    Tenant *tenant = &pool->tenants[pool->frames[index].tenant];
+    uint32_t *link = &tenant->buckets[hashPage(tenant, pool->frames[index].page)];
+    while (*link != index) {
+        link = &pool->frames[*link].hashNext;
+    }
+    *link = pool->frames[index].hashNext;
+}
+
+/*
+ * Función: growTable
+ * Descripción: Duplica las cubetas de la tabla de páginas de un proceso y redistribuye sus frames. Si no
+ *              hay memoria la tabla se queda como estaba, con cadenas más largas.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - tenant: Proceso.
+ */
+static void growTable(TenantPool *pool, Tenant *tenant) {
+    uint32_t oldBuckets = tenant->numBuckets;
+    uint32_t *buckets = (uint32_t *)malloc((size_t)oldBuckets * 2 * sizeof(uint32_t));
+    if (buckets == NULL) {
+        return;
+    }
+    uint32_t *old = tenant->buckets;
+    tenant->buckets = buckets;
+    tenant->numBuckets = oldBuckets * 2;
+    for (uint32_t i = 0; i < tenant->numBuckets; i++) {
+        buckets[i] = NO_INDEX;
+    }
+    for (uint32_t b = 0; b < oldBuckets; b++) {
+        uint32_t index = old[b];
+        while (index != NO_INDEX) {
+            uint32_t next = pool->frames[index].hashNext;
+            hashFrame(pool, index);
+            index = next;
+        }
+    }
+    free(old);
+}
+
+/*
+ * Función: findFrame
+ * Descripción: Busca una página en la tabla de páginas de un proceso.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - tenant: Proceso.
+ *  - page: Número de la página.
+ * Retorna: Índice del frame, o NO_INDEX si la página no está en memoria.
+ */
+static uint32_t findFrame(const TenantPool *pool, const Tenant *tenant, int page) {
+    uint32_t index = tenant->buckets[hashPage(tenant, page)];
+    while (index != NO_INDEX && pool->frames[index].page != page) {
+        index = pool->frames[index].hashNext;
+    }
+    return index;
+}
+
+/*
+ * Funciones: pushFront, unlinkFrame
+ * Descripción: Ponen un frame al frente de una lista LRU y lo sacan de ella.
+ */
+static void pushFront(TenantPool *pool, LruList *list, uint32_t index) {
+    Frame *frame = &pool->frames[index];
+    frame->prev = NO_INDEX;
+    frame->next = list->head;
+    if (list->head != NO_INDEX) {
+        pool->frames[list->head].prev = index;
+    } else {
+        list->tail = index;
+    }
+    list->head = index;
+}
+
+static void unlinkFrame(TenantPool *pool, LruList *list, uint32_t index) {
+    Frame *frame = &pool->frames[index];
+    if (frame->prev != NO_INDEX) {
+        pool->frames[frame->prev].next = frame->next;
+    } else {
+        list->head = frame->next;
+    }
+    if (frame->next != NO_INDEX) {
+        pool->frames[frame->next].prev = frame->prev;
+    } else {
+        list->tail = frame->prev;
+    }
+}
+
+/*
+ * Función: evictTail
+ * Descripción: Desaloja el frame menos reciente de una lista LRU y lo quita de la tabla de páginas de su
+ *              dueño, que cuenta el desalojo.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - list: Lista LRU, no vacía.
+ * Retorna: Índice del frame liberado.
+ */
+static uint32_t evictTail(TenantPool *pool, LruList *list) {
+    uint32_t index = list->tail;
+    Tenant *owner = &pool->tenants[pool->frames[index].tenant];
+    unlinkFrame(pool, list, index);
+    unhashFrame(pool, index);
+    pool->frames[index].page = EMPTY_PAGE;
+    owner->resident--;
+    owner->stats.evictions++;
+    return index;
+}
+
+/*
+ * Función: takeFrame
+ * Descripción: Consigue un frame para un fallo de un proceso: uno libre (del pool en el modo global, de
+ *              su cuota en el repartido) o, si no queda ninguno, el de la víctima LRU global o del proceso.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - tenant: Proceso que falla.
+ * Retorna: Índice del frame, ya fuera de todas las listas.
+ */
+static uint32_t takeFrame(TenantPool *pool, Tenant *tenant) {
+    uint32_t *freeList = pool->partitioned ? &tenant->freeFrames : &pool->freeFrames;
+    if (*freeList != NO_INDEX) {
+        uint32_t index = *freeList;
+        *freeList = pool->frames[index].next;
+        tenant->numFree -= pool->partitioned;
+        return index;
+    }
+    return evictTail(pool, pool->partitioned ? &tenant->lru : &pool->lru);
+}
+
+/*
+ * Función: accessPage
+ * Descripción: Referencia una página de un proceso con reemplazo LRU.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - tenantId: Proceso que hace la referencia.
+ *  - page: Página del proceso.
+ * Retorna: true si fue un acierto.
+ */
+static bool accessPage(TenantPool *pool, int tenantId, int page) {
+    Tenant *tenant = &pool->tenants[tenantId];
+    LruList *list = pool->partitioned ? &tenant->lru : &pool->lru;
+    tenant->stats.accesses++;
+    if (tenant->mrc != NULL && recordAccess(tenant->mrc, page) < 0) {
+        tenant->failed = true;
+    }
+    uint32_t index = findFrame(pool, tenant, page);
+    if (index != NO_INDEX) {
+        tenant->stats.hits++;
+        if (list->head != index) {
+            unlinkFrame(pool, list, index);
+            pushFront(pool, list, index);
+        }
+        return true;
+    }
+    tenant->stats.misses++;
+
+    index = takeFrame(pool, tenant);
+    pool->frames[index].page = page;
+    pool->frames[index].tenant = tenantId;
+    tenant->resident++;
+    if ((uint32_t)tenant->resident > tenant->numBuckets / 2) {
+        growTable(pool, tenant);  // Al menos dos cubetas por frame, como en FIFO-LRU.c
+    }
+    hashFrame(pool, index);
+    pushFront(pool, list, index);
+    return false;
+}
+
+/*
+ * Función: applyUnits
+ * Descripción: Fija las cuotas del modo repartido a partir de las unidades de cada proceso (la suma de
+ *              unidades es pool->units o, sin rebalanceo, el número de unidades indicado). Los procesos
+ *              que pierden frames devuelven primero los vacíos y después desalojan sus páginas menos
+ *              usadas; los que ganan reciben los liberados.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ *  - units: Unidades de cada proceso.
+ *  - totalUnits: Suma de las unidades.
+ */
+static void applyUnits(TenantPool *pool, const int *units, int totalUnits) {
+    int64_t assigned = 0;
+    for (int t = 0; t < pool->numTenants; t++) {
+        // Redondeo acumulado: las cuotas suman exactamente la capacidad
+        int64_t start = assigned * pool->capacity / totalUnits;
+        assigned += units[t];
+        pool->tenants[t].quota = (int)(assigned * pool->capacity / totalUnits - start);
+    }
+    for (int t = 0; t < pool->numTenants; t++) {
+        Tenant *tenant = &pool->tenants[t];
+        while (tenant->resident + tenant->numFree > tenant->quota) {
+            uint32_t index;
+            if (tenant->freeFrames != NO_INDEX) {
+                index = tenant->freeFrames;
+                tenant->freeFrames = pool->frames[index].next;
+                tenant->numFree--;
+            } else {
+                index = evictTail(pool, &tenant->lru);
+            }
+            pool->frames[index].next = pool->freeFrames;
+            pool->freeFrames = index;
+        }
+    }
+    for (int t = 0; t < pool->numTenants; t++) {
+        Tenant *tenant = &pool->tenants[t];
+        while (tenant->resident + tenant->numFree < tenant->quota) {
+            uint32_t index = pool->freeFrames;
+            pool->freeFrames = pool->frames[index].next;
+            pool->frames[index].next = tenant->freeFrames;
+            tenant->freeFrames = index;
+            tenant->numFree++;
+        }
+    }
+}
+
+/*
+ * Función: rebalance
+ * Descripción: Recalcula las cuotas con la curva de aciertos de cada proceso (ver la descripción del
+ *              archivo) y las aplica.
+ * Parámetros:
+ *  - pool: Memoria compartida, con rebalanceo.
+ */
+static void rebalance(TenantPool *pool) {
+    int totalUnits = pool->units;
+    int units[MAX_TENANTS];
+    int remaining = totalUnits;
+    uint64_t hits[UNITS_PER_TENANT * MAX_TENANTS + 1];
+    double rates[MAX_TENANTS];  // Mejor tasa de cada proceso y unidades con que la alcanza
+    int steps[MAX_TENANTS];
+    for (int t = 0; t < pool->numTenants; t++) {
+        Tenant *tenant = &pool->tenants[t];
+        units[t] = tenant->numBuckets > 0;  // Una unidad como mínimo para cada proceso de la traza
+        remaining -= units[t];
+        if (units[t] == 0) {
+            continue;
+        }
+        hitsAtSizes(tenant->mrc, pool->unitSizes, hits, (size_t)totalUnits + 1);
+        for (int k = 0; k <= totalUnits; k++) {
+            tenant->utility[k] = tenant->utility[k] / 2.0 + (double)(hits[k] - tenant->lastHits[k]);
+            tenant->lastHits[k] = hits[k];
+        }
+    }
+
+    // Reparto por utilidad con anticipación: cada vez gana el proceso con más aciertos por unidad añadida.
+    // La mejor tasa de un proceso solo cambia si gana o si ya no quedan las unidades con que la alcanzaba,
+    // así que las demás se reutilizan de una vuelta a otra (steps[t] = 0: por calcular).
+    for (int t = 0; t < pool->numTenants; t++) {
+        steps[t] = 0;
+    }
+    while (remaining > 0) {
+        int best = -1;
+        for (int t = 0; t < pool->numTenants; t++) {
+            if (units[t] == 0) {
+                continue;
+            }
+            if (steps[t] == 0 || steps[t] > remaining) {
+                const double *utility = pool->tenants[t].utility;
+                rates[t] = 0.0;
+                steps[t] = 1;  // Sin mejora con ninguna cantidad, ni tampoco con menos unidades libres
+                for (int k = 1; k <= remaining; k++) {
+                    double rate = (utility[units[t] + k] - utility[units[t]]) / k;
+                    if (rate > rates[t]) {
+                        rates[t] = rate;
+                        steps[t] = k;
+                    }
+                }
+            }
+            if (rates[t] > 0.0 && (best < 0 || rates[t] > rates[best])) {
+                best = t;
+            }
+        }
+        if (best < 0) {
+            break;  // Ninguna curva mejora con más memoria
+        }
+        units[best] += steps[best];
+        remaining -= steps[best];
+        steps[best] = 0;
+    }
+    for (int t = 0; remaining > 0; t = (t + 1) % pool->numTenants) {
+        if (units[t] > 0) {
+            units[t]++;  // La memoria que no aprovecha nadie se reparte por turnos
+            remaining--;
+        }
+    }
+    applyUnits(pool, units, totalUnits);
+    pool->rebalances++;
+}
+
+/*
+ * Función: destroyTenantPool
+ * Descripción: Libera la memoria compartida, las tablas de páginas y los analizadores de los procesos.
+ * Parámetros:
+ *  - pool: Memoria compartida.
+ */
+static void destroyTenantPool(TenantPool *pool) {
+    for (int t = 0; t < pool->numTenants && pool->tenants != NULL; t++) {
+        Tenant *tenant = &pool->tenants[t];
+        free(tenant->buckets);
+        free(tenant->lastHits);
+        free(tenant->utility);
+        if (tenant->mrc != NULL) {
+            destroyStackDistance(tenant->mrc);
+        }
+    }
+    free(pool->tenants);
+    free(pool->frames);
+    free(pool->unitSizes);
+    free(pool);
+}
+
+/*
+ * Función: createTenantPool
+ * Descripción: Crea la memoria compartida con todos los frames libres y, en el modo repartido, la reparte
+ *              a partes iguales entre los procesos que aparecen en la traza.
+ * Parámetros:
+ *  - capacity: Frames de la memoria.
+ *  - references: Referencias de cada proceso en la traza (los procesos sin ninguna no reciben memoria).
+ *  - numTenants: 1 + el mayor número de proceso de la traza.
+ *  - partitioned: true para el reemplazo repartido por cuotas.
+ *  - rebalancing: true para rebalancear las cuotas según las curvas de fallos (solo modo repartido).
+ * Retorna: Puntero a la memoria creada, o NULL si no hay memoria.
+ */
+static TenantPool* createTenantPool(int capacity, const uint64_t *references, int numTenants, bool partitioned,
+                                    bool rebalancing) {
+    TenantPool *pool = (TenantPool *)calloc(1, sizeof(TenantPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->capacity = capacity;
+    pool->numTenants = numTenants;
+    pool->partitioned = partitioned;
+    pool->lru = (LruList){ NO_INDEX, NO_INDEX };
+    pool->frames = (Frame *)malloc((size_t)capacity * sizeof(Frame));
+    pool->tenants = (Tenant *)aligned_alloc(CACHE_LINE, (size_t)numTenants * sizeof(Tenant));
+    if (pool->frames == NULL || pool->tenants == NULL) {
+        free(pool->tenants);
+        pool->tenants = NULL;
+        destroyTenantPool(pool);
+        return NULL;
+    }
+    memset(pool->tenants, 0, (size_t)numTenants * sizeof(Tenant));
+
+    int active = 0;
+    for (int t = 0; t < numTenants; t++) {
+        active += references[t] > 0;
+    }
+    // Al rebalancear, cada proceso conserva una unidad y las demás son las que se mueven entre ellos
+    int rebalanceUnits = active > TENANT_UNITS / UNITS_PER_TENANT ? UNITS_PER_TENANT * active : TENANT_UNITS;
+    pool->units = !partitioned ? 0 : !rebalancing ? active : capacity < rebalanceUnits ? capacity : rebalanceUnits;
+    bool ok = true;
+    if (pool->units > 0 && rebalancing) {
+        pool->unitSizes = (int64_t *)malloc(((size_t)pool->units + 1) * sizeof(int64_t));
+        ok = pool->unitSizes != NULL;
+        for (int k = 0; ok && k <= pool->units; k++) {
+            pool->unitSizes[k] = (int64_t)k * capacity / pool->units;
+        }
+    }
+    for (int t = 0; t < numTenants && ok; t++) {
+        Tenant *tenant = &pool->tenants[t];
+        tenant->lru = (LruList){ NO_INDEX, NO_INDEX };
+        tenant->freeFrames = NO_INDEX;
+        if (references[t] == 0) {
+            continue;
+        }
+        tenant->numBuckets = MIN_TENANT_BUCKETS;
+        tenant->buckets = (uint32_t *)malloc(MIN_TENANT_BUCKETS * sizeof(uint32_t));
+        ok = tenant->buckets != NULL;
+        for (uint32_t i = 0; ok && i < MIN_TENANT_BUCKETS; i++) {
+            tenant->buckets[i] = NO_INDEX;
+        }
+        if (ok && pool->unitSizes != NULL) {
+            tenant->mrc = createStackDistance();
+            tenant->lastHits = (uint64_t *)calloc((size_t)pool->units + 1, sizeof(uint64_t));
+            tenant->utility = (double *)calloc((size_t)pool->units + 1, sizeof(double));
+            ok = tenant->mrc != NULL && tenant->lastHits != NULL && tenant->utility != NULL;
+        }
+    }
+    if (!ok) {
+        destroyTenantPool(pool);
+        return NULL;
+    }
+
+    pool->freeFrames = NO_INDEX;
+    for (int i = capacity - 1; i >= 0; i--) {
+        pool->frames[i].page = EMPTY_PAGE;
+        pool->frames[i].next = pool->freeFrames;
+        pool->freeFrames = (uint32_t)i;
+    }
+    if (partitioned) {
+        // Reparto inicial a partes iguales; el resto de la división va a los primeros procesos
+        int units[MAX_TENANTS];
+        for (int t = 0, seen = 0; t < numTenants; t++) {
+            units[t] = 0;
+            if (references[t] > 0) {
+                units[t] = pool->units / active + (seen < pool->units % active);
+                seen++;
+            }
+        }
+        applyUnits(pool, units, pool->units);
+    }
+    return pool;
+}
+
+// Bloques decodificados de la traza que simulan todos los hilos
+typedef struct TraceFeed {
+    int64_t *chunks[2];         // Doble búfer: se decodifica un bloque mientras se simula el otro
+    size_t counts[2];           // Referencias de cada bloque
+    uint64_t published;         // Bloques publicados; el actual es chunks[(published - 1) % 2]
+    int pending;                // Hilos que aún no han simulado el bloque actual
+    bool finished;              // No se publicarán más bloques
+    pthread_mutex_t lock;       // Protege los campos anteriores salvo el contenido de los bloques
+    pthread_cond_t ready;       // Se publicó un bloque o se terminó la traza
+    pthread_cond_t done;        // Todos los hilos simularon el bloque actual
+} TraceFeed;
+
+// Trabajo de un hilo: los procesos con número congruente con el del hilo
+typedef struct Worker {
+    TenantPool *pool;           // Memoria compartida
+    TraceFeed *feed;            // Bloques de la traza
+    int index;                  // Número del hilo
+    int numWorkers;             // Total de hilos
+} Worker;
+
+/*
+ * Función: simulateChunk
+ * Descripción: Referencia las páginas de un bloque que pertenecen a los procesos del hilo.
+ * Parámetros:
+ *  - worker: Trabajo del hilo.
+ *  - pages: Páginas etiquetadas del bloque.
+ *  - count: Referencias del bloque.
+ */
+static void simulateChunk(const Worker *worker, const int64_t *pages, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int tenant = pageTenant(pages[i]);
+        if (tenant % worker->numWorkers == worker->index) {
+            accessPage(worker->pool, tenant, tenantPage(pages[i]));
+        }
+    }
+}
+
+/*
+ * Función: replayWorker
+ * Descripción: Hilo de la simulación: espera cada bloque que publica el hilo principal, lo simula y
+ *              avisa al terminar, hasta que no quedan bloques.
+ * Parámetros:
+ *  - arg: Puntero a Worker.
+ * Retorna: NULL.
+ */
+static void* replayWorker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    TraceFeed *feed = worker->feed;
+    uint64_t seen = 0;
+    pthread_mutex_lock(&feed->lock);
+    for (;;) {
+        while (feed->published == seen && !feed->finished) {
+            pthread_cond_wait(&feed->ready, &feed->lock);
+        }
+        if (feed->published == seen) {
+            break;
+        }
+        seen = feed->published;
+        const int64_t *pages = feed->chunks[(seen - 1) % 2];
+        size_t count = feed->counts[(seen - 1) % 2];
+        pthread_mutex_unlock(&feed->lock);
+        simulateChunk(worker, pages, count);
+        pthread_mutex_lock(&feed->lock);
+        if (--feed->pending == 0) {
+            pthread_cond_signal(&feed->done);
+        }
+    }
+    pthread_mutex_unlock(&feed->lock);
+    return NULL;
+}
+
+/*
+ * Función: readChunk
+ * Descripción: Decodifica lotes de la traza en un bloque hasta llenarlo, hasta el final del lote en que
+ *              se cruza un múltiplo de rebalanceEvery o hasta el final de la traza.
+ * Parámetros:
+ *  - trace: Traza abierta.
+ *  - chunk: Bloque destino (TENANT_CHUNK referencias).
+ *  - rebalanceEvery: Referencias entre rebalanceos (0 = cuotas fijas).
+ *  - position: Referencias ya decodificadas; se actualiza.
+ *  - rebalanceDue: Recibe true si hay que rebalancear después de simular el bloque.
+ * Retorna: Referencias del bloque (0 al final de la traza).
+ */
+static size_t readChunk(TraceReader *trace, int64_t *chunk, uint64_t rebalanceEvery, uint64_t *position,
+                        bool *rebalanceDue) {
+    size_t count = 0;
+    size_t n;
+    *rebalanceDue = false;
+    while (count + TRACE_BATCH_SIZE <= TENANT_CHUNK && (n = readRawPages(trace, chunk + count, TRACE_BATCH_SIZE)) > 0) {
+        uint64_t start = *position;
+        count += n;
+        *position += n;
+        if (rebalanceEvery > 0 && start / rebalanceEvery != *position / rebalanceEvery) {
+            *rebalanceDue = true;
+            break;
+        }
+    }
+    return count;
+}
+
+/*
+ * Función: scanTenants
+ * Descripción: Primera pasada sobre la traza: comprueba las etiquetas y cuenta las referencias de cada
+ *              proceso, de modo que la simulación ya no puede fallar a mitad (los hilos se esperan entre sí).
+ * Parámetros:
+ *  - trace: Traza recién abierta (se recorre entera).
+ *  - references: Recibe las referencias de cada proceso (MAX_TENANTS posiciones).
+ * Retorna: 1 + el mayor número de proceso, o 0 si la traza no es válida o está vacía.
+ */
+static int scanTenants(TraceReader *trace, uint64_t *references) {
+    int numTenants = 0;
+    int64_t pages[TRACE_BATCH_SIZE];
+    size_t count;
+    memset(references, 0, MAX_TENANTS * sizeof(uint64_t));
+    while ((count = readRawPages(trace, pages, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            if (pages[i] < 0 || pageTenant(pages[i]) >= MAX_TENANTS || tenantPage(pages[i]) < 0) {
+                fprintf(stderr, "traza: la página %lld no es \"proceso:página\" con proceso < %d\n",
+                        (long long)pages[i], MAX_TENANTS);
+                return 0;
+            }
+            int tenant = pageTenant(pages[i]);
+            references[tenant]++;
+            numTenants = tenant >= numTenants ? tenant + 1 : numTenants;
+        }
+    }
+    return traceFailed(trace) ? 0 : numTenants;
+}
+
+/*
+ * Función: simulate
+ * Descripción: Simula la traza completa sobre una memoria compartida. El hilo principal publica cada
+ *              bloque, decodifica el siguiente, simula su parte y, cuando todos los hilos terminan el
+ *              bloque, rebalancea si toca; un hilo que no se puede crear se ejecuta en el principal, así
+ *              que el resultado es el mismo.
+ * Parámetros:
+ *  - trace: Traza recién abierta (se recorre entera).
+ *  - pool: Memoria compartida recién creada.
+ *  - numThreads: Hilos (se usa uno solo en el modo global).
+ *  - rebalanceEvery: Referencias entre rebalanceos (0 = cuotas fijas).
+ * Retorna: Hilos usados, o 0 si no hay memoria para los bloques o la traza falla.
+ */
+static long simulate(TraceReader *trace, TenantPool *pool, long numThreads, uint64_t rebalanceEvery) {
+    if (!pool->partitioned || numThreads > pool->numTenants) {
+        numThreads = pool->partitioned ? pool->numTenants : 1;
+    }
+    TraceFeed feed = { { NULL, NULL }, { 0, 0 }, 0, 0, false, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+                       PTHREAD_COND_INITIALIZER };
+    feed.chunks[0] = (int64_t *)malloc(TENANT_CHUNK * sizeof(int64_t));
+    feed.chunks[1] = (int64_t *)malloc(TENANT_CHUNK * sizeof(int64_t));
+    Worker *workers = (Worker *)calloc((size_t)numThreads, sizeof(Worker));
+    pthread_t *threads = (pthread_t *)malloc((size_t)numThreads * sizeof(pthread_t));
+    bool *started = (bool *)calloc((size_t)numThreads, sizeof(bool));
+    bool ok = feed.chunks[0] != NULL && feed.chunks[1] != NULL && workers != NULL && threads != NULL &&
+              started != NULL;
+    int running = 0;
+    for (long t = 0; ok && t < numThreads; t++) {
+        workers[t] = (Worker){ pool, &feed, (int)t, (int)numThreads };
+        if (t > 0) {
+            started[t] = pthread_create(&threads[t], NULL, replayWorker, &workers[t]) == 0;
+            running += started[t];
+        }
+    }
+
+    uint64_t position = 0;
+    bool rebalanceDue = false;
+    size_t next = ok ? readChunk(trace, feed.chunks[0], rebalanceEvery, &position, &rebalanceDue) : 0;
+    while (next > 0) {
+        size_t count = next;
+        bool due = rebalanceDue;
+        pthread_mutex_lock(&feed.lock);
+        feed.counts[feed.published % 2] = count;
+        feed.published++;
+        feed.pending = running;
+        pthread_cond_broadcast(&feed.ready);
+        pthread_mutex_unlock(&feed.lock);
+
+        // Mientras los hilos simulan el bloque publicado se decodifica el siguiente en el otro búfer
+        const int64_t *current = feed.chunks[(feed.published - 1) % 2];
+        next = readChunk(trace, feed.chunks[feed.published % 2], rebalanceEvery, &position, &rebalanceDue);
+        for (long t = 0; t < numThreads; t++) {
+            if (!started[t]) {
+                simulateChunk(&workers[t], current, count);
+            }
+        }
+        pthread_mutex_lock(&feed.lock);
+        while (feed.pending > 0) {
+            pthread_cond_wait(&feed.done, &feed.lock);
+        }
+        pthread_mutex_unlock(&feed.lock);
+        if (due) {
+            rebalance(pool);
+        }
+    }
+
+    pthread_mutex_lock(&feed.lock);
+    feed.finished = true;
+    pthread_cond_broadcast(&feed.ready);
+    pthread_mutex_unlock(&feed.lock);
+    for (long t = 1; started != NULL && t < numThreads; t++) {
+        if (started[t]) {
+            pthread_join(threads[t], NULL);
+        }
+    }
+    free(feed.chunks[0]);
+    free(feed.chunks[1]);
+    free(workers);
+    free(threads);
+    free(started);
+    return ok && !traceFailed(trace) ? numThreads : 0;
+}
+
+/*
+ * Función: printTenants
+ * Descripción: Imprime los contadores de cada proceso (frames = los que tiene al terminar) y su suma.
+ * Parámetros:
+ *  - name: Nombre del modo simulado.
+ *  - pool: Memoria compartida.
+ *  - quiet: true para imprimir solo la suma.
+ *  - total: Recibe la suma de los contadores.
+ */
+static void printTenants(const char *name, const TenantPool *pool, bool quiet, SimStats *total) {
+    *total = (SimStats){0};
+    for (int t = 0; t < pool->numTenants; t++) {
+        const Tenant *tenant = &pool->tenants[t];
+        if (tenant->numBuckets == 0) {
+            continue;
+        }
+        addStats(total, &tenant->stats);
+        if (!quiet) {
+            char label[48];
+            snprintf(label, sizeof(label), "%s[%d]", name, t);
+            printStats(label, pool->partitioned ? tenant->quota : tenant->resident, &tenant->stats);
+        }
+    }
+    printStats(name, pool->capacity, total);
+}
+
+/*
+ * Función: parseCount
+ * Descripción: Interpreta un número de la línea de comandos como entero decimal de 0 a max, sin nada
+ *              detrás; si no lo es, lo informa por stderr.
+ * Parámetros:
+ *  - text: Texto del argumento.
+ *  - max: Valor máximo admitido.
+ * Retorna: El número, o -1 si no es válido.
+ */
+static long long parseCount(const char *text, long long max) {
+    char *end;
+    errno = 0;
+    long long value = strtoll(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || value < 0 || value > max) {
+        fprintf(stderr, "Número no válido: %s (debe ser un entero de 0 a %lld)\n", text, max);
+        return -1;
+    }
+    return value;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: TENANT-LRU [-g] [-b cadaN] [-j hilos] [-q] -t traza numFrames
+ *              Simula el modo repartido (cuotas fijas con -b 0) y LRU global sobre la traza y muestra la
+ *              diferencia; con -g solo el global. -q omite las líneas por proceso. La traza se recorre una
+ *              vez por pasada (recuento de procesos y cada simulación), así que no puede venir de stdin.
+ */
+int main(int argc, char *argv[]) {
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    bool globalOnly = false;
+    long long rebalanceEvery = -1;  // Por defecto REBALANCE_FACTOR * numFrames
+    const char *tracePath = NULL;
+    bool quiet = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "gb:j:qt:")) != -1) {
+        if (opt == 'g') {
+            globalOnly = true;
+        } else if (opt == 'b') {
+            rebalanceEvery = parseCount(optarg, LLONG_MAX);
+            if (rebalanceEvery < 0) {
+                return 1;  // -1 es el valor por defecto, no un -b válido
+            }
+        } else if (opt == 'j') {
+            numThreads = (long)parseCount(optarg, INT_MAX);
+        } else if (opt == 'q') {
+            quiet = true;
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            numThreads = 0;
+        }
+    }
+    int numFrames = optind < argc ? (int)parseCount(argv[optind], INT_MAX) : 0;
+    if (numThreads <= 0 || tracePath == NULL || strcmp(tracePath, "-") == 0 || numFrames <= 0) {
+        fprintf(stderr, "Uso: %s [-g] [-b cadaN] [-j hilos] [-q] -t traza numFrames\n", argv[0]);
+        return 1;
+    }
+    if (rebalanceEvery < 0) {
+        rebalanceEvery = (long long)REBALANCE_FACTOR * numFrames;
+    }
+
+    TraceReader *trace = openTrace(tracePath);
+    if (trace == NULL) {
+        return 1;
+    }
+    uint64_t references[MAX_TENANTS];
+    int numTenants = scanTenants(trace, references);
+    closeTrace(trace);
+    int active = 0;
+    for (int t = 0; t < numTenants; t++) {
+        active += references[t] > 0;
+    }
+    if (numTenants == 0 || (!globalOnly && numFrames < active)) {
+        if (numTenants > 0) {
+            fprintf(stderr, "El modo repartido necesita al menos un frame por proceso (%d)\n", active);
+        }
+        return 1;
+    }
+
+    bool ok = true;
+    SimStats partitionedTotal = {0};
+    if (!globalOnly) {
+        TenantPool *pool = createTenantPool(numFrames, references, numTenants, true, rebalanceEvery > 0);
+        if (pool != NULL && rebalanceEvery > 0 && pool->units <= active) {
+            fprintf(stderr, "Aviso: con %d frames y %d procesos cada uno solo tiene su frame mínimo; "
+                    "el rebalanceo no puede mover cuotas\n", numFrames, active);
+        }
+        trace = openTrace(tracePath);
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        long threads = pool != NULL && trace != NULL ? simulate(trace, pool, numThreads, (uint64_t)rebalanceEvery) : 0;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+        for (int t = 0; pool != NULL && t < numTenants; t++) {
+            ok = ok && !pool->tenants[t].failed;
+        }
+        ok = ok && threads > 0;
+        if (!ok && trace != NULL && !traceFailed(trace)) {
+            fprintf(stderr, "No hay memoria para simular %d frames y %d procesos\n", numFrames, active);
+        } else if (ok) {
+            printTenants("LRU-REPARTIDO", pool, quiet, &partitionedTotal);
+            if (rebalanceEvery > 0) {
+                printf("Rebalanceos: %llu (cada %lld referencias, %d unidades)\n",
+                       (unsigned long long)pool->rebalances, rebalanceEvery, pool->units);
+            } else {
+                printf("Cuotas fijas: %d procesos a partes iguales\n", active);
+            }
+            fprintf(stderr, "%ld hilos: %.3f s, %.0f accesos/s\n", threads, seconds,
+                    seconds > 0.0 ? (double)partitionedTotal.accesses / seconds : 0.0);
+        }
+        if (pool != NULL) {
+            destroyTenantPool(pool);
+        }
+        if (trace != NULL) {
+            closeTrace(trace);
+        }
+    }
+
+    if (ok) {
+        TenantPool *pool = createTenantPool(numFrames, references, numTenants, false, false);
+        trace = openTrace(tracePath);
+        ok = pool != NULL && trace != NULL && simulate(trace, pool, 1, 0) > 0;
+        if (!ok && trace != NULL && !traceFailed(trace)) {
+            fprintf(stderr, "No hay memoria para simular %d frames y %d procesos\n", numFrames, active);
+        } else if (ok) {
+            SimStats global;
+            printTenants("LRU-GLOBAL", pool, quiet, &global);
+            if (!globalOnly) {
+                printf("Diferencia LRU-REPARTIDO - LRU-GLOBAL: tasa_aciertos %+.6f (%+lld aciertos)\n",
+                       hitRatio(&partitionedTotal) - hitRatio(&global),
+                       (long long)partitionedTotal.hits - (long long)global.hits);
+            }
+        }
+        if (pool != NULL) {
+            destroyTenantPool(pool);
+        }
+        if (trace != NULL) {
+            closeTrace(trace);
+        }
+    }
+    return ok ? 0 : 1;
+}
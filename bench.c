@@ -0,0 +1,246 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Banco de pruebas de rendimiento de los algoritmos de reemplazo sobre las cargas sintéticas de
+ * workload.h. Cada combinación (política, carga, frames) se ejecuta en un proceso hijo propio, de modo
+ * que el pico de memoria residente que informa getrusage corresponde solo a esa simulación; dentro del
+ * hijo las referencias se generan por lotes fuera del tiempo medido y solo se cronometran las llamadas
+ * a access. La salida es CSV, una línea por combinación:
+ *
+ *   politica,carga,frames,accesos,ns_acceso,accesos_s,tasa_aciertos,rss_max_kb
+ *
+ * Como todas las políticas reciben la misma semilla, ven la misma secuencia de referencias y sus
+ * tasas de aciertos son directamente comparables entre ejecuciones y entre versiones del código.
+ *
+ * Compilación: gcc -O2 -march=native -pthread -DPOLICY_LIBRARY bench.c workload.c driver.c policies.c \
+ *              FIFO-LRU.c LRU-CLOCK.c framescan.c OPR-LFU.c MT-CLOCK.c SHARDED-LRU.c CAR-CLOCK.c OPT-BELADY.c \
+ *              timeseries.c checkpoint.c remap.c prefetch.c trace.c stats.c -lm -o bench
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "policy.h"
+#include "driver.h"
+#include "workload.h"
+#include "trace.h"
+
+#define MAX_WORKLOADS 16    // Cargas distintas en una ejecución (-w)
+#define BENCH_DEFAULT_POLICIES "LRU,CLOCK,LFU"
+#define BENCH_DEFAULT_WORKLOADS "zipf,uniform,seq,loop:5000,phase"
+#define BENCH_DEFAULT_FRAMES "1000:16000"
+#define BENCH_DEFAULT_ACCESSES 2000000
+#define BENCH_DEFAULT_PAGES 100000
+
+/*
+ * Función: parseWorkloads
+ * Descripción: Interpreta la lista de cargas separadas por comas.
+ * Parámetros:
+ *  - list: Lista indicada con -w.
+ *  - names: Recibe una copia de cada descripción (para la columna carga); se libera con free.
+ *  - specs: Recibe los parámetros de cada carga, con numPages y seed ya iniciados.
+ *  - base: Valores comunes de numPages y seed.
+ * Retorna: Número de cargas, o 0 si alguna no es válida.
+ */
+static int parseWorkloads(const char *list, char **names, WorkloadSpec *specs, const WorkloadSpec *base) {
+    char *copy = strdup(list);
+    int count = 0;
+    bool ok = copy != NULL;
+    for (char *token = ok ? strtok(copy, ",") : NULL; token != NULL && ok; token = strtok(NULL, ",")) {
+        if (count == MAX_WORKLOADS) {
+            ok = false;
+            break;
+        }
+        specs[count] = *base;
+        ok = parseWorkload(token, &specs[count]);
+        if (ok) {
+            names[count++] = strdup(token);
+        }
+    }
+    free(copy);
+    if (!ok) {
+        while (count > 0) {
+            free(names[--count]);
+        }
+    }
+    return count;
+}
+
+/*
+ * Función: elapsedNanoseconds
+ * Descripción: Calcula los nanosegundos entre dos instantes.
+ * Parámetros:
+ *  - start, end: Instantes (CLOCK_MONOTONIC).
+ * Retorna: Nanosegundos transcurridos.
+ */
+static double elapsedNanoseconds(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) * 1e9 + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Función: lookaheadWorkload
+ * Descripción: Entrega por adelantado la carga completa a una política que necesita conocer el futuro
+ *              (ops->lookahead), generándola con una copia de la carga: con la misma semilla produce
+ *              exactamente las referencias que se simularán después. No entra en el tiempo medido.
+ * Parámetros:
+ *  - ops: Política simulada.
+ *  - state: Estado recién creado de la política.
+ *  - spec: Parámetros de la carga.
+ *  - numAccesses: Referencias simuladas.
+ *  - pages: Búfer de lote.
+ * Retorna: true si la política aceptó la carga.
+ */
+static bool lookaheadWorkload(const PolicyOps *ops, void *state, const WorkloadSpec *spec, int64_t numAccesses,
+                              int *pages) {
+    Workload *workload = createWorkload(spec);
+    bool ok = workload != NULL;
+    for (int64_t done = 0; ok && done < numAccesses; ) {
+        size_t count = numAccesses - done < TRACE_BATCH_SIZE ? (size_t)(numAccesses - done) : TRACE_BATCH_SIZE;
+        generatePages(workload, pages, count);
+        ok = ops->lookahead(state, pages, count);
+        done += (int64_t)count;
+    }
+    ok = ok && ops->lookahead(state, NULL, 0);
+    if (workload != NULL) {
+        destroyWorkload(workload);
+    }
+    return ok;
+}
+
+/*
+ * Función: runBenchmark
+ * Descripción: Simula una combinación e imprime su línea de resultados. Se ejecuta en el proceso hijo.
+ * Parámetros:
+ *  - ops: Política simulada.
+ *  - name: Descripción de la carga.
+ *  - spec: Parámetros de la carga.
+ *  - numFrames: Frames de la memoria simulada.
+ *  - numAccesses: Referencias simuladas.
+ * Retorna: true si la simulación terminó sin errores.
+ */
+static bool runBenchmark(const PolicyOps *ops, const char *name, const WorkloadSpec *spec, int numFrames,
+                         int64_t numAccesses) {
+    Workload *workload = createWorkload(spec);
+    void *state = ops->create(numFrames);
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    bool ok = workload != NULL && state != NULL && pages != NULL;
+    if (ok && ops->lookahead != NULL) {
+        ok = lookaheadWorkload(ops, state, spec, numAccesses, pages);
+    }
+    if (ok) {
+        bool (*access)(void *, int) = ops->access;
+        double nanoseconds = 0;
+        for (int64_t done = 0; done < numAccesses; ) {
+            size_t count = numAccesses - done < TRACE_BATCH_SIZE ? (size_t)(numAccesses - done) : TRACE_BATCH_SIZE;
+            generatePages(workload, pages, count);
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            for (size_t i = 0; i < count; i++) {
+                access(state, pages[i]);
+            }
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            nanoseconds += elapsedNanoseconds(&start, &end);
+            done += (int64_t)count;
+        }
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        double perAccess = nanoseconds / (double)numAccesses;
+        printf("%s,%s,%d,%lld,%.2f,%.0f,%.6f,%ld\n", ops->name, name, numFrames, (long long)numAccesses,
+               perAccess, perAccess > 0 ? 1e9 / perAccess : 0.0, hitRatio(ops->stats(state)), usage.ru_maxrss);
+        fflush(stdout);
+    }
+    free(pages);
+    if (state != NULL) {
+        ops->destroy(state);
+    }
+    if (workload != NULL) {
+        destroyWorkload(workload);
+    }
+    return ok;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: bench [-p política[,política...]|all] [-w carga[,carga...]] [-f frames[,frames|inicio:fin...]]
+ *                         [-n accesos] [-u páginas] [-s semilla]
+ *              Las cargas son zipf[:sesgo], uniform, seq, loop[:páginas] y phase[:referencias] (ver workload.h);
+ *              -u fija el universo de páginas de zipf, uniform y phase, y el bucle de loop sin parámetro.
+ */
+int main(int argc, char *argv[]) {
+    const char *policyList = BENCH_DEFAULT_POLICIES;
+    const char *workloadList = BENCH_DEFAULT_WORKLOADS;
+    const char *frameList = BENCH_DEFAULT_FRAMES;
+    int64_t numAccesses = BENCH_DEFAULT_ACCESSES;
+    WorkloadSpec base = { WORKLOAD_ZIPF, BENCH_DEFAULT_PAGES, WORKLOAD_DEFAULT_SKEW, WORKLOAD_DEFAULT_PHASE, 1 };
+    bool ok = true;
+    int opt;
+    while ((opt = getopt(argc, argv, "p:w:f:n:u:s:")) != -1) {
+        if (opt == 'p') {
+            policyList = optarg;
+        } else if (opt == 'w') {
+            workloadList = optarg;
+        } else if (opt == 'f') {
+            frameList = optarg;
+        } else if (opt == 'n') {
+            numAccesses = atoll(optarg);
+        } else if (opt == 'u') {
+            base.numPages = atoi(optarg);
+        } else if (opt == 's') {
+            base.seed = strtoull(optarg, NULL, 10);
+        } else {
+            ok = false;
+        }
+    }
+
+    const PolicyOps *selected[MAX_POLICIES];
+    int numSelected = parsePolicies(policyList, allPolicies, numAllPolicies, selected);
+    int frameCounts[MAX_FRAME_COUNTS];
+    int numCounts = parseFrameCounts(frameList, frameCounts);
+    char *names[MAX_WORKLOADS];
+    WorkloadSpec specs[MAX_WORKLOADS];
+    int numWorkloads = base.numPages > 0 ? parseWorkloads(workloadList, names, specs, &base) : 0;
+    if (!ok || numSelected == 0 || numCounts == 0 || numWorkloads == 0 || numAccesses <= 0) {
+        fprintf(stderr, "Uso: %s [-p política[,política...]|all] [-w carga[,carga...]] "
+                        "[-f frames[,frames|inicio:fin...]] [-n accesos] [-u páginas] [-s semilla]\n"
+                        "Cargas: zipf[:sesgo], uniform, seq, loop[:páginas], phase[:referencias]\n", argv[0]);
+        for (int w = 0; w < numWorkloads; w++) {
+            free(names[w]);
+        }
+        return 1;
+    }
+
+    printf("politica,carga,frames,accesos,ns_acceso,accesos_s,tasa_aciertos,rss_max_kb\n");
+    fflush(stdout);  // Los hijos heredan el búfer de stdout: debe estar vacío antes de cada fork
+    for (int w = 0; w < numWorkloads; w++) {
+        for (int p = 0; p < numSelected; p++) {
+            for (int f = 0; f < numCounts; f++) {
+                pid_t child = fork();
+                if (child == 0) {
+                    bool done = runBenchmark(selected[p], names[w], &specs[w], frameCounts[f], numAccesses);
+                    _exit(done ? 0 : 1);
+                }
+                int status = 0;
+                if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFEXITED(status) ||
+                    WEXITSTATUS(status) != 0) {
+                    fprintf(stderr, "%s %s frames=%d: la prueba falló\n", selected[p]->name, names[w],
+                            frameCounts[f]);
+                    ok = false;
+                }
+            }
+        }
+    }
+    for (int w = 0; w < numWorkloads; w++) {
+        free(names[w]);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación de los checkpoints declarados en checkpoint.h. La escritura usa stdio sobre un archivo
+ * temporal que se renombra al terminar; la lectura proyecta el archivo con mmap y cada política copia sus
+ * bloques directamente desde la proyección.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "checkpoint.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifdef POLICY_INSTRUMENT
+#define CHECKPOINT_FLAGS 1u     // Opciones de compilación que cambian la disposición del estado
+#else
+#define CHECKPOINT_FLAGS 0u
+#endif
+
+/*
+ * Función: padding
+ * Descripción: Bytes de relleno que faltan para alinear un tamaño a 8.
+ */
+static size_t padding(size_t size) {
+    return (8 - size % 8) % 8;
+}
+
+bool saveBlock(FILE *out, const void *data, size_t size) {
+    static const unsigned char zeros[8] = {0};
+    uint64_t length = size;
+    return fwrite(&length, sizeof(length), 1, out) == 1 &&
+           (size == 0 || fwrite(data, size, 1, out) == 1) &&
+           fwrite(zeros, 1, padding(size), out) == padding(size);
+}
+
+bool loadBlock(PolicyImage *image, void *data, size_t size) {
+    uint64_t length;
+    if (image->size - image->offset < sizeof(length)) {
+        return false;
+    }
+    memcpy(&length, image->data + image->offset, sizeof(length));
+    if (length != size || image->size - image->offset - sizeof(length) < size + padding(size)) {
+        return false;
+    }
+    memcpy(data, image->data + image->offset + sizeof(length), size);
+    image->offset += sizeof(length) + size + padding(size);
+    return true;
+}
+
+/*
+ * Función: writePolicy
+ * Descripción: Escribe el nombre, el tamaño y la imagen de una política; el tamaño se completa al final.
+ * Parámetros:
+ *  - out: Archivo del checkpoint.
+ *  - policy: Política que se guarda.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+static bool writePolicy(FILE *out, const Policy *policy) {
+    char name[CHECKPOINT_NAME_SIZE] = {0};
+    strncpy(name, policy->ops->name, sizeof(name) - 1);
+    uint64_t size = 0;
+    if (fwrite(name, sizeof(name), 1, out) != 1) {
+        return false;
+    }
+    long sizeAt = ftell(out);
+    if (sizeAt < 0 || fwrite(&size, sizeof(size), 1, out) != 1 || !policy->ops->save(policy->state, out)) {
+        return false;
+    }
+    long end = ftell(out);
+    size = (uint64_t)(end - sizeAt) - sizeof(size);
+    return end >= 0 && fseek(out, sizeAt, SEEK_SET) == 0 && fwrite(&size, sizeof(size), 1, out) == 1 &&
+           fseek(out, end, SEEK_SET) == 0;
+}
+
+bool saveCheckpoint(const char *path, const Policy *policies, int numPolicies, uint64_t references) {
+    for (int p = 0; p < numPolicies; p++) {
+        if (policies[p].ops->save == NULL) {
+            fprintf(stderr, "La política %s no admite checkpoints\n", policies[p].ops->name);
+            return false;
+        }
+    }
+
+    size_t length = strlen(path);
+    char *temporary = (char *)malloc(length + 5);
+    if (temporary == NULL) {
+        fprintf(stderr, "No hay memoria para el checkpoint\n");
+        return false;
+    }
+    memcpy(temporary, path, length);
+    memcpy(temporary + length, ".tmp", 5);
+    FILE *out = fopen(temporary, "wb");
+    if (out == NULL) {
+        perror(temporary);
+        free(temporary);
+        return false;
+    }
+
+    unsigned char header[CHECKPOINT_HEADER_SIZE] = {0};
+    uint32_t version = CHECKPOINT_VERSION;
+    uint32_t count = (uint32_t)numPolicies;
+    uint32_t numFrames = (uint32_t)policies[0].numFrames;
+    uint32_t flags = CHECKPOINT_FLAGS;
+    memcpy(header, CHECKPOINT_MAGIC, 4);
+    memcpy(header + 4, &version, sizeof(version));
+    memcpy(header + 8, &count, sizeof(count));
+    memcpy(header + 12, &numFrames, sizeof(numFrames));
+    memcpy(header + 16, &references, sizeof(references));
+    memcpy(header + 24, &flags, sizeof(flags));
+    bool ok = fwrite(header, sizeof(header), 1, out) == 1;
+    for (int p = 0; p < numPolicies && ok; p++) {
+        ok = writePolicy(out, &policies[p]);
+    }
+    ok = fclose(out) == 0 && ok;
+    if (ok && rename(temporary, path) != 0) {
+        perror(path);
+        ok = false;
+    } else if (!ok) {
+        fprintf(stderr, "%s: no se pudo escribir el checkpoint\n", temporary);
+        remove(temporary);
+    }
+    free(temporary);
+    return ok;
+}
+
+/*
+ * Función: findOps
+ * Descripción: Busca entre los algoritmos disponibles el de un nombre exacto.
+ * Retorna: Tabla de operaciones, o NULL si no está.
+ */
+static const PolicyOps* findOps(const char *name, const PolicyOps *const *available, int numAvailable) {
+    for (int i = 0; i < numAvailable; i++) {
+        if (strcmp(available[i]->name, name) == 0) {
+            return available[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Función: restorePolicies
+ * Descripción: Recrea las políticas de un checkpoint ya proyectado y validado en su cabecera.
+ * Parámetros:
+ *  - map: Proyección del checkpoint.
+ *  - mapSize: Bytes de la proyección.
+ *  - available, numAvailable: Algoritmos disponibles.
+ *  - policies: Recibe las políticas restauradas.
+ *  - count: Número de políticas del checkpoint.
+ *  - numFrames: Frames de todas ellas.
+ * Retorna: true si todas se restauraron; si no, las ya creadas se liberan.
+ */
+static bool restorePolicies(const unsigned char *map, size_t mapSize, const PolicyOps *const *available,
+                           int numAvailable, Policy *policies, int count, int numFrames) {
+    size_t offset = CHECKPOINT_HEADER_SIZE;
+    for (int p = 0; p < count; p++) {
+        char name[CHECKPOINT_NAME_SIZE];
+        uint64_t size;
+        if (mapSize - offset < sizeof(name) + sizeof(size)) {
+            fprintf(stderr, "Checkpoint truncado\n");
+            break;
+        }
+        memcpy(name, map + offset, sizeof(name));
+        name[sizeof(name) - 1] = '\0';
+        memcpy(&size, map + offset + sizeof(name), sizeof(size));
+        offset += sizeof(name) + sizeof(size);
+
+        const PolicyOps *ops = findOps(name, available, numAvailable);
+        if (ops == NULL || ops->restore == NULL) {
+            fprintf(stderr, "La política %s del checkpoint no está disponible o no admite checkpoints\n", name);
+            break;
+        }
+        if (size > mapSize - offset) {
+            fprintf(stderr, "Checkpoint truncado\n");
+            break;
+        }
+        policies[p] = (Policy){ .ops = ops, .state = ops->create(numFrames), .numFrames = numFrames };
+        if (policies[p].state == NULL) {
+            fprintf(stderr, "No hay memoria suficiente para %d frames\n", numFrames);
+            break;
+        }
+        PolicyImage image = { map + offset, (size_t)size, 0 };
+        if (!ops->restore(policies[p].state, &image) || image.offset != image.size) {
+            fprintf(stderr, "La imagen de %s en el checkpoint no es válida\n", name);
+            ops->destroy(policies[p].state);
+            policies[p].state = NULL;
+            break;
+        }
+        offset += (size_t)size;
+        if (p == count - 1) {
+            return true;
+        }
+    }
+    for (int i = 0; i < count && policies[i].state != NULL; i++) {
+        policies[i].ops->destroy(policies[i].state);
+    }
+    return false;
+}
+
+int loadCheckpoint(const char *path, const PolicyOps *const *available, int numAvailable, Policy *policies,
+                   int maxPolicies, uint64_t *references) {
+    int fd = open(path, O_RDONLY);
+    struct stat info;
+    if (fd < 0 || fstat(fd, &info) != 0) {
+        perror(path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 0;
+    }
+    size_t mapSize = (size_t)info.st_size;
+    const unsigned char *map = mapSize >= CHECKPOINT_HEADER_SIZE ?
+                               mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) {
+        fprintf(stderr, "%s: no es un checkpoint\n", path);
+        return 0;
+    }
+    madvise((void *)map, mapSize, MADV_SEQUENTIAL);
+
+    uint32_t version, count, numFrames, flags;
+    memcpy(&version, map + 4, sizeof(version));
+    memcpy(&count, map + 8, sizeof(count));
+    memcpy(&numFrames, map + 12, sizeof(numFrames));
+    memcpy(references, map + 16, sizeof(*references));
+    memcpy(&flags, map + 24, sizeof(flags));
+    int restored = 0;
+    if (memcmp(map, CHECKPOINT_MAGIC, 4) != 0 || version != CHECKPOINT_VERSION) {
+        fprintf(stderr, "%s: no es un checkpoint de la versión %d\n", path, CHECKPOINT_VERSION);
+    } else if (flags != CHECKPOINT_FLAGS) {
+        fprintf(stderr, "%s: el checkpoint se escribió con otras opciones de compilación\n", path);
+    } else if (count == 0 || count > (uint32_t)maxPolicies || numFrames == 0 || numFrames > INT32_MAX) {
+        fprintf(stderr, "%s: cabecera de checkpoint no válida\n", path);
+    } else {
+        for (uint32_t p = 0; p < count; p++) {
+            policies[p].state = NULL;
+        }
+        if (restorePolicies(map, mapSize, available, numAvailable, policies, (int)count, (int)numFrames)) {
+            restored = (int)count;
+        }
+    }
+    munmap((void *)map, mapSize);
+    return restored;
+}
@@ -0,0 +1,93 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Checkpoints de una simulación: el estado completo de cada política (frames, orden de la lista,
+ * frecuencias, puntero del reloj, bits de referencia y contadores) junto con el número de referencias
+ * de la entrada ya simuladas, para reanudarla sin volver a recorrer la traza desde el principio.
+ *
+ * El archivo es plano y se carga proyectándolo con mmap: cada política guarda sus arrays tal cual están
+ * en memoria (los enlaces son índices, no punteros), así que restaurarla es un memcpy por array, sin
+ * analizar nodo a nodo. Formato, en el orden de bytes de la máquina y con todo alineado a 8 bytes:
+ *  - Cabecera de CHECKPOINT_HEADER_SIZE bytes: "PGCK", versión (u32), número de políticas (u32),
+ *    frames (u32), referencias simuladas (u64), opciones de compilación (u32) y reservado (u32).
+ *  - Por política: su nombre en CHECKPOINT_NAME_SIZE bytes rellenos con ceros, el tamaño de su imagen
+ *    (u64) y la imagen: una secuencia de bloques, cada uno con su tamaño (u64) y sus bytes.
+ * Un checkpoint solo se puede cargar con un binario compilado con las mismas opciones (la disposición de
+ * SimStats cambia con -DPOLICY_INSTRUMENT) y para las mismas políticas con el mismo número de frames.
+ */
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "policy.h"
+
+#define CHECKPOINT_MAGIC "PGCK"     // Número mágico de los checkpoints
+#define CHECKPOINT_VERSION 3        // Versión del formato
+#define CHECKPOINT_HEADER_SIZE 32   // Bytes de la cabecera
+#define CHECKPOINT_NAME_SIZE 16     // Bytes por nombre de política
+
+// Imagen de una política dentro de un checkpoint proyectado, leída bloque a bloque por ops->restore
+struct PolicyImage {
+    const unsigned char *data;  // Inicio de la imagen
+    size_t size;                // Bytes de la imagen
+    size_t offset;              // Próximo bloque por leer
+};
+
+/*
+ * Función: saveBlock
+ * Descripción: Añade un bloque a la imagen de una política (lo usan las funciones ops->save).
+ * Parámetros:
+ *  - out: Archivo del checkpoint.
+ *  - data: Bytes del bloque (un struct o un array completo).
+ *  - size: Número de bytes.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+bool saveBlock(FILE *out, const void *data, size_t size);
+
+/*
+ * Función: loadBlock
+ * Descripción: Copia el siguiente bloque de la imagen de una política (lo usan las funciones ops->restore).
+ * Parámetros:
+ *  - image: Imagen de la política.
+ *  - data: Destino del bloque.
+ *  - size: Bytes esperados; si el bloque tiene otro tamaño no se copia nada.
+ * Retorna: true si el bloque existía y tenía el tamaño esperado.
+ */
+bool loadBlock(PolicyImage *image, void *data, size_t size);
+
+/*
+ * Función: saveCheckpoint
+ * Descripción: Escribe el checkpoint de un conjunto de políticas. Se escribe primero en path.tmp y después
+ *              se renombra, de modo que una caída a mitad de escritura deja intacto el checkpoint anterior.
+ * Parámetros:
+ *  - path: Archivo del checkpoint.
+ *  - policies: Políticas simuladas.
+ *  - numPolicies: Número de políticas.
+ *  - references: Referencias de la entrada ya simuladas.
+ * Retorna: true si el checkpoint quedó escrito (el motivo del fallo se informa por stderr).
+ */
+bool saveCheckpoint(const char *path, const Policy *policies, int numPolicies, uint64_t references);
+
+/*
+ * Función: loadCheckpoint
+ * Descripción: Proyecta un checkpoint y recrea sus políticas con el estado guardado.
+ * Parámetros:
+ *  - path: Archivo del checkpoint.
+ *  - available: Algoritmos disponibles, entre los que se buscan las políticas guardadas por nombre.
+ *  - numAvailable: Número de algoritmos disponibles.
+ *  - policies: Recibe las políticas restauradas (hasta maxPolicies); se liberan con ops->destroy.
+ *  - maxPolicies: Capacidad de policies.
+ *  - references: Recibe las referencias de la entrada ya simuladas.
+ * Retorna: Número de políticas restauradas, o 0 si falló (el motivo se informa por stderr).
+ */
+int loadCheckpoint(const char *path, const PolicyOps *const *available, int numAvailable, Policy *policies,
+                   int maxPolicies, uint64_t *references);
+
+#endif
@@ -0,0 +1,712 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del driver común declarado en driver.h. El bucle de simulación solo llama a
+ * ops->access; el estado de la memoria se vuelca únicamente si se pide con -d.
+ * 
+ * Con varias políticas (-p lru,clock,lfu o -p all) la traza se decodifica una sola vez: cada lote de
+ * TRACE_BATCH_SIZE referencias (16 KiB, cabe en la caché L1/L2) se entrega a todas las políticas una
+ * tras otra antes de leer el siguiente, así que la E/S y la decodificación cuestan lo mismo que una
+ * ejecución individual.
+ * 
+ * Con -DPOLICY_INSTRUMENT cada acceso se cronometra con CLOCK_MONOTONIC y se cuenta en el histograma
+ * de latencias de su política, que se resume al final junto a los contadores (ver stats.h).
+ * 
+ * Con -w N los lotes se parten en los límites de ventana, de modo que al cerrar cada ventana todas las
+ * políticas han visto exactamente las mismas N referencias (ver timeseries.h).
+ * 
+ * Con -c se escribe un checkpoint al terminar y, con -k N, también al acabar cada lote en que se cruza un
+ * múltiplo de N referencias; -r reanuda desde uno, saltando en la entrada las referencias que ya incluye
+ * (ver checkpoint.h). La serie de -w sigue entonces la numeración de ventanas de la ejecución completa.
+ * 
+ * Con -m las páginas de la traza se leen en 64 bits y se renumeran en flujo a identificadores densos
+ * (ver remap.h), para simular trazas con números de página que no caben en un int.
+ * 
+ * Si alguna política necesita conocer el futuro (ops->lookahead, como OPT), la entrada se le entrega
+ * completa antes de simular; una traza se recorre entonces dos veces.
+ * 
+ * Con -a K cada política tiene su propio detector de patrones (ver prefetch.h): tras cada referencia el
+ * driver carga con ops->prefetch el lote de K páginas que proponga. La lectura anticipada no se cronometra
+ * con -DPOLICY_INSTRUMENT, porque en un sistema real ocurre en segundo plano.
+ * 
+ * Las referencias marcadas como escritura en la traza (o con el prefijo W en la línea de comandos) se
+ * simulan con ops->write, que además marca la página como modificada; las políticas sin ops->write las
+ * simulan como lecturas y el driver lo advierte al terminar.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "driver.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "trace.h"
+#include "timeseries.h"
+#include "checkpoint.h"
+#include "remap.h"
+
+#define DEFAULT_NUM_FRAMES 4   // Frames de memoria física si no se indican en la línea de comandos
+
+/*
+ * Función: readAhead
+ * Descripción: Pasa una referencia al detector de la política y carga por adelantado el lote que proponga.
+ * Parámetros:
+ *  - policy: Algoritmo simulado, con lectura anticipada activada.
+ *  - page: Página referenciada.
+ *  - hit: true si la referencia fue un acierto.
+ */
+static void readAhead(Policy *policy, int page, bool hit) {
+    int batch[MAX_PREFETCH_DEPTH];
+    int count = predictPages(&policy->prefetcher, page, hit, batch);
+    for (int i = 0; i < count; i++) {
+        policy->ops->prefetch(policy->state, batch[i]);
+    }
+}
+
+/*
+ * Función: accessPage
+ * Descripción: Referencia una página en una política; con -DPOLICY_INSTRUMENT mide además la latencia.
+ *              Con lectura anticipada (-a) carga después las páginas que proponga el detector.
+ * Parámetros:
+ *  - policy: Algoritmo simulado.
+ *  - page: Página referenciada.
+ *  - write: true si la referencia es una escritura (lectura si la política no tiene ops->write).
+ * Retorna: true si fue un acierto.
+ */
+static inline bool accessPage(Policy *policy, int page, bool write) {
+    bool (*access)(void *, int) = write && policy->ops->write != NULL ? policy->ops->write : policy->ops->access;
+#ifdef POLICY_INSTRUMENT
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    bool hit = access(policy->state, page);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    recordLatency(&policy->latency, (uint64_t)((end.tv_sec - start.tv_sec) * 1000000000LL +
+                                               (end.tv_nsec - start.tv_nsec)));
+#else
+    bool hit = access(policy->state, page);
+#endif
+    if (policy->prefetcher.depth > 0) {
+        readAhead(policy, page, hit);
+    }
+    return hit;
+}
+
+/*
+ * Función: replayPages
+ * Descripción: Referencia una secuencia de páginas en cada política, volcando opcionalmente su estado
+ *              de forma periódica. La secuencia se recorre completa por una política antes de pasar a
+ *              la siguiente, mientras sigue en caché.
+ * Parámetros:
+ *  - policies: Algoritmos simulados.
+ *  - numPolicies: Número de algoritmos simulados.
+ *  - pages: Páginas referenciadas, en orden.
+ *  - writes: Qué referencias son escrituras (NULL si todas son lecturas).
+ *  - count: Número de páginas de la secuencia.
+ *  - dumpEvery: Imprimir el estado cada dumpEvery accesos (0 para no imprimirlo nunca).
+ */
+static void replayPages(Policy *policies, int numPolicies, const int *pages, const bool *writes, size_t count,
+                        uint64_t dumpEvery) {
+    for (int p = 0; p < numPolicies; p++) {
+        const PolicyOps *ops = policies[p].ops;
+        void *state = policies[p].state;
+        if (dumpEvery == 0) {
+            for (size_t i = 0; i < count; i++) {
+                accessPage(&policies[p], pages[i], writes != NULL && writes[i]);
+            }
+            continue;
+        }
+        for (size_t i = 0; i < count; i++) {
+            accessPage(&policies[p], pages[i], writes != NULL && writes[i]);
+            if (ops->stats(state)->accesses % dumpEvery == 0) {
+                printf("[%s]\n", ops->name);
+                ops->print(state);
+            }
+        }
+    }
+}
+
+// Simulación en curso: políticas, salidas opcionales y posición en la entrada
+typedef struct Replay {
+    Policy *policies;           // Algoritmos simulados
+    int numPolicies;            // Número de algoritmos simulados
+    uint64_t dumpEvery;         // Imprimir el estado cada dumpEvery accesos (0 para no imprimirlo nunca)
+    TimeSeries *series;         // Serie temporal, o NULL si no se pidió
+    const char *checkpointPath; // Checkpoint que se escribe, o NULL si no se pidió
+    uint64_t checkpointEvery;   // Referencias entre checkpoints periódicos (0 = solo al final)
+    uint64_t position;          // Referencias de la entrada ya simuladas (incluidas las de un checkpoint)
+    PageRemap *remap;           // Renumerador de las páginas de la traza, o NULL para usarlas tal cual
+    bool remapFailed;           // La renumeración se quedó sin memoria o sin identificadores
+    uint64_t writes;            // Escrituras simuladas en esta ejecución
+} Replay;
+
+/*
+ * Función: simulatePages
+ * Descripción: Simula una secuencia de páginas en todas las políticas; si hay serie temporal la registra
+ *              partiéndola en los límites de ventana, y si toca escribe un checkpoint periódico al final.
+ * Parámetros:
+ *  - replay: Simulación en curso.
+ *  - pages: Páginas referenciadas, en orden.
+ *  - writes: Qué referencias son escrituras (NULL si todas son lecturas).
+ *  - count: Número de páginas de la secuencia.
+ * Retorna: false si la serie temporal se quedó sin memoria o el checkpoint no se pudo escribir.
+ */
+static bool simulatePages(Replay *replay, const int *pages, const bool *writes, size_t count) {
+    uint64_t start = replay->position;
+    replay->position += count;
+    for (size_t i = 0; writes != NULL && i < count; i++) {
+        replay->writes += writes[i];
+    }
+    if (replay->series == NULL) {
+        replayPages(replay->policies, replay->numPolicies, pages, writes, count, replay->dumpEvery);
+    }
+    while (replay->series != NULL && count > 0) {
+        uint64_t remaining = windowRemaining(replay->series);
+        size_t chunk = remaining < count ? (size_t)remaining : count;
+        replayPages(replay->policies, replay->numPolicies, pages, writes, chunk, replay->dumpEvery);
+        if (!recordWindow(replay->series, replay->policies, pages, chunk)) {
+            fprintf(stderr, "No hay memoria suficiente para la serie temporal\n");
+            return false;
+        }
+        pages += chunk;
+        writes = writes != NULL ? writes + chunk : NULL;
+        count -= chunk;
+    }
+    if (replay->checkpointEvery > 0 &&
+        start / replay->checkpointEvery != replay->position / replay->checkpointEvery) {
+        return saveCheckpoint(replay->checkpointPath, replay->policies, replay->numPolicies, replay->position);
+    }
+    return true;
+}
+
+/*
+ * Función: lookaheadPages
+ * Descripción: Entrega un lote de la entrada a las políticas que necesitan conocerla por adelantado.
+ * Parámetros:
+ *  - replay: Simulación en curso.
+ *  - pages: Páginas del lote.
+ *  - count: Número de páginas del lote (0 para indicar el final de la entrada).
+ * Retorna: false si alguna política no pudo guardar el lote.
+ */
+static bool lookaheadPages(Replay *replay, const int *pages, size_t count) {
+    bool ok = true;
+    for (int p = 0; p < replay->numPolicies && ok; p++) {
+        const PolicyOps *ops = replay->policies[p].ops;
+        ok = ops->lookahead == NULL || ops->lookahead(replay->policies[p].state, pages, count);
+    }
+    return ok;
+}
+
+/*
+ * Función: needsLookahead
+ * Descripción: Indica si alguna de las políticas simuladas necesita la entrada completa por adelantado.
+ */
+static bool needsLookahead(const Replay *replay) {
+    for (int p = 0; p < replay->numPolicies; p++) {
+        if (replay->policies[p].ops->lookahead != NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Función: simulateArray
+ * Descripción: Simula una secuencia de páginas en memoria, saltando las referencias que ya incluye el
+ *              checkpoint del que se reanuda; antes se la entrega a las políticas con lookahead.
+ * Parámetros:
+ *  - replay: Simulación en curso.
+ *  - pages: Páginas de la entrada completa.
+ *  - writes: Qué referencias son escrituras (NULL si todas son lecturas).
+ *  - count: Número de páginas de la entrada.
+ * Retorna: true si la simulación terminó sin errores.
+ */
+static bool simulateArray(Replay *replay, const int *pages, const bool *writes, size_t count) {
+    if (replay->position > count) {
+        fprintf(stderr, "La entrada tiene %zu referencias, menos que las del checkpoint (%llu)\n", count,
+                (unsigned long long)replay->position);
+        return false;
+    }
+    size_t skipped = (size_t)replay->position;
+    if (needsLookahead(replay) && ((count > skipped && !lookaheadPages(replay, pages + skipped, count - skipped)) ||
+                                   !lookaheadPages(replay, NULL, 0))) {
+        return false;
+    }
+    return simulatePages(replay, pages + skipped, writes != NULL ? writes + skipped : NULL, count - skipped);
+}
+
+/*
+ * Función: readBatch
+ * Descripción: Lee el siguiente lote de la traza, renumerando sus páginas si se pidió con -m.
+ * Parámetros:
+ *  - replay: Simulación en curso.
+ *  - trace: Lector de la traza.
+ *  - pages: Array destino.
+ *  - writes: Recibe qué referencias son escrituras (NULL si no interesa).
+ *  - maxPages: Capacidad de los arrays destino (como mucho TRACE_BATCH_SIZE).
+ * Retorna: Número de páginas leídas; 0 al final de la traza o ante un error.
+ */
+static size_t readBatch(Replay *replay, TraceReader *trace, int *pages, bool *writes, size_t maxPages) {
+    if (replay->remap == NULL) {
+        return readAccesses(trace, pages, writes, maxPages);
+    }
+    int64_t raw[TRACE_BATCH_SIZE];
+    size_t count = readRawAccesses(trace, raw, writes, maxPages);
+    if (!remapPages(replay->remap, raw, pages, count)) {
+        replay->remapFailed = true;
+        return 0;
+    }
+    return count;
+}
+
+/*
+ * Función: lookaheadTrace
+ * Descripción: Primera pasada sobre la traza, antes de simular, para las políticas que necesitan conocer
+ *              la entrada completa (como OPT). Con -m usa un renumerador propio, que asigna los mismos
+ *              identificadores que el de la simulación porque ambos ven las páginas en el mismo orden.
+ * Parámetros:
+ *  - replay: Simulación en curso (sin referencias ya simuladas).
+ *  - path: Ruta de la traza; stdin no se admite porque no se puede leer dos veces.
+ * Retorna: true si la traza se leyó completa y todas las políticas la aceptaron.
+ */
+static bool lookaheadTrace(Replay *replay, const char *path) {
+    if (strcmp(path, "-") == 0) {
+        fprintf(stderr, "Las políticas que conocen el futuro necesitan una traza en archivo, no stdin\n");
+        return false;
+    }
+    TraceReader *trace = openTrace(path);
+    if (trace == NULL) {
+        return false;
+    }
+    Replay ahead = { .remap = replay->remap != NULL ? createRemap(0) : NULL };
+    bool ok = replay->remap == NULL || ahead.remap != NULL;
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para la renumeración\n");
+    }
+    int pages[TRACE_BATCH_SIZE];
+    size_t count;
+    while (ok && (count = readBatch(&ahead, trace, pages, NULL, TRACE_BATCH_SIZE)) > 0) {
+        ok = lookaheadPages(replay, pages, count);
+    }
+    ok = ok && !traceFailed(trace) && !ahead.remapFailed && lookaheadPages(replay, NULL, 0);
+    if (ahead.remap != NULL) {
+        destroyRemap(ahead.remap);
+    }
+    closeTrace(trace);
+    return ok;
+}
+
+/*
+ * Función: replayTrace
+ * Descripción: Referencia, por lotes, todas las páginas de un archivo de traza sin materializarlo;
+ *              cada lote se decodifica una vez y se reutiliza en todas las políticas. Al reanudar desde
+ *              un checkpoint se saltan primero las referencias que ya incluye (pasándolas por el
+ *              renumerador, si lo hay, para que asigne los mismos identificadores).
+ * Parámetros:
+ *  - replay: Simulación en curso.
+ *  - path: Ruta de la traza (compacta, binaria .bin o de texto; "-" para stdin).
+ * Retorna: true si la traza se leyó completa, false ante un error.
+ */
+static bool replayTrace(Replay *replay, const char *path) {
+    if (needsLookahead(replay) && !lookaheadTrace(replay, path)) {
+        return false;
+    }
+    TraceReader *trace = openTrace(path);
+    if (trace == NULL) {
+        return false;
+    }
+
+    int pages[TRACE_BATCH_SIZE];
+    bool writes[TRACE_BATCH_SIZE];
+    uint64_t skipped = 0;
+    if (replay->remap == NULL) {
+        skipped = skipPages(trace, replay->position);
+    }
+    while (skipped < replay->position) {
+        uint64_t rest = replay->position - skipped;
+        size_t read = readBatch(replay, trace, pages, NULL,
+                                rest < TRACE_BATCH_SIZE ? (size_t)rest : TRACE_BATCH_SIZE);
+        if (read == 0) {
+            break;
+        }
+        skipped += read;
+    }
+    bool ok = skipped == replay->position;
+    if (!ok && !traceFailed(trace)) {
+        fprintf(stderr, "%s: la traza tiene menos referencias que el checkpoint (%llu)\n", path,
+                (unsigned long long)replay->position);
+    }
+    size_t count;
+    while (ok && (count = readBatch(replay, trace, pages, writes, TRACE_BATCH_SIZE)) > 0) {
+        ok = simulatePages(replay, pages, writes, count);
+    }
+    ok = ok && !traceFailed(trace) && !replay->remapFailed;
+    closeTrace(trace);
+    return ok;
+}
+
+/*
+ * Función: destroyPolicies
+ * Descripción: Libera el estado de un conjunto de políticas.
+ * Parámetros:
+ *  - policies: Algoritmos simulados.
+ *  - numPolicies: Número de algoritmos simulados.
+ */
+static void destroyPolicies(Policy *policies, int numPolicies) {
+    for (int p = 0; p < numPolicies; p++) {
+        policies[p].ops->destroy(policies[p].state);
+    }
+}
+
+/*
+ * Función: findPolicy
+ * Descripción: Busca un algoritmo por nombre, sin distinguir mayúsculas.
+ * Parámetros:
+ *  - name: Nombre buscado.
+ *  - policies: Algoritmos disponibles.
+ *  - numPolicies: Número de algoritmos disponibles.
+ * Retorna: Tabla de operaciones del algoritmo, o NULL si no existe.
+ */
+static const PolicyOps* findPolicy(const char *name, const PolicyOps *const *policies, int numPolicies) {
+    for (int i = 0; i < numPolicies; i++) {
+        if (strcasecmp(policies[i]->name, name) == 0) {
+            return policies[i];
+        }
+    }
+    return NULL;
+}
+
+int parsePolicies(const char *list, const PolicyOps *const *policies, int numPolicies,
+                  const PolicyOps **selected) {
+    if (strcasecmp(list, "all") == 0) {
+        int count = numPolicies < MAX_POLICIES ? numPolicies : MAX_POLICIES;
+        for (int i = 0; i < count; i++) {
+            selected[i] = policies[i];
+        }
+        return count;
+    }
+
+    int count = 0;
+    const char *start = list;
+    while (count < MAX_POLICIES) {
+        size_t length = strcspn(start, ",");
+        char name[32];
+        size_t copied = length < sizeof(name) ? length : sizeof(name) - 1;
+        memcpy(name, start, copied);
+        name[copied] = '\0';
+
+        selected[count] = findPolicy(name, policies, numPolicies);
+        if (selected[count] == NULL) {
+            fprintf(stderr, "Política desconocida: %s\n", name);
+            return 0;
+        }
+        count++;
+        if (start[length] == '\0') {
+            break;
+        }
+        start += length + 1;
+    }
+    return count;
+}
+
+int parseFrameCounts(const char *list, int *counts) {
+    int numCounts = 0;
+    const char *cursor = list;
+    while (*cursor != '\0') {
+        char *end;
+        errno = 0;
+        long first = strtol(cursor, &end, 10);
+        long last = first;
+        if (*end == ':') {
+            last = strtol(end + 1, &end, 10);
+        }
+        if (errno != 0 || first <= 0 || last < first || last > INT_MAX || (*end != ',' && *end != '\0')) {
+            fprintf(stderr, "Lista de frames no válida: %s (los tamaños van de 1 a %d)\n", list, INT_MAX);
+            return 0;
+        }
+        for (long frames = first; numCounts < MAX_FRAME_COUNTS; frames *= 2) {
+            counts[numCounts++] = (int)frames;
+            if (frames > last / 2) {
+                break;  // El doble ya pasaría de last (y podría desbordar)
+            }
+        }
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+    return numCounts;
+}
+
+long parseCount(const char *text, long max) {
+    char *end;
+    errno = 0;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || value < 0 || value > max) {
+        fprintf(stderr, "Número no válido: %s (debe ser un entero de 0 a %ld)\n", text, max);
+        return -1;
+    }
+    return value;
+}
+
+/*
+ * Función: printUsage
+ * Descripción: Imprime la forma de uso del programa y los algoritmos disponibles.
+ * Parámetros:
+ *  - program: Nombre del programa.
+ *  - policies: Algoritmos disponibles.
+ *  - numPolicies: Número de algoritmos disponibles.
+ */
+static void printUsage(const char *program, const PolicyOps *const *policies, int numPolicies) {
+    fprintf(stderr, "Uso: %s [-p política[,política...]|all] [-t traza] [-d cadaN] [-q] [-w ventana [-o salida]]\n"
+                    "       [-c checkpoint [-k cadaN]] [-r checkpoint] [-m] [-a páginas] [numFrames] [página ...]\n",
+            program);
+    fprintf(stderr, "Políticas:");
+    for (int i = 0; i < numPolicies; i++) {
+        fprintf(stderr, " %s", policies[i]->name);
+    }
+    fprintf(stderr, "\n");
+}
+
+/*
+ * Función: resumePolicies
+ * Descripción: Restaura las políticas de un checkpoint y comprueba que coinciden con las pedidas en la
+ *              línea de comandos, si se pidieron.
+ * Parámetros:
+ *  - path: Archivo del checkpoint.
+ *  - policies, numPolicies: Algoritmos disponibles.
+ *  - selected, numSelected: Políticas elegidas con -p (numSelected 0 si no se usó -p).
+ *  - numFrames: Frames indicados en la línea de comandos (0 si no se indicaron).
+ *  - active: Recibe las políticas restauradas.
+ *  - position: Recibe las referencias de la entrada ya simuladas.
+ * Retorna: Número de políticas restauradas, o 0 si falló.
+ */
+static int resumePolicies(const char *path, const PolicyOps *const *policies, int numPolicies,
+                          const PolicyOps *const *selected, int numSelected, int numFrames, Policy *active,
+                          uint64_t *position) {
+    int restored = loadCheckpoint(path, policies, numPolicies, active, MAX_POLICIES, position);
+    bool matches = restored > 0 && (numFrames == 0 || numFrames == active[0].numFrames) &&
+                   (numSelected == 0 || numSelected == restored);
+    for (int p = 0; p < restored && matches && numSelected > 0; p++) {
+        matches = selected[p] == active[p].ops;
+    }
+    if (restored > 0 && !matches) {
+        fprintf(stderr, "%s: el checkpoint es de otras políticas o de otro número de frames (%d)\n", path,
+                active[0].numFrames);
+        destroyPolicies(active, restored);
+        return 0;
+    }
+    return restored;
+}
+
+int runDriver(int argc, char *argv[], const PolicyOps *const *policies, int numPolicies) {
+    const PolicyOps *selected[MAX_POLICIES] = { policies[0] };
+    int numSelected = 1;
+    bool policiesGiven = false;
+    const char *tracePath = NULL;
+    uint64_t dumpEvery = 0;  // Por defecto solo contadores: sin volcados en el bucle de simulación
+    bool dumpGiven = false;
+    bool quiet = false;
+    uint64_t window = 0;           // Referencias por ventana de la serie temporal (0 = sin serie)
+    const char *seriesPath = "-";
+    const char *checkpointPath = NULL;
+    uint64_t checkpointEvery = 0;
+    const char *resumePath = NULL;
+    bool remapTrace = false;       // Renumerar las páginas de la traza a identificadores densos (-m)
+    int prefetchDepth = 0;         // Páginas por lote de lectura anticipada (0 = solo demanda)
+    int opt;
+    while ((opt = getopt(argc, argv, "p:t:d:qw:o:c:k:r:ma:")) != -1) {
+        if (opt == 'p') {
+            numSelected = parsePolicies(optarg, policies, numPolicies, selected);
+            policiesGiven = true;
+            if (numSelected == 0) {
+                printUsage(argv[0], policies, numPolicies);
+                return 1;
+            }
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else if (opt == 'd') {
+            dumpEvery = strtoull(optarg, NULL, 10);
+            dumpGiven = true;
+        } else if (opt == 'q') {
+            quiet = true;
+        } else if (opt == 'w') {
+            window = strtoull(optarg, NULL, 10);
+            if (window == 0) {
+                printUsage(argv[0], policies, numPolicies);
+                return 1;
+            }
+        } else if (opt == 'o') {
+            seriesPath = optarg;
+        } else if (opt == 'c') {
+            checkpointPath = optarg;
+        } else if (opt == 'k') {
+            checkpointEvery = strtoull(optarg, NULL, 10);
+        } else if (opt == 'r') {
+            resumePath = optarg;
+        } else if (opt == 'm') {
+            remapTrace = true;
+        } else if (opt == 'a') {
+            prefetchDepth = (int)parseCount(optarg, INT_MAX);
+            if (prefetchDepth < 1 || prefetchDepth > MAX_PREFETCH_DEPTH) {
+                fprintf(stderr, "La lectura anticipada debe ser de 1 a %d páginas\n", MAX_PREFETCH_DEPTH);
+                return 1;
+            }
+        } else {
+            printUsage(argv[0], policies, numPolicies);
+            return 1;
+        }
+    }
+
+    // Al reanudar, las políticas y los frames salen del checkpoint si no se indican
+    int numFrames = (optind < argc) ? (int)parseCount(argv[optind++], INT_MAX) :
+                    (resumePath != NULL ? 0 : DEFAULT_NUM_FRAMES);
+    if (numFrames < 0 || (numFrames == 0 && resumePath == NULL) || (checkpointEvery > 0 && checkpointPath == NULL) ||
+        (remapTrace && tracePath == NULL)) {
+        printUsage(argv[0], policies, numPolicies);
+        return 1;
+    }
+
+    Policy active[MAX_POLICIES];
+    uint64_t position = 0;
+    if (resumePath != NULL) {
+        numSelected = resumePolicies(resumePath, policies, numPolicies, selected, policiesGiven ? numSelected : 0,
+                                     numFrames, active, &position);
+        if (numSelected == 0) {
+            return 1;
+        }
+        numFrames = active[0].numFrames;
+    }
+    for (int p = 0; p < numSelected && resumePath == NULL; p++) {
+        active[p] = (Policy){ .ops = selected[p], .state = selected[p]->create(numFrames), .numFrames = numFrames };
+        if (active[p].state == NULL) {
+            fprintf(stderr, "No hay memoria suficiente para %d frames\n", numFrames);
+            destroyPolicies(active, p);
+            return 1;
+        }
+    }
+
+    for (int p = 0; p < numSelected && checkpointPath != NULL; p++) {
+        if (active[p].ops->save == NULL) {
+            fprintf(stderr, "La política %s no admite checkpoints\n", active[p].ops->name);
+            destroyPolicies(active, numSelected);
+            return 1;
+        }
+    }
+    for (int p = 0; p < numSelected; p++) {
+        if (prefetchDepth > 0 && active[p].ops->prefetch == NULL) {
+            fprintf(stderr, "La política %s no admite lectura anticipada\n", active[p].ops->name);
+            destroyPolicies(active, numSelected);
+            return 1;
+        }
+        initPrefetcher(&active[p].prefetcher, prefetchDepth);
+    }
+
+    TimeSeries *series = NULL;
+    if (window > 0) {
+        series = openTimeSeries(seriesPath, window, active, numSelected, position);
+        if (series == NULL) {
+            destroyPolicies(active, numSelected);
+            return 1;
+        }
+    }
+
+    Replay replay = { active, numSelected, dumpEvery, series, checkpointPath, checkpointEvery, position, NULL, false,
+                      0 };
+    bool ok = true;
+    if (tracePath != NULL) {
+        replay.remap = remapTrace ? createRemap(0) : NULL;
+        if (remapTrace && replay.remap == NULL) {
+            fprintf(stderr, "No hay memoria para la renumeración\n");
+            ok = false;
+        } else {
+            ok = replayTrace(&replay, tracePath);
+        }
+        if (replay.remap != NULL) {
+            destroyRemap(replay.remap);
+        }
+    } else if (optind < argc) {
+        // Cargar la secuencia de páginas indicada, de la longitud que tenga; W3 es una escritura en la página 3
+        int numPages = argc - optind;
+        int *pages = (int *)malloc((size_t)numPages * sizeof(int));
+        bool *writes = (bool *)malloc((size_t)numPages * sizeof(bool));
+        if (pages == NULL || writes == NULL) {
+            fprintf(stderr, "No hay memoria suficiente para %d páginas\n", numPages);
+            free(pages);
+            free(writes);
+            if (series != NULL) {
+                closeTimeSeries(series, active);
+            }
+            destroyPolicies(active, numSelected);
+            return 1;
+        }
+        for (int i = 0; i < numPages; i++) {
+            const char *token = argv[optind + i];
+            writes[i] = *token == 'W' || *token == 'w';
+            if (writes[i] || *token == 'R' || *token == 'r') {
+                token++;
+            }
+            char *end;
+            errno = 0;
+            long page = strtol(token, &end, 10);
+            if (end == token || *end != '\0' || errno != 0 || page < 0 || page > INT_MAX) {
+                fprintf(stderr, "Página no válida: %s (debe ser un entero no negativo)\n", argv[optind + i]);
+                ok = false;
+                break;
+            }
+            pages[i] = (int)page;
+        }
+        if (ok) {
+            ok = simulateArray(&replay, pages, writes, (size_t)numPages);
+        }
+        free(pages);
+        free(writes);
+    } else {
+        // Secuencia de ejemplo: por defecto se imprime el estado tras cada carga
+        int pageAccesses[] = {1, 2, 3, 4, 5, 1, 2, 1, 3, 4};
+        replay.dumpEvery = dumpGiven ? dumpEvery : 1;
+        ok = simulateArray(&replay, pageAccesses, NULL, sizeof(pageAccesses) / sizeof(pageAccesses[0]));
+        if (!dumpGiven) {
+            quiet = true;  // El último acceso ya se volcó
+        }
+    }
+    if (series != NULL) {
+        ok = closeTimeSeries(series, active) && ok;
+    }
+    if (ok && checkpointPath != NULL) {
+        ok = saveCheckpoint(checkpointPath, active, numSelected, replay.position);
+    }
+
+    for (int p = 0; p < numSelected; p++) {
+        const PolicyOps *ops = active[p].ops;
+        if (!quiet) {
+            if (numSelected > 1) {
+                printf("[%s]\n", ops->name);
+            }
+            ops->print(active[p].state);
+        }
+        printStats(ops->name, numFrames, ops->stats(active[p].state));
+        INSTRUMENT(printInstrumentation(ops->name, ops->stats(active[p].state), &active[p].latency));
+        if (replay.writes > 0 && ops->write == NULL) {
+            fprintf(stderr, "La política %s no distingue escrituras: las %llu de la entrada se simularon como "
+                            "lecturas\n", ops->name, (unsigned long long)replay.writes);
+        }
+    }
+
+    // Desviación de cada política respecto a la primera elegida
+    const SimStats *reference = active[0].ops->stats(active[0].state);
+    for (int p = 1; p < numSelected; p++) {
+        const SimStats *stats = active[p].ops->stats(active[p].state);
+        printf("Diferencia %s - %s: tasa_aciertos %+.6f (%+lld aciertos)\n", active[p].ops->name,
+               active[0].ops->name, hitRatio(stats) - hitRatio(reference),
+               (long long)stats->hits - (long long)reference->hits);
+    }
+    destroyPolicies(active, numSelected);
+    return ok ? 0 : 1;
+}
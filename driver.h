@@ -0,0 +1,84 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Driver común de simulación: interpreta la línea de comandos, crea el algoritmo elegido y lo alimenta
+ * con una traza, una lista de páginas o la secuencia de ejemplo, imprimiendo al final el resumen de
+ * contadores. Lo usan tanto el main de cada algoritmo como el simulador que los reúne a todos.
+ */
+
+#ifndef DRIVER_H
+#define DRIVER_H
+
+#include "policy.h"
+
+#define MAX_POLICIES 16        // Políticas que se pueden simular a la vez
+#define MAX_FRAME_COUNTS 1024  // Tamaños de memoria distintos en una misma lista -f
+
+/*
+ * Función: runDriver
+ * Descripción: Ejecuta una simulación según los argumentos de la línea de comandos.
+ *              Uso: programa [-p política[,política...]|all] [-t traza] [-d cadaN] [-q] [-w ventana [-o salida]]
+ *                            [-c checkpoint [-k cadaN]] [-r checkpoint] [-m] [-a páginas] [numFrames]
+ *                            [[W]página ...]
+ *              Con -w se escribe una serie temporal con la tasa de aciertos, los fallos y el conjunto de
+ *              trabajo de cada ventana de N referencias, en CSV o en binario si la salida acaba en .bin
+ *              (por defecto en stdout; ver timeseries.h).
+ *              Con -c se guarda el estado de las políticas al terminar (y cada N referencias con -k); con -r
+ *              se reanuda desde un checkpoint, que fija las políticas y los frames (ver checkpoint.h).
+ *              Con -m las páginas de la traza se renumeran en orden de aparición (ver remap.h).
+ *              Con -a K, al detectar un recorrido secuencial o de salto fijo se cargan por adelantado
+ *              lotes de K páginas, y el resumen cuenta aparte las leídas, las útiles y las
+ *              desperdiciadas (ver prefetch.h); se rechazan las políticas sin ops->prefetch.
+ *              Las escrituras de la traza (trace-convert -w) o las páginas de la línea de comandos con el
+ *              prefijo W se simulan con ops->write, y el resumen muestra los desalojos sucios y el coste
+ *              de sus escrituras en disco (ver stats.h).
+ *              Las páginas de la línea de comandos son enteros decimales no negativos; como en la traza,
+ *              -1 y otros negativos se rechazan (ver trace.h).
+ * Parámetros:
+ *  - argc, argv: Argumentos del programa.
+ *  - policies: Algoritmos disponibles; -p elige uno o varios por nombre (se simulan en una sola pasada
+ *    sobre la entrada) y por defecto se usa el primero. Con varias, al final se imprime la diferencia
+ *    de aciertos de cada una respecto a la primera elegida.
+ *  - numPolicies: Número de algoritmos disponibles.
+ * Retorna: Código de salida del programa (0 si la simulación terminó sin errores).
+ */
+int runDriver(int argc, char *argv[], const PolicyOps *const *policies, int numPolicies);
+
+/*
+ * Función: parsePolicies
+ * Descripción: Interpreta una lista de políticas separadas por comas ("all" las selecciona todas).
+ * Parámetros:
+ *  - list: Lista indicada con -p.
+ *  - policies: Algoritmos disponibles.
+ *  - numPolicies: Número de algoritmos disponibles.
+ *  - selected: Donde se dejan las políticas elegidas (hasta MAX_POLICIES).
+ * Retorna: Número de políticas elegidas, o 0 si alguna es desconocida.
+ */
+int parsePolicies(const char *list, const PolicyOps *const *policies, int numPolicies,
+                  const PolicyOps **selected);
+
+/*
+ * Función: parseFrameCounts
+ * Descripción: Interpreta la lista de tamaños de memoria: valores separados por comas, donde A:B
+ *              representa A, 2A, 4A, ... hasta B. Los tamaños van de 1 a INT_MAX.
+ * Parámetros:
+ *  - list: Lista indicada con -f.
+ *  - counts: Donde se dejan los tamaños (hasta MAX_FRAME_COUNTS).
+ * Retorna: Número de tamaños, o 0 si la lista no es válida.
+ */
+int parseFrameCounts(const char *list, int *counts);
+
+/*
+ * Función: parseCount
+ * Descripción: Interpreta un número de la línea de comandos (frames, hilos...) como entero decimal de
+ *              0 a max, sin nada detrás; si no lo es, lo informa por stderr.
+ * Parámetros:
+ *  - text: Texto del argumento.
+ *  - max: Valor máximo admitido.
+ * Retorna: El número, o -1 si no es válido.
+ */
+long parseCount(const char *text, long max);
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación de los núcleos de framescan.h. Cada variante vectorial compara bloques de 16 páginas,
+ * reduce las comparaciones a una máscara y sale con el primer bit de la máscara; el resto del array
+ * que no llena un bloque se recorre con el bucle escalar común.
+ */
+
+#include "framescan.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define SCAN_BLOCK 16   // Páginas comparadas por iteración en las variantes vectoriales
+
+/*
+ * Función: findPageBlocks
+ * Descripción: Recorre los bloques completos de SCAN_BLOCK páginas con la variante vectorial disponible.
+ * Parámetros:
+ *  - pages: Array de páginas.
+ *  - count: Número de elementos del array.
+ *  - page: Página que se busca.
+ *  - scanned: Recibe cuántos elementos se recorrieron sin encontrarla.
+ * Retorna: Índice de la primera aparición, o -1 si no está en los bloques recorridos.
+ */
+static int findPageBlocks(const int *pages, int count, int page, int *scanned) {
+    int i = 0;
+#if defined(__AVX2__)
+    __m256i key = _mm256_set1_epi32(page);
+    for (; i + SCAN_BLOCK <= count; i += SCAN_BLOCK) {
+        __m256i low = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(pages + i)), key);
+        __m256i high = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *)(pages + i + 8)), key);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(low)) |
+                        ((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(high)) << 8);
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i key = _mm_set1_epi32(page);
+    for (; i + SCAN_BLOCK <= count; i += SCAN_BLOCK) {
+        unsigned mask = 0;
+        for (int part = 0; part < SCAN_BLOCK / 4; part++) {
+            __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(pages + i + 4 * part)), key);
+            mask |= (unsigned)_mm_movemask_ps(_mm_castsi128_ps(equal)) << (4 * part);
+        }
+        if (mask != 0) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+#elif defined(__ARM_NEON)
+    int32x4_t key = vdupq_n_s32(page);
+    for (; i + SCAN_BLOCK <= count; i += SCAN_BLOCK) {
+        uint32x4_t any = vorrq_u32(vorrq_u32(vceqq_s32(vld1q_s32(pages + i), key),
+                                             vceqq_s32(vld1q_s32(pages + i + 4), key)),
+                                   vorrq_u32(vceqq_s32(vld1q_s32(pages + i + 8), key),
+                                             vceqq_s32(vld1q_s32(pages + i + 12), key)));
+        if (vmaxvq_u32(any) != 0) {
+            for (int j = i; ; j++) {  // El bloque contiene la página: localizarla dentro de él
+                if (pages[j] == page) {
+                    return j;
+                }
+            }
+        }
+    }
+#else
+    (void)pages;
+    (void)count;
+    (void)page;
+#endif
+    *scanned = i;
+    return -1;
+}
+
+int findPageIndex(const int *pages, int count, int page) {
+    int i;
+    int found = findPageBlocks(pages, count, page, &i);
+    if (found >= 0) {
+        return found;
+    }
+    for (; i < count; i++) {
+        if (pages[i] == page) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int sweepZeroBit(uint64_t *bits, int start, int end) {
+    if (start >= end) {
+        return -1;
+    }
+    size_t word = (size_t)start / BITS_PER_WORD;
+    size_t lastWord = (size_t)(end - 1) / BITS_PER_WORD;
+    uint64_t mask = ~(uint64_t)0 << (start % BITS_PER_WORD);
+    for (;;) {
+        if (word == lastWord) {
+            mask &= ~(uint64_t)0 >> (BITS_PER_WORD - 1 - (end - 1) % BITS_PER_WORD);
+        }
+        uint64_t zeros = ~bits[word] & mask;
+        if (zeros != 0) {
+            int bit = __builtin_ctzll(zeros);
+            bits[word] &= ~(mask & (((uint64_t)1 << bit) - 1));  // Los bits recorridos antes de la víctima
+            return (int)(word * BITS_PER_WORD) + bit;
+        }
+        bits[word] &= ~mask;
+        if (word == lastWord) {
+            return -1;
+        }
+        word++;
+        mask = ~(uint64_t)0;
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Núcleos de búsqueda sobre arrays contiguos de frames (disposición de estructura de arrays): buscar un
+ * número de página en un array de int y barrer un mapa de bits de palabras de 64 bits hasta el
+ * siguiente bit a 0. Se compila la variante vectorial que admita el procesador de destino (AVX2, SSE2 o NEON,
+ * comparando 16 páginas por iteración) y, si no hay ninguna, una versión escalar; conviene compilar con
+ * -march=native para que se use AVX2 cuando esté disponible.
+ */
+
+#ifndef FRAMESCAN_H
+#define FRAMESCAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BITS_PER_WORD 64                                            // Bits por palabra de un mapa de bits
+#define BITMAP_WORDS(n) (((size_t)(n) + BITS_PER_WORD - 1) / BITS_PER_WORD)  // Palabras para n bits
+
+/*
+ * Funciones: testBit, setBit, clearBit
+ * Descripción: Consultan y modifican un bit de un mapa de bits.
+ */
+static inline int testBit(const uint64_t *bits, int index) {
+    return (int)((bits[index / BITS_PER_WORD] >> (index % BITS_PER_WORD)) & 1u);
+}
+
+static inline void setBit(uint64_t *bits, int index) {
+    bits[index / BITS_PER_WORD] |= (uint64_t)1 << (index % BITS_PER_WORD);
+}
+
+static inline void clearBit(uint64_t *bits, int index) {
+    bits[index / BITS_PER_WORD] &= ~((uint64_t)1 << (index % BITS_PER_WORD));
+}
+
+/*
+ * Función: findPageIndex
+ * Descripción: Busca la primera aparición de una página en un array de páginas. Los frames vacíos
+ *              guardan -1 y no se enmascaran: page debe ser no negativa, lo que garantizan los lectores
+ *              de trazas y el driver al rechazar las páginas negativas (ver trace.h).
+ * Parámetros:
+ *  - pages: Array de páginas.
+ *  - count: Número de elementos del array.
+ *  - page: Página que se busca.
+ * Retorna: Índice de la primera aparición, o -1 si no está.
+ */
+int findPageIndex(const int *pages, int count, int page);
+
+/*
+ * Función: sweepZeroBit
+ * Descripción: Recorrido del puntero del reloj: busca el primer bit a 0 en [start, end) y pone a 0 los
+ *              bits anteriores a él, palabra a palabra (una palabra llena se limpia y se salta de una
+ *              vez y ctz lleva directamente a la víctima dentro de la última).
+ * Parámetros:
+ *  - bits: Mapa de bits.
+ *  - start: Primer bit del rango.
+ *  - end: Bit siguiente al último del rango.
+ * Retorna: Índice del bit encontrado, o -1 si todos valían 1 (y ahora todo el rango vale 0).
+ */
+int sweepZeroBit(uint64_t *bits, int start, int end);
+
+#endif
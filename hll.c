@@ -0,0 +1,90 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del estimador HyperLogLog declarado en hll.h. Con un hash de 64 bits no hace falta la
+ * corrección de rango grande del algoritmo original: las colisiones solo importan muy por encima de
+ * las 2^31 páginas distintas que caben en un int.
+ */
+
+#include "hll.h"
+
+#include <stdlib.h>
+#include <math.h>
+
+struct HyperLogLog {
+    int precision;              // Bits de índice
+    uint32_t numRegisters;      // 2^precision
+    unsigned char *registers;   // Racha máxima (número de ceros iniciales + 1) vista en cada registro
+};
+
+/*
+ * Función: pageHash
+ * Descripción: Hash de 64 bits de una página (finalizador fmix64 de MurmurHash3).
+ */
+static uint64_t pageHash(int page) {
+    uint64_t h = (uint64_t)(uint32_t)page;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+HyperLogLog* createHyperLogLog(int precision) {
+    if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION) {
+        return NULL;
+    }
+    HyperLogLog *hll = (HyperLogLog *)malloc(sizeof(HyperLogLog));
+    if (hll == NULL) {
+        return NULL;
+    }
+    hll->precision = precision;
+    hll->numRegisters = 1u << precision;
+    hll->registers = (unsigned char *)calloc(hll->numRegisters, 1);
+    if (hll->registers == NULL) {
+        free(hll);
+        return NULL;
+    }
+    return hll;
+}
+
+void destroyHyperLogLog(HyperLogLog *hll) {
+    free(hll->registers);
+    free(hll);
+}
+
+void hllAdd(HyperLogLog *hll, int page) {
+    uint64_t h = pageHash(page);
+    uint32_t index = (uint32_t)(h >> (64 - hll->precision));
+    uint64_t rest = h << hll->precision;
+    // Ceros iniciales del resto + 1; un resto nulo cuenta como la racha máxima posible
+    unsigned char rank = rest == 0 ? (unsigned char)(64 - hll->precision + 1) :
+                                     (unsigned char)(__builtin_clzll(rest) + 1);
+    if (rank > hll->registers[index]) {
+        hll->registers[index] = rank;
+    }
+}
+
+double hllEstimate(const HyperLogLog *hll) {
+    double m = (double)hll->numRegisters;
+    double sum = 0.0;
+    uint32_t zeros = 0;
+    for (uint32_t i = 0; i < hll->numRegisters; i++) {
+        sum += ldexp(1.0, -hll->registers[i]);
+        zeros += hll->registers[i] == 0;
+    }
+    double alpha = hll->precision == 4 ? 0.673 : hll->precision == 5 ? 0.697 : hll->precision == 6 ? 0.709 :
+                   0.7213 / (1.0 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * log(m / (double)zeros);  // Rango pequeño: conteo lineal
+    }
+    return estimate;
+}
+
+double hllError(const HyperLogLog *hll) {
+    return 1.04 / sqrt((double)hll->numRegisters);
+}
@@ -0,0 +1,69 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Estimador HyperLogLog del número de páginas distintas de una traza con memoria fija: 2^precision
+ * registros de un byte, independientemente de la longitud de la traza y del número de páginas. Cada
+ * página se mezcla con el finalizador de 64 bits de MurmurHash3; los primeros bits del hash eligen el
+ * registro y este guarda la racha más larga de ceros vista en el resto. El error típico relativo es
+ * 1.04 / sqrt(2^precision) (0.81% con la precisión por defecto), y con pocas páginas la estimación pasa
+ * a conteo lineal de registros vacíos, que es casi exacto.
+ */
+
+#ifndef HLL_H
+#define HLL_H
+
+#include <stdint.h>
+
+#define HLL_MIN_PRECISION 4         // Bits de índice mínimos (16 registros)
+#define HLL_MAX_PRECISION 18        // Bits de índice máximos (256 KiB de registros)
+#define HLL_DEFAULT_PRECISION 14    // 16 KiB de registros, error típico del 0.81%
+
+typedef struct HyperLogLog HyperLogLog;
+
+/*
+ * Función: createHyperLogLog
+ * Descripción: Crea un estimador vacío.
+ * Parámetros:
+ *  - precision: Bits de índice, entre HLL_MIN_PRECISION y HLL_MAX_PRECISION.
+ * Retorna: Puntero al estimador creado, o NULL si la precisión no es válida o no hay memoria.
+ */
+HyperLogLog* createHyperLogLog(int precision);
+
+/*
+ * Función: destroyHyperLogLog
+ * Descripción: Libera el estimador.
+ * Parámetros:
+ *  - hll: Puntero al estimador.
+ */
+void destroyHyperLogLog(HyperLogLog *hll);
+
+/*
+ * Función: hllAdd
+ * Descripción: Registra una referencia a una página (las repetidas no cambian la estimación).
+ * Parámetros:
+ *  - hll: Puntero al estimador.
+ *  - page: Número de la página.
+ */
+void hllAdd(HyperLogLog *hll, int page);
+
+/*
+ * Función: hllEstimate
+ * Descripción: Estima el número de páginas distintas registradas.
+ * Parámetros:
+ *  - hll: Puntero al estimador.
+ * Retorna: Estimación del número de páginas distintas.
+ */
+double hllEstimate(const HyperLogLog *hll);
+
+/*
+ * Función: hllError
+ * Descripción: Error típico relativo de la estimación para la precisión del estimador.
+ * Parámetros:
+ *  - hll: Puntero al estimador.
+ * Retorna: Desviación típica relativa (por ejemplo 0.0081).
+ */
+double hllError(const HyperLogLog *hll);
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Curva de tasa de fallos LRU de una traza en una sola pasada (ver stackdist.h). En lugar de simular la
+ * lista LRU una vez por cada número de frames, registra la distancia de pila de cada referencia y con
+ * el histograma resultante obtiene la tasa de fallos de todos los tamaños de memoria a la vez; para un
+ * tamaño dado coincide exactamente con la que da FIFO-LRU.
+ *
+ * Para trazas enormes, -s y -m activan el muestreo espacial de shards.h: la curva LRU se estima con una
+ * fracción de las páginas (-s) o con un máximo de páginas muestreadas (-m, memoria acotada), y con -p
+ * cada política elegida (por ejemplo CLOCK) se estima por simulación en miniatura en los tamaños de -f.
+ * Las estimaciones muestreadas incluyen la semiamplitud de su intervalo del 95%.
+ *
+ * Compilación: gcc -O2 -march=native -pthread -DPOLICY_LIBRARY mrc.c stackdist.c shards.c driver.c policies.c \
+ *              FIFO-LRU.c LRU-CLOCK.c framescan.c OPR-LFU.c MT-CLOCK.c SHARDED-LRU.c CAR-CLOCK.c OPT-BELADY.c \
+ *              timeseries.c checkpoint.c remap.c prefetch.c trace.c stats.c -lm -o mrc
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "driver.h"
+#include "shards.h"
+#include "stackdist.h"
+#include "trace.h"
+
+/*
+ * Función: exactCurve
+ * Descripción: Curva LRU exacta de la traza en una sola pasada.
+ * Parámetros:
+ *  - trace: Traza abierta.
+ *  - pages: Búfer de lote.
+ *  - frameCounts, numCounts: Tamaños pedidos con -f (0 = curva completa).
+ * Retorna: true si la traza se procesó sin errores.
+ */
+static bool exactCurve(TraceReader *trace, int *pages, const int *frameCounts, int numCounts) {
+    StackDistance *analyzer = createStackDistance();
+    bool ok = analyzer != NULL;
+    size_t count;
+    while (ok && (count = readPages(trace, pages, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = recordAccess(analyzer, pages[i]) >= 0;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para el análisis de distancias de pila\n");
+    }
+    ok = ok && !traceFailed(trace);
+
+    if (ok) {
+        if (numCounts == 0) {
+            printMissRatioCurve(analyzer, stdout);
+        } else {
+            printf("frames,tasa_fallos\n");
+            for (int i = 0; i < numCounts; i++) {
+                printf("%d,%.6f\n", frameCounts[i], missRatioAt(analyzer, frameCounts[i]));
+            }
+        }
+        fprintf(stderr, "Curva LRU: %llu accesos, %llu páginas distintas\n",
+                (unsigned long long)stackAccesses(analyzer),
+                (unsigned long long)stackDistinctPages(analyzer));
+    }
+    if (analyzer != NULL) {
+        destroyStackDistance(analyzer);
+    }
+    return ok;
+}
+
+/*
+ * Función: sampledCurve
+ * Descripción: Curva LRU aproximada por muestreo espacial.
+ * Parámetros:
+ *  - trace: Traza abierta.
+ *  - pages: Búfer de lote.
+ *  - rate: Tasa de muestreo inicial.
+ *  - maxPages: Máximo de páginas muestreadas (0 = sin límite).
+ *  - frameCounts, numCounts: Tamaños pedidos con -f (0 = curva completa).
+ * Retorna: true si la traza se procesó sin errores.
+ */
+static bool sampledCurve(TraceReader *trace, int *pages, double rate, size_t maxPages,
+                         const int *frameCounts, int numCounts) {
+    ShardsMrc *mrc = createShardsMrc(rate, maxPages);
+    bool ok = mrc != NULL;
+    size_t count;
+    while (ok && (count = readPages(trace, pages, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = shardsRecord(mrc, pages[i]);
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para el muestreo\n");
+    }
+    ok = ok && !traceFailed(trace);
+
+    if (ok) {
+        if (numCounts == 0) {
+            printShardsCurve(mrc, stdout);
+        } else {
+            printf("frames,tasa_fallos,error\n");
+            for (int i = 0; i < numCounts; i++) {
+                double error;
+                double ratio = shardsMissRatio(mrc, frameCounts[i], &error);
+                printf("%d,%.6f,%.6f\n", frameCounts[i], ratio, error);
+            }
+        }
+        fprintf(stderr, "Curva LRU muestreada: tasa final %.6f, %llu páginas en la muestra\n",
+                shardsRate(mrc), (unsigned long long)shardsSampledPages(mrc));
+    }
+    if (mrc != NULL) {
+        destroyShardsMrc(mrc);
+    }
+    return ok;
+}
+
+/*
+ * Función: miniatureCurves
+ * Descripción: Tasa de fallos de varias políticas y tamaños por simulación en miniatura, en una sola
+ *              pasada sobre la traza.
+ * Parámetros:
+ *  - trace: Traza abierta.
+ *  - pages: Búfer de lote.
+ *  - selected, numSelected: Políticas elegidas con -p.
+ *  - rate: Tasa de muestreo.
+ *  - frameCounts, numCounts: Tamaños pedidos con -f.
+ * Retorna: true si la traza se procesó sin errores.
+ */
+static bool miniatureCurves(TraceReader *trace, int *pages, const PolicyOps *const *selected, int numSelected,
+                            double rate, const int *frameCounts, int numCounts) {
+    int numMinis = numSelected * numCounts;
+    ShardsMini **minis = (ShardsMini **)calloc((size_t)numMinis, sizeof(ShardsMini *));
+    bool ok = minis != NULL;
+    for (int i = 0; ok && i < numMinis; i++) {
+        ok = (minis[i] = createShardsMini(selected[i / numCounts], frameCounts[i % numCounts], rate)) != NULL;
+    }
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para las simulaciones en miniatura\n");
+    }
+
+    size_t count;
+    while (ok && (count = readPages(trace, pages, TRACE_BATCH_SIZE)) > 0) {
+        for (int m = 0; m < numMinis; m++) {
+            for (size_t i = 0; i < count; i++) {
+                shardsMiniAccess(minis[m], pages[i]);
+            }
+        }
+    }
+    ok = ok && !traceFailed(trace);
+
+    if (ok) {
+        printf("politica,frames,frames_mini,tasa_fallos,error\n");
+        for (int i = 0; i < numMinis; i++) {
+            double error;
+            double ratio = shardsMiniMissRatio(minis[i], &error);
+            printf("%s,%d,%d,%.6f,%.6f\n", selected[i / numCounts]->name, frameCounts[i % numCounts],
+                   shardsMiniFrames(minis[i]), ratio, error);
+        }
+    }
+    for (int i = 0; minis != NULL && i < numMinis; i++) {
+        if (minis[i] != NULL) {
+            destroyShardsMini(minis[i]);
+        }
+    }
+    free(minis);
+    return ok;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: mrc [-s tasa] [-m maxPáginas] [-p política[,política...]|all]
+ *                       [-f frames[,frames|inicio:fin...]] -t traza
+ *              Sin -f escribe la curva LRU completa; con -f solo los tamaños indicados. -p necesita -s y -f.
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *selected[MAX_POLICIES];
+    int numSelected = 0;
+    int frameCounts[MAX_FRAME_COUNTS];
+    int numCounts = 0;
+    double rate = 0.0;
+    long maxPages = 0;
+    const char *tracePath = NULL;
+    bool valid = true;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:m:p:f:t:")) != -1) {
+        if (opt == 's') {
+            rate = atof(optarg);
+            valid = valid && rate > 0.0 && rate <= 1.0;
+        } else if (opt == 'm') {
+            maxPages = atol(optarg);
+            valid = valid && maxPages > 0;
+        } else if (opt == 'p') {
+            numSelected = parsePolicies(optarg, allPolicies, numAllPolicies, selected);
+            valid = valid && numSelected > 0;
+        } else if (opt == 'f') {
+            numCounts = parseFrameCounts(optarg, frameCounts);
+            valid = valid && numCounts > 0;
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            valid = false;
+        }
+    }
+    if (numSelected > 0 && (rate == 0.0 || maxPages > 0 || numCounts == 0)) {
+        valid = false;  // La simulación en miniatura necesita una tasa fija y tamaños concretos
+    }
+    for (int p = 0; p < numSelected && valid; p++) {
+        if (selected[p]->lookahead != NULL) {
+            fprintf(stderr, "La política %s necesita conocer la traza completa y no admite muestreo\n",
+                    selected[p]->name);
+            return 1;
+        }
+    }
+    if (!valid || tracePath == NULL) {
+        fprintf(stderr, "Uso: %s [-s tasa] [-m maxPáginas] [-p política[,política...]|all] "
+                        "[-f frames[,frames|inicio:fin...]] -t traza\n", argv[0]);
+        return 1;
+    }
+
+    TraceReader *trace = openTrace(tracePath);
+    if (trace == NULL) {
+        return 1;
+    }
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    bool ok = pages != NULL;
+    if (ok && numSelected > 0) {
+        ok = miniatureCurves(trace, pages, selected, numSelected, rate, frameCounts, numCounts);
+    } else if (ok && (rate > 0.0 || maxPages > 0)) {
+        ok = sampledCurve(trace, pages, rate > 0.0 ? rate : 1.0, (size_t)maxPages, frameCounts, numCounts);
+    } else if (ok) {
+        ok = exactCurve(trace, pages, frameCounts, numCounts);
+    }
+
+    free(pages);
+    closeTrace(trace);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,16 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Registro de los algoritmos de reemplazo disponibles para los programas que los enlazan todos
+ * (simulator.c, sweep.c). Un algoritmo nuevo se añade aquí y en policy.h.
+ */
+
+#include "policy.h"
+
+const PolicyOps *const allPolicies[] = { &lruPolicy, &clockPolicy, &lfuPolicy, &mtClockPolicy,
+                                         &shardedLruPolicy, &lruBatchPolicy, &lruHotPolicy, &carPolicy,
+                                         &lfuAgePolicy, &lfuTinyPolicy, &optPolicy,
+                                         &clockEnhancedPolicy };
+const int numAllPolicies = (int)(sizeof(allPolicies) / sizeof(allPolicies[0]));
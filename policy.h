@@ -0,0 +1,74 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Interfaz común de los algoritmos de reemplazo. Cada archivo de algoritmo (FIFO-LRU.c, LRU-CLOCK.c,
+ * OPR-LFU.c) mantiene sus tipos Frame/FrameList y sus funciones como privados (static) y exporta solo
+ * una tabla de operaciones PolicyOps. Así los tres pueden enlazarse en un mismo programa y un único
+ * driver (driver.c) puede alimentar con la misma traza a cualquiera de ellos.
+ */
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "stats.h"
+#include "prefetch.h"
+
+typedef struct PolicyImage PolicyImage;   // Imagen del estado dentro de un checkpoint (checkpoint.h)
+
+// Tabla de operaciones de un algoritmo de reemplazo
+typedef struct PolicyOps {
+    const char *name;                       // Nombre corto del algoritmo ("LRU", "CLOCK", "LFU")
+    void* (*create)(int numFrames);         // Crea el estado para numFrames frames (NULL si falla)
+    void (*destroy)(void *state);           // Libera el estado
+    bool (*access)(void *state, int page);  // Referencia una página; true si fue un acierto
+    int (*evict)(void *state);              // Desaloja la víctima del algoritmo; su página o -1 si vacía
+    const SimStats* (*stats)(void *state);  // Contadores acumulados
+    void (*print)(void *state);             // Imprime el estado de la memoria para depuración
+    bool (*save)(void *state, FILE *out);   // Escribe el estado en un checkpoint (NULL si no lo admite)
+    bool (*restore)(void *state, PolicyImage *image);  // Carga un estado guardado sobre uno recién creado
+    // Recibe por adelantado la entrada completa, en lotes y con count 0 al terminar, antes del primer
+    // access (NULL si el algoritmo no necesita conocer el futuro); false si no pudo prepararse
+    bool (*lookahead)(void *state, const int *pages, size_t count);
+    // Carga una página por adelantado sin referenciarla (NULL si el algoritmo no admite lectura
+    // anticipada); false si ya estaba en memoria o el algoritmo no la admitió
+    bool (*prefetch)(void *state, int page);
+    // Referencia una página para modificarla: como access, y además la deja sucia (NULL si el algoritmo
+    // no distingue escrituras, que entonces se simulan como lecturas)
+    bool (*write)(void *state, int page);
+} PolicyOps;
+
+// Instancia de un algoritmo: su tabla de operaciones y su estado
+typedef struct Policy {
+    const PolicyOps *ops;   // Operaciones del algoritmo
+    void *state;            // Estado creado por ops->create
+    int numFrames;          // Frames de la memoria simulada
+    Prefetcher prefetcher;  // Detector de la lectura anticipada (depth 0 si no se pidió)
+#ifdef POLICY_INSTRUMENT
+    LatencyHistogram latency;   // Latencia de cada acceso medida por el driver
+#endif
+} Policy;
+
+extern const PolicyOps lruPolicy;      // FIFO-LRU.c
+extern const PolicyOps lruBatchPolicy; // FIFO-LRU.c, promoción en lotes
+extern const PolicyOps lruHotPolicy;   // FIFO-LRU.c, sin promoción en la parte más reciente
+extern const PolicyOps clockPolicy;    // LRU-CLOCK.c
+extern const PolicyOps clockEnhancedPolicy;  // LRU-CLOCK.c, segunda oportunidad mejorada
+extern const PolicyOps lfuPolicy;      // OPR-LFU.c
+extern const PolicyOps lfuAgePolicy;   // OPR-LFU.c, con envejecimiento de frecuencias
+extern const PolicyOps lfuTinyPolicy;  // OPR-LFU.c, con envejecimiento y admisión TinyLFU
+extern const PolicyOps mtClockPolicy;  // MT-CLOCK.c
+extern const PolicyOps shardedLruPolicy;  // SHARDED-LRU.c
+extern const PolicyOps carPolicy;      // CAR-CLOCK.c
+extern const PolicyOps optPolicy;      // OPT-BELADY.c
+
+// Registro de todos los algoritmos enlazados en el simulador (policies.c)
+extern const PolicyOps *const allPolicies[];
+extern const int numAllPolicies;
+
+#endif
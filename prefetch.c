@@ -0,0 +1,63 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del detector de lectura anticipada declarado en prefetch.h.
+ */
+
+#include "prefetch.h"
+
+#include <limits.h>
+
+void initPrefetcher(Prefetcher *prefetcher, int depth) {
+    *prefetcher = (Prefetcher){0};
+    prefetcher->depth = depth;
+}
+
+/*
+ * Función: issueBatch
+ * Descripción: Llena un lote de páginas del patrón desde start y deja su primera página como marcador
+ *              del siguiente.
+ * Parámetros:
+ *  - prefetcher: Detector.
+ *  - start: Primera página del lote.
+ *  - batch: Recibe las páginas del lote.
+ * Retorna: Número de páginas del lote.
+ */
+static int issueBatch(Prefetcher *prefetcher, int64_t start, int *batch) {
+    int count = 0;
+    int64_t page = start;
+    while (count < prefetcher->depth && page >= 0 && page <= INT_MAX) {
+        batch[count++] = (int)page;
+        page += prefetcher->stride;
+    }
+    prefetcher->marker = start;
+    prefetcher->next = page;
+    if (count == 0) {
+        prefetcher->streaming = false;  // El patrón se sale del rango de páginas
+    } else {
+        prefetcher->batches++;
+    }
+    return count;
+}
+
+int predictPages(Prefetcher *prefetcher, int page, bool hit, int *batch) {
+    if (prefetcher->streaming && page == prefetcher->marker) {
+        prefetcher->lastMiss = page;  // Un fallo posterior en el patrón lo continúa
+        return issueBatch(prefetcher, prefetcher->next, batch);
+    }
+    if (hit) {
+        return 0;
+    }
+
+    // Fallo: el patrón se confirma si repite el salto del fallo anterior o es secuencial
+    int64_t stride = prefetcher->seen ? (int64_t)page - prefetcher->lastMiss : 0;
+    bool pattern = stride != 0 && stride >= -MAX_PREFETCH_STRIDE && stride <= MAX_PREFETCH_STRIDE &&
+                   (stride == 1 || stride == prefetcher->stride);
+    prefetcher->seen = true;
+    prefetcher->lastMiss = page;
+    prefetcher->stride = stride;
+    prefetcher->streaming = pattern;
+    return pattern ? issueBatch(prefetcher, (int64_t)page + stride, batch) : 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Detector de patrones para la lectura anticipada (read-ahead). Observa las referencias que recibe una
+ * política y, cuando dos fallos seguidos mantienen el mismo salto (o el salto es 1, acceso secuencial),
+ * propone un lote con las K páginas siguientes del patrón para cargarlas antes de que se pidan. A partir
+ * de ahí la lectura es asíncrona, como en el read-ahead de Linux: la referencia a la primera página del
+ * último lote (el marcador) lanza el lote siguiente, de modo que un recorrido secuencial va siempre
+ * unas K páginas por delante de la demanda sin volver a fallar. Un fallo fuera del patrón lo abandona.
+ *
+ * El detector solo decide qué páginas pedir: el driver las carga con ops->prefetch, y cada política
+ * cuenta por separado las páginas leídas por adelantado, las que llegaron a pedirse (útiles) y las que
+ * se desalojaron sin usarse (desperdiciadas), sin mezclarlas con los aciertos de demanda (ver stats.h).
+ */
+
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MAX_PREFETCH_DEPTH 256  // Páginas por lote como máximo (-a)
+#define MAX_PREFETCH_STRIDE 64  // Salto máximo entre fallos que se reconoce como patrón
+
+// Estado del detector de una política
+typedef struct Prefetcher {
+    int depth;          // Páginas por lote (K); 0 desactiva la lectura anticipada
+    bool seen;          // Ya hubo algún fallo
+    int lastMiss;       // Página del último fallo o del último marcador alcanzado
+    int64_t stride;     // Salto entre los dos últimos fallos
+    bool streaming;     // Hay un patrón confirmado en curso
+    int64_t marker;     // Página cuya referencia lanza el siguiente lote
+    int64_t next;       // Primera página del siguiente lote
+    uint64_t batches;   // Lotes propuestos
+} Prefetcher;
+
+/*
+ * Función: initPrefetcher
+ * Descripción: Prepara un detector sin historia.
+ * Parámetros:
+ *  - prefetcher: Detector.
+ *  - depth: Páginas por lote, entre 0 (desactivado) y MAX_PREFETCH_DEPTH.
+ */
+void initPrefetcher(Prefetcher *prefetcher, int depth);
+
+/*
+ * Función: predictPages
+ * Descripción: Registra una referencia de demanda y propone el lote de páginas que conviene leer por
+ *              adelantado tras ella. Las páginas que se saldrían del rango de un int se omiten.
+ * Parámetros:
+ *  - prefetcher: Detector.
+ *  - page: Página referenciada.
+ *  - hit: true si la referencia fue un acierto.
+ *  - batch: Recibe las páginas del lote (al menos prefetcher->depth posiciones).
+ * Retorna: Número de páginas del lote (0 si no hay que leer nada).
+ */
+int predictPages(Prefetcher *prefetcher, int page, bool hit, int *batch);
+
+#endif
@@ -0,0 +1,390 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Perfil de una traza en una sola pasada, sin simular ninguna política, para elegir el número de frames
+ * y el algoritmo antes de lanzar barridos. Cada lote de la traza se decodifica una vez con el lector
+ * compartido (trace.h) y pasa por tres análisis:
+ *  - Histograma de distancias de reutilización (distancias de pila LRU, stackdist.h) en intervalos de
+ *    potencias de 2, por stdout, con la tasa de aciertos de LRU para el límite superior de cada
+ *    intervalo como número de frames. Con -s se calcula sobre una muestra espacial de las páginas, como mrc -s, y con -n se omite.
+ *  - Número de páginas distintas: exacto con el histograma completo (lo da el propio analizador) y
+ *    estimado con HyperLogLog (hll.h) cuando el histograma se muestrea o se omite, con memoria fija.
+ *  - Conjunto de trabajo sobre ventanas deslizantes (-w): las páginas distintas entre las últimas N
+ *    referencias, escritas cada -i referencias en CSV (referencias,ventana,conjunto_trabajo) en el
+ *    archivo de -o. Cada ventana guarda sus N últimas páginas en un array circular y cuenta las
+ *    apariciones de cada página en una tabla hash de tamaño fijo, así que su memoria depende de N y no
+ *    de la traza.
+ * El resumen (referencias, páginas distintas y conjunto de trabajo medio de cada ventana) va por stderr.
+ * Con -s y -n la memoria queda acotada y el coste por referencia se acerca al de la decodificación.
+ *
+ * Compilación: gcc -O2 -march=native -pthread profile.c stackdist.c hll.c driver.c timeseries.c checkpoint.c \
+ *              remap.c prefetch.c trace.c stats.c -lm -o profile
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "driver.h"
+#include "hll.h"
+#include "stackdist.h"
+#include "trace.h"
+
+#define MAX_WINDOWS 16  // Ventanas deslizantes distintas en una ejecución (-w)
+
+// Ventana deslizante sobre las últimas length referencias
+typedef struct SlidingWindow {
+    uint64_t length;        // Referencias de la ventana
+    int *ring;              // Páginas de las últimas length referencias (array circular)
+    uint64_t cursor;        // Próxima posición del array circular
+    bool full;              // El array circular ya dio una vuelta
+    int *keys;              // Página de cada cubeta de la tabla de apariciones
+    uint32_t *counts;       // Apariciones de la página en la ventana (0 = cubeta vacía)
+    size_t mask;            // Cubetas - 1 (potencia de 2, al menos 2 * length)
+    uint64_t size;          // Páginas distintas en la ventana
+    double total;           // Suma del tamaño tras cada referencia, para la media
+} SlidingWindow;
+
+// Análisis en curso de una traza
+typedef struct Profile {
+    StackDistance *distances;   // Distancias de reutilización, o NULL con -n
+    double rate;                // Fracción de páginas muestreadas para las distancias (1 = todas)
+    uint64_t threshold;         // Una página entra en la muestra si su hash es menor
+    HyperLogLog *hll;           // Estimador de páginas distintas, o NULL si el conteo es exacto
+    SlidingWindow windows[MAX_WINDOWS];
+    int numWindows;             // Ventanas pedidas con -w
+    FILE *series;               // Salida del conjunto de trabajo, o NULL sin -w
+    uint64_t step;              // Referencias entre filas de la salida del conjunto de trabajo
+    uint64_t references;        // Referencias analizadas
+} Profile;
+
+/*
+ * Función: sampleHash
+ * Descripción: Hash de una página para el muestreo (finalizador fmix32 de MurmurHash3, como shards.c).
+ */
+static uint32_t sampleHash(int page) {
+    uint32_t h = (uint32_t)page;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/*
+ * Función: windowSlot
+ * Descripción: Cubeta de la tabla de apariciones de una ventana en la que se encuentra una página, o la
+ *              cubeta vacía donde debería insertarse.
+ * Parámetros:
+ *  - window: Ventana deslizante.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static size_t windowSlot(const SlidingWindow *window, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    size_t slot = (size_t)h & window->mask;
+    while (window->counts[slot] != 0 && window->keys[slot] != page) {
+        slot = (slot + 1) & window->mask;
+    }
+    return slot;
+}
+
+/*
+ * Función: windowRemove
+ * Descripción: Descuenta una aparición de una página que sale de la ventana; si era la última, la quita
+ *              de la tabla con borrado por corrimiento hacia atrás (como forgetPage en stackdist.c).
+ * Parámetros:
+ *  - window: Ventana deslizante.
+ *  - page: Página que sale (siempre está en la tabla).
+ */
+static void windowRemove(SlidingWindow *window, int page) {
+    size_t hole = windowSlot(window, page);
+    if (--window->counts[hole] != 0) {
+        return;
+    }
+    window->size--;
+    for (size_t next = (hole + 1) & window->mask; window->counts[next] != 0; next = (next + 1) & window->mask) {
+        uint32_t h = (uint32_t)window->keys[next] * 2654435761u;
+        h ^= h >> 16;
+        size_t home = (size_t)h & window->mask;
+        if (((next - home) & window->mask) >= ((next - hole) & window->mask)) {
+            window->keys[hole] = window->keys[next];
+            window->counts[hole] = window->counts[next];
+            window->counts[next] = 0;
+            hole = next;
+        }
+    }
+}
+
+/*
+ * Función: slideWindow
+ * Descripción: Avanza una ventana deslizante sobre un tramo de referencias.
+ * Parámetros:
+ *  - window: Ventana deslizante.
+ *  - pages: Páginas del tramo.
+ *  - count: Número de páginas del tramo.
+ */
+static void slideWindow(SlidingWindow *window, const int *pages, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (window->full) {
+            windowRemove(window, window->ring[window->cursor]);
+        }
+        size_t slot = windowSlot(window, pages[i]);
+        if (window->counts[slot]++ == 0) {
+            window->keys[slot] = pages[i];
+            window->size++;
+        }
+        window->ring[window->cursor] = pages[i];
+        if (++window->cursor == window->length) {
+            window->cursor = 0;
+            window->full = true;
+        }
+        window->total += (double)window->size;
+    }
+}
+
+/*
+ * Función: initWindow
+ * Descripción: Reserva el array circular y la tabla de apariciones de una ventana vacía.
+ * Parámetros:
+ *  - window: Ventana deslizante (a ceros).
+ *  - length: Referencias de la ventana.
+ * Retorna: false si no hay memoria.
+ */
+static bool initWindow(SlidingWindow *window, uint64_t length) {
+    size_t buckets = 1;
+    while (buckets < 2 * length) {
+        buckets <<= 1;
+    }
+    window->length = length;
+    window->mask = buckets - 1;
+    window->ring = (int *)malloc((size_t)length * sizeof(int));
+    window->keys = (int *)malloc(buckets * sizeof(int));
+    window->counts = (uint32_t *)calloc(buckets, sizeof(uint32_t));
+    return window->ring != NULL && window->keys != NULL && window->counts != NULL;
+}
+
+/*
+ * Función: analyzePages
+ * Descripción: Pasa un tramo de referencias por todos los análisis del perfil.
+ * Parámetros:
+ *  - profile: Análisis en curso.
+ *  - pages: Páginas del tramo.
+ *  - count: Número de páginas del tramo.
+ * Retorna: false si el histograma de distancias se quedó sin memoria.
+ */
+static bool analyzePages(Profile *profile, const int *pages, size_t count) {
+    bool ok = true;
+    if (profile->distances != NULL && profile->rate >= 1.0) {
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = recordAccess(profile->distances, pages[i]) >= 0;
+        }
+    } else if (profile->distances != NULL) {
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = sampleHash(pages[i]) >= profile->threshold || recordAccess(profile->distances, pages[i]) >= 0;
+        }
+    }
+    if (profile->hll != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            hllAdd(profile->hll, pages[i]);
+        }
+    }
+    for (int w = 0; w < profile->numWindows; w++) {
+        slideWindow(&profile->windows[w], pages, count);
+    }
+    profile->references += count;
+    return ok;
+}
+
+/*
+ * Función: profileTrace
+ * Descripción: Recorre la traza una vez, partiendo los lotes en los puntos en que toca escribir el
+ *              conjunto de trabajo de las ventanas.
+ * Parámetros:
+ *  - profile: Análisis en curso.
+ *  - trace: Traza abierta.
+ * Retorna: true si la traza se leyó completa y no faltó memoria.
+ */
+static bool profileTrace(Profile *profile, TraceReader *trace) {
+    int pages[TRACE_BATCH_SIZE];
+    size_t count;
+    bool ok = true;
+    while (ok && (count = readPages(trace, pages, TRACE_BATCH_SIZE)) > 0) {
+        const int *chunk = pages;
+        while (ok && count > 0) {
+            size_t length = count;
+            if (profile->series != NULL) {
+                uint64_t remaining = profile->step - profile->references % profile->step;
+                length = remaining < count ? (size_t)remaining : count;
+            }
+            ok = analyzePages(profile, chunk, length);
+            if (profile->series != NULL && profile->references % profile->step == 0) {
+                for (int w = 0; w < profile->numWindows; w++) {
+                    fprintf(profile->series, "%llu,%llu,%llu\n", (unsigned long long)profile->references,
+                            (unsigned long long)profile->windows[w].length,
+                            (unsigned long long)profile->windows[w].size);
+                }
+            }
+            chunk += length;
+            count -= length;
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para el análisis de distancias de reutilización\n");
+    }
+    return ok && !traceFailed(trace);
+}
+
+/*
+ * Función: printSummary
+ * Descripción: Escribe por stderr las referencias, las páginas distintas y el conjunto de trabajo medio
+ *              de cada ventana.
+ * Parámetros:
+ *  - profile: Análisis terminado.
+ */
+static void printSummary(const Profile *profile) {
+    if (profile->hll == NULL) {
+        fprintf(stderr, "Perfil: %llu referencias, %llu páginas distintas\n",
+                (unsigned long long)profile->references,
+                (unsigned long long)stackDistinctPages(profile->distances));
+    } else {
+        fprintf(stderr, "Perfil: %llu referencias, ~%.0f páginas distintas (HyperLogLog, error típico %.2f%%)\n",
+                (unsigned long long)profile->references, hllEstimate(profile->hll), 100.0 * hllError(profile->hll));
+    }
+    for (int w = 0; w < profile->numWindows && profile->references > 0; w++) {
+        fprintf(stderr, "Conjunto de trabajo con ventana %llu: medio %.1f páginas, final %llu\n",
+                (unsigned long long)profile->windows[w].length,
+                profile->windows[w].total / (double)profile->references,
+                (unsigned long long)profile->windows[w].size);
+    }
+}
+
+/*
+ * Función: destroyProfile
+ * Descripción: Libera los analizadores y las ventanas del perfil.
+ * Parámetros:
+ *  - profile: Análisis (los campos no reservados deben ser NULL).
+ */
+static void destroyProfile(Profile *profile) {
+    if (profile->distances != NULL) {
+        destroyStackDistance(profile->distances);
+    }
+    if (profile->hll != NULL) {
+        destroyHyperLogLog(profile->hll);
+    }
+    for (int w = 0; w < profile->numWindows; w++) {
+        free(profile->windows[w].ring);
+        free(profile->windows[w].keys);
+        free(profile->windows[w].counts);
+    }
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: profile [-s tasa | -n] [-w ventana[,ventana|inicio:fin...] -o salida [-i paso]] -t traza
+ *              Sin -i el conjunto de trabajo se escribe cada tantas referencias como tenga la ventana mayor.
+ */
+int main(int argc, char *argv[]) {
+    double rate = 1.0;
+    bool histogram = true;
+    int lengths[MAX_FRAME_COUNTS];
+    int numWindows = 0;
+    const char *seriesPath = NULL;
+    uint64_t step = 0;
+    const char *tracePath = NULL;
+    bool valid = true;
+    int opt;
+    while ((opt = getopt(argc, argv, "s:nw:o:i:t:")) != -1) {
+        if (opt == 's') {
+            rate = atof(optarg);
+            valid = valid && rate > 0.0 && rate <= 1.0;
+        } else if (opt == 'n') {
+            histogram = false;
+        } else if (opt == 'w') {
+            numWindows = parseFrameCounts(optarg, lengths);
+            valid = valid && numWindows > 0 && numWindows <= MAX_WINDOWS;
+        } else if (opt == 'o') {
+            seriesPath = optarg;
+        } else if (opt == 'i') {
+            step = strtoull(optarg, NULL, 10);
+            valid = valid && step > 0;
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            valid = false;
+        }
+    }
+    if ((numWindows > 0) != (seriesPath != NULL) || (step > 0 && numWindows == 0) || (!histogram && rate < 1.0)) {
+        valid = false;  // Las ventanas necesitan su archivo de salida; -s y -n se excluyen
+    }
+    if (!valid || tracePath == NULL) {
+        fprintf(stderr, "Uso: %s [-s tasa | -n] [-w ventana[,ventana|inicio:fin...] -o salida [-i paso]] -t traza\n"
+                        "Como mucho %d ventanas\n", argv[0], MAX_WINDOWS);
+        return 1;
+    }
+
+    Profile profile;
+    memset(&profile, 0, sizeof(profile));
+    profile.rate = rate;
+    profile.threshold = (uint64_t)(rate * 4294967296.0);
+    profile.numWindows = numWindows;
+    bool ok = true;
+    if (histogram) {
+        ok = (profile.distances = createStackDistance()) != NULL;
+    }
+    if (ok && (!histogram || rate < 1.0)) {
+        ok = (profile.hll = createHyperLogLog(HLL_DEFAULT_PRECISION)) != NULL;
+    }
+    profile.step = step;
+    for (int w = 0; w < numWindows; w++) {
+        ok = initWindow(&profile.windows[w], (uint64_t)lengths[w]) && ok;
+        if (step == 0 && (uint64_t)lengths[w] > profile.step) {
+            profile.step = (uint64_t)lengths[w];  // Por defecto, cada ventana mayor
+        }
+    }
+    if (!ok) {
+        fprintf(stderr, "No hay memoria para el perfil\n");
+        destroyProfile(&profile);
+        return 1;
+    }
+
+    TraceReader *trace = openTrace(tracePath);
+    if (trace == NULL) {
+        destroyProfile(&profile);
+        return 1;
+    }
+    if (seriesPath != NULL) {
+        profile.series = strcmp(seriesPath, "-") == 0 ? stdout : fopen(seriesPath, "w");
+        if (profile.series == NULL) {
+            perror(seriesPath);
+            closeTrace(trace);
+            destroyProfile(&profile);
+            return 1;
+        }
+        fprintf(profile.series, "referencias,ventana,conjunto_trabajo\n");
+    }
+
+    ok = profileTrace(&profile, trace);
+    if (ok && profile.distances != NULL) {
+        printDistanceHistogram(profile.distances, 1.0 / rate, stdout);
+    }
+    if (ok) {
+        printSummary(&profile);
+    }
+    if (profile.series != NULL && profile.series != stdout && fclose(profile.series) != 0) {
+        perror(seriesPath);
+        ok = false;
+    }
+    closeTrace(trace);
+    destroyProfile(&profile);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,178 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del renumerador de remap.h: una tabla hash de direccionamiento abierto con sondeo
+ * lineal (página original -> identificador) que se duplica al superar la mitad de ocupación, y un array
+ * con la página original de cada identificador. Las claves se mezclan con el finalizador de 64 bits de
+ * MurmurHash3, de modo que las páginas dispersas o alineadas no se agolpan en pocas posiciones.
+ */
+
+#include "remap.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NO_ID UINT32_MAX            // Posición libre de la tabla
+#define MIN_REMAP_CAPACITY 1024     // Posiciones iniciales de la tabla
+
+struct PageRemap {
+    int64_t *keys;          // Página original de cada posición
+    uint32_t *ids;          // Identificador de cada posición (NO_ID si está libre)
+    size_t capacity;        // Posiciones de la tabla (potencia de 2)
+    int64_t *originals;     // Página original de cada identificador
+    size_t reserved;        // Capacidad de originals
+    uint32_t count;         // Identificadores asignados
+};
+
+/*
+ * Función: slotOf
+ * Descripción: Posición inicial de una página en la tabla (finalizador fmix64 de MurmurHash3).
+ */
+static size_t slotOf(const PageRemap *remap, int64_t page) {
+    uint64_t h = (uint64_t)page;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (size_t)h & (remap->capacity - 1);
+}
+
+/*
+ * Función: allocateTable
+ * Descripción: Reserva una tabla vacía de capacity posiciones, sin tocar la actual.
+ * Retorna: false si no hay memoria.
+ */
+static bool allocateTable(size_t capacity, int64_t **keys, uint32_t **ids) {
+    *keys = (int64_t *)malloc(capacity * sizeof(int64_t));
+    *ids = (uint32_t *)malloc(capacity * sizeof(uint32_t));
+    if (*keys == NULL || *ids == NULL) {
+        free(*keys);
+        free(*ids);
+        return false;
+    }
+    memset(*ids, 0xff, capacity * sizeof(uint32_t));  // NO_ID en todas las posiciones
+    return true;
+}
+
+/*
+ * Función: growTable
+ * Descripción: Duplica la tabla y reinserta los identificadores desde originals.
+ * Parámetros:
+ *  - remap: Puntero al renumerador.
+ * Retorna: false si no hay memoria (la tabla anterior sigue siendo válida).
+ */
+static bool growTable(PageRemap *remap) {
+    int64_t *keys;
+    uint32_t *ids;
+    if (!allocateTable(remap->capacity * 2, &keys, &ids)) {
+        return false;
+    }
+    free(remap->keys);
+    free(remap->ids);
+    remap->keys = keys;
+    remap->ids = ids;
+    remap->capacity *= 2;
+    for (uint32_t id = 0; id < remap->count; id++) {
+        size_t slot = slotOf(remap, remap->originals[id]);
+        while (ids[slot] != NO_ID) {
+            slot = (slot + 1) & (remap->capacity - 1);
+        }
+        keys[slot] = remap->originals[id];
+        ids[slot] = id;
+    }
+    return true;
+}
+
+PageRemap* createRemap(uint64_t expected) {
+    PageRemap *remap = (PageRemap *)calloc(1, sizeof(PageRemap));
+    if (remap == NULL) {
+        return NULL;
+    }
+    remap->capacity = MIN_REMAP_CAPACITY;
+    while (remap->capacity < 2 * expected) {
+        remap->capacity <<= 1;
+    }
+    remap->reserved = remap->capacity / 2;
+    remap->originals = (int64_t *)malloc(remap->reserved * sizeof(int64_t));
+    if (remap->originals == NULL || !allocateTable(remap->capacity, &remap->keys, &remap->ids)) {
+        free(remap->originals);
+        free(remap);
+        return NULL;
+    }
+    return remap;
+}
+
+bool remapPages(PageRemap *remap, const int64_t *raw, int *pages, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        size_t mask = remap->capacity - 1;
+        size_t slot = slotOf(remap, raw[i]);
+        while (remap->ids[slot] != NO_ID && remap->keys[slot] != raw[i]) {
+            slot = (slot + 1) & mask;
+        }
+        if (remap->ids[slot] != NO_ID) {
+            pages[i] = (int)remap->ids[slot];
+            continue;
+        }
+
+        // Página nueva: siguiente identificador
+        if (remap->count == (uint32_t)INT32_MAX) {
+            fprintf(stderr, "Renumeración: más de %d páginas distintas\n", INT32_MAX);
+            return false;
+        }
+        if (remap->count == remap->reserved) {
+            int64_t *originals = (int64_t *)realloc(remap->originals, 2 * remap->reserved * sizeof(int64_t));
+            if (originals == NULL) {
+                fprintf(stderr, "Renumeración: no hay memoria para %u páginas\n", remap->count);
+                return false;
+            }
+            remap->originals = originals;
+            remap->reserved *= 2;
+        }
+        uint32_t id = remap->count++;
+        remap->originals[id] = raw[i];
+        remap->keys[slot] = raw[i];
+        remap->ids[slot] = id;
+        pages[i] = (int)id;
+        if (2 * (size_t)remap->count > remap->capacity && !growTable(remap)) {
+            fprintf(stderr, "Renumeración: no hay memoria para %u páginas\n", remap->count);
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t remapCount(const PageRemap *remap) {
+    return remap->count;
+}
+
+bool writeRemap(const PageRemap *remap, const char *path) {
+    FILE *out = fopen(path, "wb");
+    if (out == NULL) {
+        perror(path);
+        return false;
+    }
+    unsigned char header[REMAP_HEADER_SIZE] = {0};
+    uint32_t version = REMAP_VERSION;
+    uint64_t count = remap->count;
+    memcpy(header, REMAP_MAGIC, 4);
+    memcpy(header + 4, &version, sizeof(version));
+    memcpy(header + 8, &count, sizeof(count));
+    bool ok = fwrite(header, sizeof(header), 1, out) == 1 &&
+              fwrite(remap->originals, sizeof(int64_t), remap->count, out) == remap->count;
+    ok = fclose(out) == 0 && ok;
+    if (!ok) {
+        perror(path);
+    }
+    return ok;
+}
+
+void destroyRemap(PageRemap *remap) {
+    free(remap->keys);
+    free(remap->ids);
+    free(remap->originals);
+    free(remap);
+}
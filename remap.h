@@ -0,0 +1,86 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Renumeración de páginas a identificadores densos. Las trazas de producción traen números de página
+ * virtuales de 64 bits muy dispersos, que no caben en el int de los simuladores y reparten mal las
+ * claves de sus índices hash. El renumerador asigna a cada página distinta el siguiente identificador
+ * libre (0, 1, 2, ... en orden de primera aparición), lo que conserva exactamente la secuencia de
+ * reutilizaciones. Por tanto conserva los aciertos de las políticas cuyas decisiones solo dependen de esa
+ * secuencia y no del valor de las páginas (FIFO, LRU, CLOCK, LFU, CAR, OPT y sus variantes), pero no los
+ * de las que usan un hash de la página para decidir: LFU-TINY, cuyo sketch Count-Min cuenta a la página
+ * en las celdas que indica su hash, y LRU-SHARD, que elige por hash el fragmento de cada página. Las
+ * estimaciones muestreadas por hash (SHARDS en mrc, muestreo de profile) también eligen otra muestra.
+ *
+ * Se usa en flujo: cada lote leído con readRawPages se traduce con remapPages antes de simularlo o de
+ * escribirlo (trace-convert -m). La tabla inversa (identificador -> página original) se puede guardar
+ * en un archivo de mapa: cabecera de REMAP_HEADER_SIZE bytes con "PGMP", versión (u32) y número de
+ * páginas (u64), seguida de la página original de cada identificador (i64), en el orden de bytes de la
+ * máquina.
+ */
+
+#ifndef REMAP_H
+#define REMAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define REMAP_MAGIC "PGMP"      // Número mágico de los archivos de mapa
+#define REMAP_VERSION 1         // Versión del formato de mapa
+#define REMAP_HEADER_SIZE 16    // Bytes de la cabecera del mapa
+
+typedef struct PageRemap PageRemap;
+
+/*
+ * Función: createRemap
+ * Descripción: Crea un renumerador vacío.
+ * Parámetros:
+ *  - expected: Páginas distintas esperadas, para reservar la tabla de una vez (0 si no se sabe).
+ * Retorna: Puntero al renumerador, o NULL si no hay memoria.
+ */
+PageRemap* createRemap(uint64_t expected);
+
+/*
+ * Función: remapPages
+ * Descripción: Traduce un lote de páginas originales a identificadores densos, asignando uno nuevo a
+ *              cada página que no se había visto.
+ * Parámetros:
+ *  - remap: Puntero al renumerador.
+ *  - raw: Páginas originales.
+ *  - pages: Recibe el identificador de cada una.
+ *  - count: Número de páginas del lote.
+ * Retorna: false si no hay memoria o las páginas distintas no caben en un int (el motivo se informa
+ *          por stderr).
+ */
+bool remapPages(PageRemap *remap, const int64_t *raw, int *pages, size_t count);
+
+/*
+ * Función: remapCount
+ * Descripción: Número de páginas distintas vistas, que es también el próximo identificador.
+ * Parámetros:
+ *  - remap: Puntero al renumerador.
+ * Retorna: Páginas distintas.
+ */
+uint32_t remapCount(const PageRemap *remap);
+
+/*
+ * Función: writeRemap
+ * Descripción: Guarda la tabla inversa en un archivo de mapa.
+ * Parámetros:
+ *  - remap: Puntero al renumerador.
+ *  - path: Ruta del archivo de mapa.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+bool writeRemap(const PageRemap *remap, const char *path);
+
+/*
+ * Función: destroyRemap
+ * Descripción: Libera un renumerador.
+ * Parámetros:
+ *  - remap: Puntero al renumerador.
+ */
+void destroyRemap(PageRemap *remap);
+
+#endif
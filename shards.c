@@ -0,0 +1,414 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación de los estimadores por muestreo declarados en shards.h. Los 3 bits bajos del hash de
+ * una página eligen su grupo y los 29 altos son su valor de muestreo: la página se muestrea si ese
+ * valor es menor que el umbral de su grupo, de modo que la tasa de un grupo es umbral / 2^29.
+ */
+
+#include "shards.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "stackdist.h"
+
+#define SHARDS_GROUP_BITS 3                             // log2(SHARDS_GROUPS)
+#define SHARDS_SPACE (1u << (32 - SHARDS_GROUP_BITS))   // Valores de muestreo posibles por grupo
+#define SHARDS_BINS 8192                                // Intervalos del histograma de distancias
+#define SHARDS_CURVE_POINTS 1024                        // Puntos máximos de printShardsCurve
+#define T_95_GROUPS 2.365                               // t de Student 97.5% con SHARDS_GROUPS - 1 g.l.
+
+// Página muestreada y su valor de muestreo (montículo de máximos del muestreo de tamaño fijo)
+typedef struct ShardsEntry {
+    uint32_t value;     // Valor de muestreo de la página
+    int page;           // Número de la página
+} ShardsEntry;
+
+// Réplica independiente de la curva LRU sobre las páginas de un grupo
+typedef struct ShardsReplica {
+    StackDistance *stack;   // Distancias de pila entre las páginas muestreadas del grupo
+    uint32_t threshold;     // Se muestrean los valores < threshold
+    ShardsEntry *heap;      // Páginas muestreadas, la de mayor valor en la raíz (solo con maxPages)
+    size_t heapSize;        // Páginas en el montículo
+    double *bins;           // Peso de las referencias por intervalo de distancia estimada
+    uint64_t binWidth;      // Distancias por intervalo (se duplica al desbordar)
+    double coldWeight;      // Peso de los primeros accesos
+    double totalWeight;     // Peso de todas las referencias muestreadas
+} ShardsReplica;
+
+struct ShardsMrc {
+    ShardsReplica replicas[SHARDS_GROUPS];  // Una réplica por grupo de páginas
+    size_t maxPages;                        // Páginas muestreadas por réplica (0 = sin límite)
+    uint64_t references;                    // Referencias registradas, muestreadas o no
+};
+
+struct ShardsMini {
+    const PolicyOps *ops;               // Política simulada
+    void *sample;                       // Estado con toda la muestra
+    void *without[SHARDS_GROUPS];       // Estados con la muestra sin el grupo g
+    uint32_t threshold;                 // Umbral común a todos los grupos
+    int miniFrames;                     // Frames del estado con toda la muestra
+    uint64_t references;                // Referencias registradas, muestreadas o no
+};
+
+/*
+ * Función: sampleHash
+ * Descripción: Hash de una página para el muestreo (finalizador de MurmurHash3), independiente del
+ *              hash multiplicativo que usan los índices de páginas.
+ * Parámetros:
+ *  - page: Número de la página.
+ * Retorna: Hash de 32 bits.
+ */
+static uint32_t sampleHash(int page) {
+    uint32_t h = (uint32_t)page;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/*
+ * Función: rateThreshold
+ * Descripción: Umbral de muestreo de un grupo para una tasa dada.
+ * Parámetros:
+ *  - rate: Fracción de páginas muestreadas.
+ * Retorna: Umbral en [1, SHARDS_SPACE].
+ */
+static uint32_t rateThreshold(double rate) {
+    double threshold = rate * (double)SHARDS_SPACE + 0.5;
+    if (threshold < 1.0) {
+        return 1;
+    }
+    return threshold > (double)SHARDS_SPACE ? SHARDS_SPACE : (uint32_t)threshold;
+}
+
+/*
+ * Función: heapPush
+ * Descripción: Inserta una página en el montículo de máximos de una réplica.
+ * Parámetros:
+ *  - replica: Puntero a la réplica.
+ *  - value: Valor de muestreo de la página.
+ *  - page: Número de la página.
+ */
+static void heapPush(ShardsReplica *replica, uint32_t value, int page) {
+    size_t i = replica->heapSize++;
+    while (i > 0 && replica->heap[(i - 1) / 2].value < value) {
+        replica->heap[i] = replica->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    replica->heap[i].value = value;
+    replica->heap[i].page = page;
+}
+
+/*
+ * Función: heapPop
+ * Descripción: Quita la raíz (página de mayor valor) del montículo de una réplica.
+ * Parámetros:
+ *  - replica: Puntero a la réplica.
+ */
+static void heapPop(ShardsReplica *replica) {
+    ShardsEntry last = replica->heap[--replica->heapSize];
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= replica->heapSize) {
+            break;
+        }
+        if (child + 1 < replica->heapSize && replica->heap[child + 1].value > replica->heap[child].value) {
+            child++;
+        }
+        if (replica->heap[child].value <= last.value) {
+            break;
+        }
+        replica->heap[i] = replica->heap[child];
+        i = child;
+    }
+    if (replica->heapSize > 0) {
+        replica->heap[i] = last;
+    }
+}
+
+/*
+ * Función: shrinkSample
+ * Descripción: Baja el umbral de una réplica al mayor valor muestreado y descarta todas las páginas con
+ *              ese valor, hasta que la muestra vuelve a caber en maxPages.
+ * Parámetros:
+ *  - replica: Puntero a la réplica.
+ *  - maxPages: Máximo de páginas de la réplica.
+ */
+static void shrinkSample(ShardsReplica *replica, size_t maxPages) {
+    while (replica->heapSize > maxPages) {
+        replica->threshold = replica->heap[0].value;
+        while (replica->heapSize > 0 && replica->heap[0].value >= replica->threshold) {
+            forgetPage(replica->stack, replica->heap[0].page);
+            heapPop(replica);
+        }
+    }
+}
+
+/*
+ * Función: addDistance
+ * Descripción: Suma el peso de una referencia al intervalo de su distancia estimada, duplicando el
+ *              ancho de los intervalos mientras la distancia no quepa en el histograma.
+ * Parámetros:
+ *  - replica: Puntero a la réplica.
+ *  - distance: Distancia estimada (distancia medida / tasa).
+ *  - weight: Peso de la referencia (1 / tasa).
+ */
+static void addDistance(ShardsReplica *replica, double distance, double weight) {
+    uint64_t bin = (uint64_t)distance / replica->binWidth;
+    while (bin >= SHARDS_BINS) {
+        for (size_t i = 0; i < SHARDS_BINS / 2; i++) {
+            replica->bins[i] = replica->bins[2 * i] + replica->bins[2 * i + 1];
+        }
+        memset(replica->bins + SHARDS_BINS / 2, 0, (SHARDS_BINS / 2) * sizeof(double));
+        replica->binWidth *= 2;
+        bin /= 2;
+    }
+    replica->bins[bin] += weight;
+}
+
+/*
+ * Función: replicaMissRatio
+ * Descripción: Tasa de fallos estimada por una réplica, con la corrección SHARDS-adj.
+ * Parámetros:
+ *  - replica: Puntero a la réplica.
+ *  - references: Referencias totales de la traza.
+ *  - numFrames: Tamaño de la memoria.
+ * Retorna: Tasa de fallos en [0, 1].
+ */
+static double replicaMissRatio(const ShardsReplica *replica, uint64_t references, int64_t numFrames) {
+    // Las referencias esperadas que faltan en la muestra se cuentan como aciertos de distancia mínima
+    double hits = (double)references - replica->totalWeight;
+    uint64_t width = replica->binWidth;
+    for (uint64_t bin = 0; bin < SHARDS_BINS; bin++) {
+        uint64_t first = bin * width;
+        if ((int64_t)first > numFrames) {
+            break;
+        }
+        if ((int64_t)(first + width) <= numFrames + 1) {
+            hits += replica->bins[bin];
+        } else {
+            hits += replica->bins[bin] * (double)(numFrames + 1 - (int64_t)first) / (double)width;
+        }
+    }
+    double ratio = 1.0 - hits / (double)references;
+    return ratio < 0.0 ? 0.0 : (ratio > 1.0 ? 1.0 : ratio);
+}
+
+ShardsMrc* createShardsMrc(double rate, size_t maxPages) {
+    ShardsMrc *mrc = (ShardsMrc *)calloc(1, sizeof(ShardsMrc));
+    if (mrc == NULL) {
+        return NULL;
+    }
+    mrc->maxPages = maxPages > 0 ? (maxPages + SHARDS_GROUPS - 1) / SHARDS_GROUPS : 0;
+    bool ok = true;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        ShardsReplica *replica = &mrc->replicas[g];
+        replica->stack = createStackDistance();
+        replica->threshold = rateThreshold(rate);
+        replica->bins = (double *)calloc(SHARDS_BINS, sizeof(double));
+        replica->binWidth = 1;
+        if (mrc->maxPages > 0) {
+            replica->heap = (ShardsEntry *)malloc((mrc->maxPages + 1) * sizeof(ShardsEntry));
+            ok = ok && replica->heap != NULL;
+        }
+        ok = ok && replica->stack != NULL && replica->bins != NULL;
+    }
+    if (!ok) {
+        destroyShardsMrc(mrc);
+        return NULL;
+    }
+    return mrc;
+}
+
+void destroyShardsMrc(ShardsMrc *mrc) {
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        if (mrc->replicas[g].stack != NULL) {
+            destroyStackDistance(mrc->replicas[g].stack);
+        }
+        free(mrc->replicas[g].heap);
+        free(mrc->replicas[g].bins);
+    }
+    free(mrc);
+}
+
+bool shardsRecord(ShardsMrc *mrc, int page) {
+    mrc->references++;
+    uint32_t h = sampleHash(page);
+    ShardsReplica *replica = &mrc->replicas[h & (SHARDS_GROUPS - 1)];
+    uint32_t value = h >> SHARDS_GROUP_BITS;
+    if (value >= replica->threshold) {
+        return true;
+    }
+
+    // Cada página de la réplica representa SHARDS_GROUPS * SHARDS_SPACE / threshold páginas reales
+    double weight = (double)SHARDS_GROUPS * (double)SHARDS_SPACE / (double)replica->threshold;
+    int64_t distance = recordAccess(replica->stack, page);
+    if (distance < 0) {
+        return false;
+    }
+    replica->totalWeight += weight;
+    if (distance == 0) {
+        replica->coldWeight += weight;
+        if (mrc->maxPages > 0) {
+            heapPush(replica, value, page);
+            shrinkSample(replica, mrc->maxPages);
+        }
+    } else {
+        addDistance(replica, (double)distance * weight, weight);
+    }
+    return true;
+}
+
+double shardsMissRatio(const ShardsMrc *mrc, int64_t numFrames, double *error) {
+    double ratios[SHARDS_GROUPS];
+    double mean = 0.0;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        ratios[g] = mrc->references > 0 ? replicaMissRatio(&mrc->replicas[g], mrc->references, numFrames) : 0.0;
+        mean += ratios[g] / SHARDS_GROUPS;
+    }
+    if (error != NULL) {
+        double variance = 0.0;
+        for (int g = 0; g < SHARDS_GROUPS; g++) {
+            variance += (ratios[g] - mean) * (ratios[g] - mean) / (SHARDS_GROUPS - 1);
+        }
+        *error = T_95_GROUPS * sqrt(variance / SHARDS_GROUPS);
+    }
+    return mean;
+}
+
+void printShardsCurve(const ShardsMrc *mrc, FILE *output) {
+    // Paso común: el intervalo más ancho de las réplicas, o lo necesario para no pasar del máximo de puntos
+    uint64_t step = 1;
+    uint64_t last = 0;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        const ShardsReplica *replica = &mrc->replicas[g];
+        if (replica->binWidth > step) {
+            step = replica->binWidth;
+        }
+        for (uint64_t bin = SHARDS_BINS; bin > 0; bin--) {
+            if (replica->bins[bin - 1] != 0.0) {
+                if (bin * replica->binWidth > last) {
+                    last = bin * replica->binWidth;
+                }
+                break;
+            }
+        }
+    }
+    if (last / step > SHARDS_CURVE_POINTS) {
+        step = (last + SHARDS_CURVE_POINTS - 1) / SHARDS_CURVE_POINTS;
+    }
+
+    fprintf(output, "frames,tasa_fallos,error\n");
+    for (uint64_t frames = step; frames < last + step; frames += step) {
+        double error;
+        double ratio = shardsMissRatio(mrc, (int64_t)frames, &error);
+        fprintf(output, "%llu,%.6f,%.6f\n", (unsigned long long)frames, ratio, error);
+    }
+}
+
+double shardsRate(const ShardsMrc *mrc) {
+    double rate = 0.0;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        rate += (double)mrc->replicas[g].threshold / (double)SHARDS_SPACE / SHARDS_GROUPS;
+    }
+    return rate;
+}
+
+uint64_t shardsSampledPages(const ShardsMrc *mrc) {
+    uint64_t pages = 0;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        pages += stackDistinctPages(mrc->replicas[g].stack);
+    }
+    return pages;
+}
+
+ShardsMini* createShardsMini(const PolicyOps *ops, int numFrames, double rate) {
+    ShardsMini *mini = (ShardsMini *)calloc(1, sizeof(ShardsMini));
+    if (mini == NULL) {
+        return NULL;
+    }
+    mini->ops = ops;
+    mini->threshold = rateThreshold(rate);
+    double scaled = (double)numFrames * (double)mini->threshold / (double)SHARDS_SPACE;
+    mini->miniFrames = scaled < 1.0 ? 1 : (int)lround(scaled);
+
+    // Sin un grupo la muestra es (G-1)/G de la completa, y la memoria se reduce en la misma proporción
+    scaled = scaled * (SHARDS_GROUPS - 1) / SHARDS_GROUPS;
+    int withoutFrames = scaled < 1.0 ? 1 : (int)lround(scaled);
+    bool ok = (mini->sample = ops->create(mini->miniFrames)) != NULL;
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        ok = ok && (mini->without[g] = ops->create(withoutFrames)) != NULL;
+    }
+    if (!ok) {
+        destroyShardsMini(mini);
+        return NULL;
+    }
+    return mini;
+}
+
+void destroyShardsMini(ShardsMini *mini) {
+    if (mini->sample != NULL) {
+        mini->ops->destroy(mini->sample);
+    }
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        if (mini->without[g] != NULL) {
+            mini->ops->destroy(mini->without[g]);
+        }
+    }
+    free(mini);
+}
+
+void shardsMiniAccess(ShardsMini *mini, int page) {
+    mini->references++;
+    uint32_t h = sampleHash(page);
+    if ((h >> SHARDS_GROUP_BITS) >= mini->threshold) {
+        return;
+    }
+    mini->ops->access(mini->sample, page);
+    int group = (int)(h & (SHARDS_GROUPS - 1));
+    for (int g = 0; g < SHARDS_GROUPS; g++) {
+        if (g != group) {
+            mini->ops->access(mini->without[g], page);
+        }
+    }
+}
+
+double shardsMiniMissRatio(const ShardsMini *mini, double *error) {
+    // Los fallos se escalan a la traza completa dividiéndolos por las referencias esperadas en la
+    // muestra (como SHARDS-adj), no por las muestreadas: una página muy usada que cae en la muestra no
+    // infla así los aciertos
+    double rate = (double)mini->threshold / (double)SHARDS_SPACE;
+    double expected = rate * (double)mini->references;
+    double ratio = 0.0;
+    if (expected > 0.0) {
+        ratio = fmin(1.0, (double)mini->ops->stats(mini->sample)->misses / expected);
+    }
+    if (error != NULL) {
+        // Jackknife de grupos eliminados: var = (G-1)/G * sum (r_g - media)^2
+        double ratios[SHARDS_GROUPS];
+        double mean = 0.0;
+        for (int g = 0; g < SHARDS_GROUPS; g++) {
+            double misses = (double)mini->ops->stats(mini->without[g])->misses;
+            ratios[g] = expected > 0.0 ? fmin(1.0, misses / (expected * (SHARDS_GROUPS - 1) / SHARDS_GROUPS)) : 0.0;
+            mean += ratios[g] / SHARDS_GROUPS;
+        }
+        double variance = 0.0;
+        for (int g = 0; g < SHARDS_GROUPS; g++) {
+            variance += (ratios[g] - mean) * (ratios[g] - mean);
+        }
+        *error = 1.96 * sqrt(variance * (SHARDS_GROUPS - 1) / SHARDS_GROUPS);
+    }
+    return ratio;
+}
+
+int shardsMiniFrames(const ShardsMini *mini) {
+    return mini->miniFrames;
+}
@@ -0,0 +1,154 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Curvas de tasa de fallos aproximadas por muestreo espacial (SHARDS) para trazas demasiado grandes
+ * para el análisis exacto de stackdist.h. Una página entra en la muestra si su hash cae bajo un umbral,
+ * así que se muestrean todas las referencias de una fracción R de las páginas y ninguna de las demás;
+ * las distancias medidas entre páginas muestreadas, divididas por R, estiman las distancias reales.
+ *
+ * Dos estimadores:
+ *  - ShardsMrc: curva LRU completa por distancias de pila. Con maxPages > 0 la memoria queda acotada:
+ *    cuando la muestra supera ese número de páginas se baja el umbral y se descartan las páginas de hash
+ *    más alto (SHARDS de tamaño fijo). El déficit entre las referencias esperadas y las muestreadas se
+ *    suma a la distancia mínima (corrección SHARDS-adj).
+ *  - ShardsMini: simulación en miniatura de cualquier PolicyOps (por ejemplo CLOCK, que no es un
+ *    algoritmo de pila): la política se simula con round(numFrames * R) frames sobre la traza muestreada.
+ *
+ * Cada estimador informa de su propio error. El hash reparte las páginas en SHARDS_GROUPS grupos
+ * disjuntos: ShardsMrc mantiene una réplica independiente por grupo, da como estimación la media y
+ * como error el intervalo del 95% de esa media; ShardsMini simula además la muestra sin cada grupo y
+ * obtiene el error por jackknife de grupos eliminados.
+ */
+
+#ifndef SHARDS_H
+#define SHARDS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "policy.h"
+
+#define SHARDS_GROUPS 8     // Grupos disjuntos de páginas para estimar el error
+
+typedef struct ShardsMrc ShardsMrc;
+typedef struct ShardsMini ShardsMini;
+
+/*
+ * Función: createShardsMrc
+ * Descripción: Crea un estimador de la curva LRU por muestreo.
+ * Parámetros:
+ *  - rate: Fracción inicial de páginas muestreadas (0 < rate <= 1).
+ *  - maxPages: Máximo de páginas muestreadas a la vez (0 = sin límite, tasa fija).
+ * Retorna: Puntero al estimador creado, o NULL si no hay memoria.
+ */
+ShardsMrc* createShardsMrc(double rate, size_t maxPages);
+
+/*
+ * Función: destroyShardsMrc
+ * Descripción: Libera el estimador.
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ */
+void destroyShardsMrc(ShardsMrc *mrc);
+
+/*
+ * Función: shardsRecord
+ * Descripción: Registra una referencia de la traza (muestreada o no).
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ *  - page: Número de la página referenciada.
+ * Retorna: false si no hubo memoria.
+ */
+bool shardsRecord(ShardsMrc *mrc, int page);
+
+/*
+ * Función: shardsMissRatio
+ * Descripción: Tasa de fallos LRU estimada para una memoria de numFrames frames.
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ *  - numFrames: Tamaño de la memoria.
+ *  - error: Si no es NULL, recibe la semiamplitud del intervalo del 95%.
+ * Retorna: Tasa de fallos estimada.
+ */
+double shardsMissRatio(const ShardsMrc *mrc, int64_t numFrames, double *error);
+
+/*
+ * Función: printShardsCurve
+ * Descripción: Escribe la curva estimada en CSV ("frames,tasa_fallos,error") con pasos equiespaciados
+ *              hasta la mayor distancia estimada.
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ *  - output: Archivo de salida.
+ */
+void printShardsCurve(const ShardsMrc *mrc, FILE *output);
+
+/*
+ * Función: shardsRate
+ * Descripción: Fracción de páginas muestreada actualmente (baja con maxPages).
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ * Retorna: Tasa de muestreo efectiva.
+ */
+double shardsRate(const ShardsMrc *mrc);
+
+/*
+ * Función: shardsSampledPages
+ * Descripción: Páginas que forman la muestra en este momento.
+ * Parámetros:
+ *  - mrc: Puntero al estimador.
+ * Retorna: Número de páginas muestreadas.
+ */
+uint64_t shardsSampledPages(const ShardsMrc *mrc);
+
+/*
+ * Función: createShardsMini
+ * Descripción: Crea una simulación en miniatura de una política con tasa de muestreo fija.
+ * Parámetros:
+ *  - ops: Política simulada.
+ *  - numFrames: Tamaño de la memoria real que se quiere estimar.
+ *  - rate: Fracción de páginas muestreadas (0 < rate <= 1).
+ * Retorna: Puntero a la simulación creada, o NULL si no hay memoria.
+ */
+ShardsMini* createShardsMini(const PolicyOps *ops, int numFrames, double rate);
+
+/*
+ * Función: destroyShardsMini
+ * Descripción: Libera la simulación en miniatura y los estados de la política.
+ * Parámetros:
+ *  - mini: Puntero a la simulación.
+ */
+void destroyShardsMini(ShardsMini *mini);
+
+/*
+ * Función: shardsMiniAccess
+ * Descripción: Registra una referencia de la traza; solo las páginas muestreadas llegan a la política.
+ * Parámetros:
+ *  - mini: Puntero a la simulación.
+ *  - page: Número de la página referenciada.
+ */
+void shardsMiniAccess(ShardsMini *mini, int page);
+
+/*
+ * Función: shardsMiniMissRatio
+ * Descripción: Tasa de fallos estimada de la política en la memoria real.
+ * Parámetros:
+ *  - mini: Puntero a la simulación.
+ *  - error: Si no es NULL, recibe la semiamplitud del intervalo del 95% (jackknife).
+ * Retorna: Tasa de fallos de la simulación en miniatura.
+ */
+double shardsMiniMissRatio(const ShardsMini *mini, double *error);
+
+/*
+ * Función: shardsMiniFrames
+ * Descripción: Frames de la memoria en miniatura.
+ * Parámetros:
+ *  - mini: Puntero a la simulación.
+ * Retorna: round(numFrames * rate), al menos 1.
+ */
+int shardsMiniFrames(const ShardsMini *mini);
+
+#endif
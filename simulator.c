@@ -0,0 +1,23 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Simulador que enlaza los tres algoritmos de reemplazo (LRU, CLOCK y LFU) a través de la interfaz
+ * común de policy.h, de modo que un mismo binario ejecuta cualquiera de ellos sobre la misma entrada.
+ *
+ * Compilación: gcc -O2 -march=native -pthread -DPOLICY_LIBRARY simulator.c driver.c policies.c FIFO-LRU.c \
+ *              LRU-CLOCK.c framescan.c OPR-LFU.c MT-CLOCK.c SHARDED-LRU.c CAR-CLOCK.c OPT-BELADY.c \
+ *              timeseries.c checkpoint.c remap.c prefetch.c trace.c stats.c -o simulator
+ */
+
+#include "policy.h"
+#include "driver.h"
+
+/*
+ * Función: main
+ * Descripción: Uso: simulator [-p política[,política...]|all] [-t traza] [-d cadaN] [-q] [numFrames] [página ...]
+ */
+int main(int argc, char *argv[]) {
+    return runDriver(argc, argv, allPolicies, numAllPolicies);
+}
@@ -0,0 +1,351 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del analizador de distancias de pila declarado en stackdist.h. Un índice hash con
+ * direccionamiento abierto guarda la última marca de tiempo de cada página; el árbol de Fenwick tiene
+ * un 1 en la marca del último acceso de cada página, de modo que la suma entre dos marcas es el número
+ * de páginas distintas referenciadas entre ellas.
+ */
+
+#include "stackdist.h"
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define STACK_MIN_CAPACITY 1024    // Marcas de tiempo mínimas entre compactaciones
+#define STACK_MIN_TABLE 1024       // Cubetas iniciales del índice página -> marca
+
+struct StackDistance {
+    // Índice página -> marca del último acceso (direccionamiento abierto, sondeo lineal)
+    int *keys;              // Página de cada cubeta
+    uint64_t *stamps;       // Marca + 1 del último acceso (0 = cubeta vacía)
+    size_t tableSize;       // Número de cubetas (potencia de 2)
+    size_t distinct;        // Páginas distintas registradas
+
+    // Marcas de tiempo vivas
+    int32_t *tree;          // Árbol de Fenwick (índices desde 1) sobre las marcas
+    int *pageAt;            // Página referenciada en cada marca
+    size_t capacity;        // Marcas disponibles antes de compactar
+    size_t now;             // Próxima marca por asignar
+
+    // Resultado
+    uint64_t *histogram;    // histogram[d]: referencias con distancia de pila d
+    size_t histogramSize;   // Entradas reservadas del histograma
+    uint64_t accesses;      // Referencias registradas
+};
+
+/*
+ * Función: hashSlot
+ * Descripción: Primera cubeta del índice en la que se busca una página.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static size_t hashSlot(const StackDistance *analyzer, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (size_t)h & (analyzer->tableSize - 1);
+}
+
+/*
+ * Función: findSlot
+ * Descripción: Busca la cubeta de una página, o la cubeta vacía donde debería insertarse.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - page: Número de la página.
+ * Retorna: Índice de la cubeta.
+ */
+static size_t findSlot(const StackDistance *analyzer, int page) {
+    size_t slot = hashSlot(analyzer, page);
+    while (analyzer->stamps[slot] != 0 && analyzer->keys[slot] != page) {
+        slot = (slot + 1) & (analyzer->tableSize - 1);
+    }
+    return slot;
+}
+
+/*
+ * Función: growTable
+ * Descripción: Duplica el índice página -> marca y reinserta todas las páginas.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ * Retorna: true si hubo memoria suficiente.
+ */
+static bool growTable(StackDistance *analyzer) {
+    int *oldKeys = analyzer->keys;
+    uint64_t *oldStamps = analyzer->stamps;
+    size_t oldSize = analyzer->tableSize;
+
+    analyzer->tableSize = oldSize * 2;
+    analyzer->keys = (int *)malloc(analyzer->tableSize * sizeof(int));
+    analyzer->stamps = (uint64_t *)calloc(analyzer->tableSize, sizeof(uint64_t));
+    if (analyzer->keys == NULL || analyzer->stamps == NULL) {
+        free(analyzer->keys);
+        free(analyzer->stamps);
+        analyzer->keys = oldKeys;
+        analyzer->stamps = oldStamps;
+        analyzer->tableSize = oldSize;
+        return false;
+    }
+    for (size_t i = 0; i < oldSize; i++) {
+        if (oldStamps[i] != 0) {
+            size_t slot = findSlot(analyzer, oldKeys[i]);
+            analyzer->keys[slot] = oldKeys[i];
+            analyzer->stamps[slot] = oldStamps[i];
+        }
+    }
+    free(oldKeys);
+    free(oldStamps);
+    return true;
+}
+
+/*
+ * Función: fenwickAdd
+ * Descripción: Suma delta a la posición de una marca en el árbol de Fenwick.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - stamp: Marca de tiempo (desde 0).
+ *  - delta: Valor a sumar.
+ */
+static void fenwickAdd(StackDistance *analyzer, size_t stamp, int32_t delta) {
+    for (size_t i = stamp + 1; i <= analyzer->capacity; i += i & (~i + 1)) {
+        analyzer->tree[i] += delta;
+    }
+}
+
+/*
+ * Función: fenwickPrefix
+ * Descripción: Suma de las marcas vivas en [0, stamp].
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - stamp: Última marca incluida.
+ * Retorna: Número de marcas vivas hasta stamp.
+ */
+static int64_t fenwickPrefix(const StackDistance *analyzer, size_t stamp) {
+    int64_t sum = 0;
+    for (size_t i = stamp + 1; i > 0; i -= i & (~i + 1)) {
+        sum += analyzer->tree[i];
+    }
+    return sum;
+}
+
+/*
+ * Función: compactStamps
+ * Descripción: Renumera las marcas vivas de forma consecutiva (conservando su orden) y reconstruye el
+ *              árbol en O(n). Deja al menos tantas marcas libres como páginas distintas hay.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ * Retorna: true si hubo memoria suficiente.
+ */
+static bool compactStamps(StackDistance *analyzer) {
+    size_t capacity = 2 * analyzer->distinct;
+    if (capacity < STACK_MIN_CAPACITY) {
+        capacity = STACK_MIN_CAPACITY;
+    }
+    int *pageAt = (int *)malloc(capacity * sizeof(int));
+    int32_t *tree = (int32_t *)calloc(capacity + 1, sizeof(int32_t));
+    if (pageAt == NULL || tree == NULL) {
+        free(pageAt);
+        free(tree);
+        return false;
+    }
+
+    size_t live = 0;
+    for (size_t stamp = 0; stamp < analyzer->now; stamp++) {
+        int page = analyzer->pageAt[stamp];
+        size_t slot = findSlot(analyzer, page);
+        if (analyzer->stamps[slot] == stamp + 1) {
+            pageAt[live] = page;
+            analyzer->stamps[slot] = live + 1;
+            live++;
+        }
+    }
+
+    // Construcción lineal del árbol con un 1 en cada marca viva
+    for (size_t i = 1; i <= capacity; i++) {
+        tree[i] += (i <= live) ? 1 : 0;
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= capacity) {
+            tree[parent] += tree[i];
+        }
+    }
+
+    free(analyzer->pageAt);
+    free(analyzer->tree);
+    analyzer->pageAt = pageAt;
+    analyzer->tree = tree;
+    analyzer->capacity = capacity;
+    analyzer->now = live;
+    return true;
+}
+
+StackDistance* createStackDistance(void) {
+    StackDistance *analyzer = (StackDistance *)calloc(1, sizeof(StackDistance));
+    if (analyzer == NULL) {
+        return NULL;
+    }
+    analyzer->tableSize = STACK_MIN_TABLE;
+    analyzer->keys = (int *)malloc(analyzer->tableSize * sizeof(int));
+    analyzer->stamps = (uint64_t *)calloc(analyzer->tableSize, sizeof(uint64_t));
+    analyzer->capacity = STACK_MIN_CAPACITY;
+    analyzer->tree = (int32_t *)calloc(analyzer->capacity + 1, sizeof(int32_t));
+    analyzer->pageAt = (int *)malloc(analyzer->capacity * sizeof(int));
+    analyzer->histogramSize = STACK_MIN_CAPACITY;
+    analyzer->histogram = (uint64_t *)calloc(analyzer->histogramSize, sizeof(uint64_t));
+    if (analyzer->keys == NULL || analyzer->stamps == NULL || analyzer->tree == NULL ||
+        analyzer->pageAt == NULL || analyzer->histogram == NULL) {
+        destroyStackDistance(analyzer);
+        return NULL;
+    }
+    return analyzer;
+}
+
+void destroyStackDistance(StackDistance *analyzer) {
+    free(analyzer->keys);
+    free(analyzer->stamps);
+    free(analyzer->tree);
+    free(analyzer->pageAt);
+    free(analyzer->histogram);
+    free(analyzer);
+}
+
+int64_t recordAccess(StackDistance *analyzer, int page) {
+    if (2 * (analyzer->distinct + 1) > analyzer->tableSize && !growTable(analyzer)) {
+        return -1;
+    }
+    if (analyzer->now == analyzer->capacity && !compactStamps(analyzer)) {
+        return -1;
+    }
+
+    size_t slot = findSlot(analyzer, page);
+    int64_t distance = 0;
+    if (analyzer->stamps[slot] != 0) {
+        // Páginas distintas usadas después del último acceso, más la propia página
+        size_t last = (size_t)(analyzer->stamps[slot] - 1);
+        distance = fenwickPrefix(analyzer, analyzer->now - 1) - fenwickPrefix(analyzer, last) + 1;
+        fenwickAdd(analyzer, last, -1);
+
+        if ((size_t)distance >= analyzer->histogramSize) {
+            size_t size = analyzer->histogramSize;
+            while (size <= (size_t)distance) {
+                size *= 2;
+            }
+            uint64_t *histogram = (uint64_t *)realloc(analyzer->histogram, size * sizeof(uint64_t));
+            if (histogram == NULL) {
+                return -1;
+            }
+            memset(histogram + analyzer->histogramSize, 0,
+                   (size - analyzer->histogramSize) * sizeof(uint64_t));
+            analyzer->histogram = histogram;
+            analyzer->histogramSize = size;
+        }
+        analyzer->histogram[distance]++;
+    } else {
+        analyzer->keys[slot] = page;
+        analyzer->distinct++;
+    }
+
+    fenwickAdd(analyzer, analyzer->now, 1);
+    analyzer->pageAt[analyzer->now] = page;
+    analyzer->stamps[slot] = analyzer->now + 1;
+    analyzer->now++;
+    analyzer->accesses++;
+    return distance;
+}
+
+void forgetPage(StackDistance *analyzer, int page) {
+    size_t hole = findSlot(analyzer, page);
+    if (analyzer->stamps[hole] == 0) {
+        return;
+    }
+    fenwickAdd(analyzer, (size_t)(analyzer->stamps[hole] - 1), -1);
+    analyzer->distinct--;
+
+    // Borrado con corrimiento hacia atrás: ninguna página queda separada de su cubeta inicial por un hueco
+    size_t mask = analyzer->tableSize - 1;
+    for (size_t next = (hole + 1) & mask; analyzer->stamps[next] != 0; next = (next + 1) & mask) {
+        size_t home = hashSlot(analyzer, analyzer->keys[next]);
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            analyzer->keys[hole] = analyzer->keys[next];
+            analyzer->stamps[hole] = analyzer->stamps[next];
+            hole = next;
+        }
+    }
+    analyzer->stamps[hole] = 0;
+}
+
+double missRatioAt(const StackDistance *analyzer, int64_t numFrames) {
+    if (analyzer->accesses == 0) {
+        return 0.0;
+    }
+    uint64_t hits = 0;
+    for (size_t d = 1; d < analyzer->histogramSize && (int64_t)d <= numFrames; d++) {
+        hits += analyzer->histogram[d];
+    }
+    return (double)(analyzer->accesses - hits) / (double)analyzer->accesses;
+}
+
+void hitsAtSizes(const StackDistance *analyzer, const int64_t *sizes, uint64_t *hits, size_t count) {
+    uint64_t total = 0;
+    size_t d = 1;
+    for (size_t i = 0; i < count; i++) {
+        for (; d < analyzer->histogramSize && (int64_t)d <= sizes[i]; d++) {
+            total += analyzer->histogram[d];
+        }
+        hits[i] = total;
+    }
+}
+
+void printMissRatioCurve(const StackDistance *analyzer, FILE *output) {
+    fprintf(output, "frames,tasa_fallos\n");
+    if (analyzer->accesses == 0) {
+        return;
+    }
+    uint64_t hits = 0;
+    for (size_t d = 1; d < analyzer->histogramSize; d++) {
+        if (analyzer->histogram[d] != 0) {
+            hits += analyzer->histogram[d];
+            fprintf(output, "%zu,%.6f\n", d,
+                    (double)(analyzer->accesses - hits) / (double)analyzer->accesses);
+        }
+    }
+}
+
+void printDistanceHistogram(const StackDistance *analyzer, double scale, FILE *output) {
+    fprintf(output, "distancia_min,distancia_max,referencias,tasa_aciertos_lru\n");
+    if (analyzer->accesses == 0) {
+        return;
+    }
+    uint64_t hits = 0;
+    for (size_t d = 1; d < analyzer->histogramSize; d++) {
+        hits += analyzer->histogram[d];
+    }
+    double total = (double)analyzer->accesses;
+    fprintf(output, "0,0,%.0f,0.000000\n", (double)(analyzer->accesses - hits) * scale);
+
+    // Una fila por intervalo [2^k, 2^(k+1) - 1] de distancias escaladas con alguna referencia
+    hits = 0;
+    size_t d = 1;
+    for (uint64_t low = 1; d < analyzer->histogramSize; low *= 2) {
+        uint64_t bucket = 0;
+        for (; d < analyzer->histogramSize && (double)d * scale < (double)(2 * low); d++) {
+            bucket += analyzer->histogram[d];
+        }
+        if (bucket > 0) {
+            hits += bucket;
+            fprintf(output, "%llu,%llu,%.0f,%.6f\n", (unsigned long long)low, (unsigned long long)(2 * low - 1),
+                    (double)bucket * scale, (double)hits / total);
+        }
+    }
+}
+
+uint64_t stackAccesses(const StackDistance *analyzer) {
+    return analyzer->accesses;
+}
+
+uint64_t stackDistinctPages(const StackDistance *analyzer) {
+    return analyzer->distinct;
+}
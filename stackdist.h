@@ -0,0 +1,127 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Analizador de distancias de pila de Mattson para LRU. La distancia de pila de una referencia es la
+ * posición (empezando en 1) que ocupa su página en la lista LRU justo antes del acceso, es decir, la
+ * posición desde la que moveToHead la llevaría al frente; una memoria de C frames acierta exactamente
+ * las referencias con distancia <= C. Con el histograma de distancias de una sola pasada se obtiene la
+ * tasa de fallos LRU para todos los tamaños de memoria a la vez.
+ *
+ * Cada página guarda la marca de tiempo de su último acceso y un árbol de Fenwick sobre las marcas de
+ * tiempo cuenta cuántas páginas distintas se usaron después, con coste O(log n) por referencia. Cuando
+ * las marcas se agotan se renumeran de forma compacta, así la memoria es proporcional al número de
+ * páginas distintas y no a la longitud de la traza.
+ */
+
+#ifndef STACKDIST_H
+#define STACKDIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+typedef struct StackDistance StackDistance;
+
+/*
+ * Función: createStackDistance
+ * Descripción: Crea un analizador de distancias de pila vacío.
+ * Retorna: Puntero al analizador creado, o NULL si no hay memoria.
+ */
+StackDistance* createStackDistance(void);
+
+/*
+ * Función: destroyStackDistance
+ * Descripción: Libera el analizador y su histograma.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ */
+void destroyStackDistance(StackDistance *analyzer);
+
+/*
+ * Función: recordAccess
+ * Descripción: Registra una referencia y acumula su distancia en el histograma.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - page: Número de la página referenciada.
+ * Retorna: Distancia de pila (>= 1), 0 si es el primer acceso a la página, o -1 si no hay memoria.
+ */
+int64_t recordAccess(StackDistance *analyzer, int page);
+
+/*
+ * Función: forgetPage
+ * Descripción: Olvida una página: deja de contar en las distancias de las demás y su próximo acceso
+ *              será un primer acceso. Lo usa el muestreo de tamaño fijo (shards.c) al descartar páginas.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - page: Número de la página.
+ */
+void forgetPage(StackDistance *analyzer, int page);
+
+/*
+ * Función: missRatioAt
+ * Descripción: Tasa de fallos LRU para una memoria de numFrames frames según el histograma acumulado.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - numFrames: Tamaño de la memoria.
+ * Retorna: Fallos / accesos (0 si no hubo accesos).
+ */
+double missRatioAt(const StackDistance *analyzer, int64_t numFrames);
+
+/*
+ * Función: hitsAtSizes
+ * Descripción: Aciertos LRU acumulados para varios tamaños de memoria, en una sola pasada por el histograma
+ *              (missRatioAt lo recorre entero para cada tamaño).
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - sizes: Tamaños de memoria en frames, en orden creciente.
+ *  - hits: Recibe, para cada tamaño, las referencias con distancia de pila <= tamaño.
+ *  - count: Número de tamaños.
+ */
+void hitsAtSizes(const StackDistance *analyzer, const int64_t *sizes, uint64_t *hits, size_t count);
+
+/*
+ * Función: printMissRatioCurve
+ * Descripción: Escribe la curva completa de tasa de fallos en CSV ("frames,tasa_fallos"), con un punto por
+ *              cada tamaño de memoria en el que la curva cambia; el último es el de memoria ilimitada,
+ *              donde solo quedan los fallos en frío.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - output: Archivo de salida.
+ */
+void printMissRatioCurve(const StackDistance *analyzer, FILE *output);
+
+/*
+ * Función: printDistanceHistogram
+ * Descripción: Escribe el histograma de distancias de pila en CSV
+ *              ("distancia_min,distancia_max,referencias,tasa_aciertos_lru"), agrupado en intervalos de
+ *              potencias de 2. La primera fila (0,0) son los primeros accesos a cada página, y la tasa de
+ *              aciertos de cada fila es la de LRU con distancia_max frames.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ *  - scale: Inverso de la tasa de muestreo espacial de las páginas registradas (1 sin muestreo); las
+ *           distancias y las referencias se multiplican por él para estimar las de la traza completa.
+ *  - output: Archivo de salida.
+ */
+void printDistanceHistogram(const StackDistance *analyzer, double scale, FILE *output);
+
+/*
+ * Función: stackAccesses
+ * Descripción: Número de referencias registradas.
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ * Retorna: Referencias registradas.
+ */
+uint64_t stackAccesses(const StackDistance *analyzer);
+
+/*
+ * Función: stackDistinctPages
+ * Descripción: Número de páginas distintas registradas y no olvidadas (sin forgetPage, los fallos en frío).
+ * Parámetros:
+ *  - analyzer: Puntero al analizador.
+ * Retorna: Páginas distintas.
+ */
+uint64_t stackDistinctPages(const StackDistance *analyzer);
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del resumen de contadores declarado en stats.h.
+ */
+
+#include "stats.h"
+
+#include <stdio.h>
+#include <inttypes.h>
+
+double hitRatio(const SimStats *stats) {
+    return stats->accesses == 0 ? 0.0 : (double)stats->hits / (double)stats->accesses;
+}
+
+void printStats(const char *policy, int numFrames, const SimStats *stats) {
+    printf("%s frames=%d accesos=%" PRIu64 " aciertos=%" PRIu64 " fallos=%" PRIu64
+           " desalojos=%" PRIu64 " tasa_aciertos=%.6f\n",
+           policy, numFrames, stats->accesses, stats->hits, stats->misses,
+           stats->evictions, hitRatio(stats));
+    if (stats->prefetches > 0) {
+        printf("%s lectura_anticipada=%" PRIu64 " utiles=%" PRIu64 " desperdiciadas=%" PRIu64
+               " tasa_utiles=%.6f\n", policy, stats->prefetches, stats->prefetchHits, stats->prefetchWasted,
+               (double)stats->prefetchHits / (double)stats->prefetches);
+    }
+    if (stats->writes > 0 || stats->dirtyEvictions > 0) {
+        double grouped = (double)stats->writebackIos * WRITEBACK_IO_US +
+                         (double)stats->writebackPages * WRITEBACK_PAGE_US;
+        double single = (double)stats->dirtyEvictions * (WRITEBACK_IO_US + WRITEBACK_PAGE_US);
+        printf("%s escrituras=%" PRIu64 " desalojos_sucios=%" PRIu64 " paginas_escritas=%" PRIu64
+               " operaciones_disco=%" PRIu64 " coste_escritura_ms=%.3f sin_agrupar_ms=%.3f\n",
+               policy, stats->writes, stats->dirtyEvictions, stats->writebackPages, stats->writebackIos,
+               grouped / 1000.0, single / 1000.0);
+    }
+}
+
+void recordWriteBack(WriteBack *buffer, SimStats *stats, int page) {
+    stats->dirtyEvictions++;
+    int neighbours = 0;
+    for (int i = 0; i < buffer->count; i++) {
+        int64_t distance = (int64_t)buffer->pages[i] - page;
+        if (distance == 0) {
+            return;  // Ya pendiente: se escribirá una vez, con el contenido más reciente
+        }
+        neighbours += distance == 1 || distance == -1;
+    }
+    stats->writebackPages++;
+    if (neighbours == 0) {
+        stats->writebackIos++;  // Tramo nuevo
+    } else if (neighbours == 2) {
+        stats->writebackIos--;  // Une dos tramos en una sola operación (con un vecino solo lo prolonga)
+    }
+    buffer->pages[buffer->count++] = page;
+    if (buffer->count == WRITEBACK_BATCH) {
+        buffer->count = 0;  // Vaciado: las escrituras ya están contadas
+    }
+}
+
+void addStats(SimStats *total, const SimStats *stats) {
+    total->accesses += stats->accesses;
+    total->hits += stats->hits;
+    total->misses += stats->misses;
+    total->evictions += stats->evictions;
+    total->prefetches += stats->prefetches;
+    total->prefetchHits += stats->prefetchHits;
+    total->prefetchWasted += stats->prefetchWasted;
+    total->writes += stats->writes;
+    total->dirtyEvictions += stats->dirtyEvictions;
+    total->writebackPages += stats->writebackPages;
+    total->writebackIos += stats->writebackIos;
+#ifdef POLICY_INSTRUMENT
+    total->lookups += stats->lookups;
+    total->lookupSteps += stats->lookupSteps;
+    total->handSteps += stats->handSteps;
+    total->scanSteps += stats->scanSteps;
+#endif
+}
+
+#ifdef POLICY_INSTRUMENT
+/*
+ * Función: latencyPercentile
+ * Descripción: Cota superior de la latencia por debajo de la cual queda una fracción de los accesos.
+ * Parámetros:
+ *  - latency: Histograma de latencias.
+ *  - fraction: Fracción de los accesos (0.5 para la mediana).
+ * Retorna: Límite superior en ns de la cubeta que contiene el percentil, o 0 si no hay accesos.
+ */
+static uint64_t latencyPercentile(const LatencyHistogram *latency, double fraction) {
+    uint64_t total = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        total += latency->counts[b];
+    }
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += latency->counts[b];
+        if (seen > 0 && (double)seen >= fraction * (double)total) {
+            return b == 0 ? 0 : (b == LATENCY_BUCKETS - 1 ? UINT64_MAX : ((uint64_t)1 << b) - 1);
+        }
+    }
+    return 0;
+}
+#endif
+
+void printInstrumentation(const char *policy, const SimStats *stats, const LatencyHistogram *latency) {
+#ifdef POLICY_INSTRUMENT
+    double evictions = stats->evictions > 0 ? (double)stats->evictions : 1.0;
+    printf("%s busquedas=%" PRIu64 " pasos_por_busqueda=%.3f pasos_reloj_por_desalojo=%.3f"
+           " cubetas_por_desalojo=%.3f latencia_ns p50<=%" PRIu64 " p90<=%" PRIu64 " p99<=%" PRIu64
+           " p999<=%" PRIu64 " max<=%" PRIu64 "\n",
+           policy, stats->lookups, stats->lookups > 0 ? (double)stats->lookupSteps / (double)stats->lookups : 0.0,
+           (double)stats->handSteps / evictions, (double)stats->scanSteps / evictions,
+           latencyPercentile(latency, 0.5), latencyPercentile(latency, 0.9), latencyPercentile(latency, 0.99),
+           latencyPercentile(latency, 0.999), latencyPercentile(latency, 1.0));
+#else
+    (void)policy;
+    (void)stats;
+    (void)latency;
+#endif
+}
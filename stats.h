@@ -0,0 +1,138 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Contadores de la simulación compartidos por los tres algoritmos de reemplazo. Cada lista de frames
+ * acumula sus accesos, aciertos, fallos y desalojos; al final de la ejecución se imprime un único
+ * resumen en lugar del estado completo de la memoria tras cada acceso.
+ *
+ * Al compilar con -DPOLICY_INSTRUMENT los contadores incluyen además el trabajo de la ruta caliente
+ * (frames recorridos al buscar una página, pasos del puntero del reloj, cubetas de frecuencia
+ * recorridas por LFU) y el driver mide la latencia de cada acceso en un histograma logarítmico.
+ * Sin esa opción los campos no existen y la macro INSTRUMENT no genera código.
+ *
+ * Con lectura anticipada (ver prefetch.h) los aciertos siguen siendo de demanda: el primer acierto sobre
+ * una página leída por adelantado cuenta además como lectura útil.
+ *
+ * Las escrituras dejan la página sucia, y desalojar una página sucia obliga a escribirla en disco. Las
+ * víctimas sucias no se escriben una a una: se acumulan en un búfer de WRITEBACK_BATCH páginas (WriteBack)
+ * y al vaciarlo cada tramo de páginas consecutivas se escribe en una sola operación, y una página que se
+ * vuelve a desalojar antes del vaciado se escribe una vez. El coste simulado de la escritura diferida es
+ * WRITEBACK_IO_US por operación más WRITEBACK_PAGE_US por página.
+ */
+
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdint.h>
+
+#ifdef POLICY_INSTRUMENT
+#define INSTRUMENT(statement) do { statement; } while (0)
+#else
+#define INSTRUMENT(statement) ((void)0)
+#endif
+
+#define WRITEBACK_BATCH 32      // Víctimas sucias que se agrupan antes de escribirlas en disco
+#define WRITEBACK_IO_US 100.0   // Coste simulado de cada operación de escritura en disco (µs)
+#define WRITEBACK_PAGE_US 10.0  // Coste simulado de transferir cada página escrita (µs)
+#define LATENCY_BUCKETS 64  // Cubeta b del histograma: latencias en [2^(b-1), 2^b) ns (la 0 es 0 ns)
+
+// Contadores acumulados por una lista de frames
+typedef struct SimStats {
+    uint64_t accesses;      // Referencias procesadas
+    uint64_t hits;          // Referencias a páginas ya presentes en memoria
+    uint64_t misses;        // Referencias que tuvieron que cargar la página
+    uint64_t evictions;     // Fallos (o lecturas anticipadas) que obligaron a desalojar un frame ocupado
+    uint64_t prefetches;    // Páginas cargadas por lectura anticipada (no cuentan como accesos ni fallos)
+    uint64_t prefetchHits;  // Lecturas anticipadas útiles: la página se pidió antes de desalojarse
+    uint64_t prefetchWasted;    // Lecturas anticipadas desperdiciadas: desalojadas sin pedirse
+    uint64_t writes;        // Referencias que modificaron la página (incluidas en accesses)
+    uint64_t dirtyEvictions;    // Desalojos de páginas sucias (cada uno, una escritura sin agrupar)
+    uint64_t writebackPages;    // Páginas escritas en disco tras agrupar las víctimas sucias
+    uint64_t writebackIos;      // Operaciones de escritura en disco (tramos de páginas consecutivas)
+#ifdef POLICY_INSTRUMENT
+    uint64_t lookups;       // Búsquedas de página (findFrame)
+    uint64_t lookupSteps;   // Frames o nodos comparados en esas búsquedas
+    uint64_t handSteps;     // Frames recorridos por el puntero del reloj (CLOCK, CAR)
+    uint64_t scanSteps;     // Cubetas de frecuencia recorridas al desalojar o envejecer (LFU)
+#endif
+} SimStats;
+
+// Búfer de víctimas sucias pendientes de escribir en disco
+typedef struct WriteBack {
+    int pages[WRITEBACK_BATCH];     // Páginas desalojadas sucias desde el último vaciado
+    int count;                      // Páginas en pages
+} WriteBack;
+
+// Histograma logarítmico de latencias por acceso
+typedef struct LatencyHistogram {
+    uint64_t counts[LATENCY_BUCKETS];   // Accesos por cubeta
+} LatencyHistogram;
+
+/*
+ * Función: recordLatency
+ * Descripción: Cuenta un acceso en la cubeta de su latencia.
+ * Parámetros:
+ *  - histogram: Histograma de latencias.
+ *  - nanoseconds: Latencia del acceso.
+ */
+static inline void recordLatency(LatencyHistogram *histogram, uint64_t nanoseconds) {
+    histogram->counts[nanoseconds == 0 ? 0 : 64 - __builtin_clzll(nanoseconds)]++;
+}
+
+/*
+ * Función: recordWriteBack
+ * Descripción: Encola en el búfer una página sucia desalojada y cuenta las páginas y operaciones de disco
+ *              que costará. Las operaciones se cuentan al encolar: cada página abre un tramo nuevo salvo
+ *              que prolongue o una tramos ya encolados, así que los contadores están al día sin esperar
+ *              al vaciado del búfer, que ocurre al llenarse.
+ * Parámetros:
+ *  - buffer: Búfer de víctimas sucias de la política.
+ *  - stats: Contadores de la política.
+ *  - page: Página sucia desalojada.
+ */
+void recordWriteBack(WriteBack *buffer, SimStats *stats, int page);
+
+/*
+ * Función: addStats
+ * Descripción: Acumula unos contadores sobre otros (por ejemplo los de varios hilos o fragmentos).
+ * Parámetros:
+ *  - total: Contadores acumulados.
+ *  - stats: Contadores que se suman.
+ */
+void addStats(SimStats *total, const SimStats *stats);
+
+/*
+ * Función: hitRatio
+ * Descripción: Calcula la tasa de aciertos de una simulación.
+ * Parámetros:
+ *  - stats: Contadores de la simulación.
+ * Retorna: Aciertos / accesos, o 0 si no hubo accesos.
+ */
+double hitRatio(const SimStats *stats);
+
+/*
+ * Función: printStats
+ * Descripción: Imprime en una línea el resumen de los contadores de una simulación; si hubo lectura
+ *              anticipada añade las páginas leídas, las útiles y las desperdiciadas, y si hubo
+ *              escrituras, las víctimas sucias y el coste de escribirlas con y sin agrupar.
+ * Parámetros:
+ *  - policy: Nombre del algoritmo simulado.
+ *  - numFrames: Número de frames de la memoria simulada.
+ *  - stats: Contadores de la simulación.
+ */
+void printStats(const char *policy, int numFrames, const SimStats *stats);
+
+/*
+ * Función: printInstrumentation
+ * Descripción: Imprime en una línea los contadores de la ruta caliente y los percentiles de latencia.
+ *              Sin -DPOLICY_INSTRUMENT no imprime nada.
+ * Parámetros:
+ *  - policy: Nombre del algoritmo simulado.
+ *  - stats: Contadores de la simulación.
+ *  - latency: Histograma de latencias por acceso.
+ */
+void printInstrumentation(const char *policy, const SimStats *stats, const LatencyHistogram *latency);
+
+#endif
@@ -0,0 +1,246 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Barrido paralelo de configuraciones (política, número de frames) sobre una misma traza. La traza,
+ * binaria o compacta, se proyecta una sola vez en modo de solo lectura y cada configuración la recorre
+ * con su propio cursor (shareTrace) y su propia lista de frames, de modo que los hilos no comparten
+ * estado mutable: solo se reparten las configuraciones mediante un contador atómico. Los resultados se
+ * guardan por configuración y se imprimen juntos al final, en el orden en que se pidieron.
+ *
+ * Compilación: gcc -O2 -march=native -pthread -DPOLICY_LIBRARY sweep.c driver.c policies.c FIFO-LRU.c \
+ *              LRU-CLOCK.c framescan.c OPR-LFU.c MT-CLOCK.c SHARDED-LRU.c CAR-CLOCK.c OPT-BELADY.c \
+ *              timeseries.c checkpoint.c remap.c prefetch.c trace.c stats.c -o sweep
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "policy.h"
+#include "driver.h"
+#include "trace.h"
+
+// Una configuración del barrido y su resultado
+typedef struct SweepConfig {
+    const PolicyOps *ops;   // Política simulada
+    int numFrames;          // Frames de la memoria simulada
+    SimStats stats;         // Contadores al terminar la traza
+    double seconds;         // Tiempo de simulación de esta configuración
+    bool ok;                // La configuración se simuló sin errores
+} SweepConfig;
+
+// Datos compartidos (de solo lectura salvo el contador) por los hilos del barrido
+typedef struct SweepShared {
+    const TraceReader *trace;   // Traza proyectada una sola vez
+    SweepConfig *configs;       // Configuraciones y sus resultados (una por hilo a la vez)
+    int numConfigs;             // Número de configuraciones
+    atomic_int next;            // Próxima configuración sin asignar
+} SweepShared;
+
+/*
+ * Función: elapsedSeconds
+ * Descripción: Calcula los segundos transcurridos desde un instante dado.
+ * Parámetros:
+ *  - start: Instante inicial (CLOCK_MONOTONIC).
+ * Retorna: Segundos transcurridos.
+ */
+static double elapsedSeconds(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/*
+ * Función: lookaheadConfig
+ * Descripción: Entrega la traza completa, con un cursor propio, a una política que necesita conocer el
+ *              futuro antes de simular (ops->lookahead).
+ * Parámetros:
+ *  - trace: Traza compartida.
+ *  - ops: Política de la configuración.
+ *  - state: Estado recién creado de la política.
+ *  - pages: Búfer de lote propio del hilo.
+ * Retorna: true si la traza se leyó completa y la política la aceptó.
+ */
+static bool lookaheadConfig(const TraceReader *trace, const PolicyOps *ops, void *state, int *pages) {
+    TraceReader *cursor = shareTrace(trace);
+    bool ok = cursor != NULL;
+    size_t count;
+    while (ok && (count = readPages(cursor, pages, TRACE_BATCH_SIZE)) > 0) {
+        ok = ops->lookahead(state, pages, count);
+    }
+    ok = ok && !traceFailed(cursor) && ops->lookahead(state, NULL, 0);
+    if (cursor != NULL) {
+        closeTrace(cursor);
+    }
+    return ok;
+}
+
+/*
+ * Función: runConfig
+ * Descripción: Simula una configuración completa sobre su propio cursor de la traza.
+ * Parámetros:
+ *  - trace: Traza compartida.
+ *  - config: Configuración que se simula; recibe el resultado.
+ *  - pages: Búfer de lote propio del hilo.
+ */
+static void runConfig(const TraceReader *trace, SweepConfig *config, int *pages) {
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    TraceReader *cursor = shareTrace(trace);
+    void *state = config->ops->create(config->numFrames);
+    config->ok = cursor != NULL && state != NULL;
+    if (config->ok && config->ops->lookahead != NULL) {
+        config->ok = lookaheadConfig(trace, config->ops, state, pages);
+    }
+    if (config->ok) {
+        bool (*access)(void *, int) = config->ops->access;
+        size_t count;
+        while ((count = readPages(cursor, pages, TRACE_BATCH_SIZE)) > 0) {
+            for (size_t i = 0; i < count; i++) {
+                access(state, pages[i]);
+            }
+        }
+        config->ok = !traceFailed(cursor);
+        config->stats = *config->ops->stats(state);
+    }
+    if (state != NULL) {
+        config->ops->destroy(state);
+    }
+    if (cursor != NULL) {
+        closeTrace(cursor);
+    }
+    config->seconds = elapsedSeconds(&start);
+}
+
+/*
+ * Función: sweepWorker
+ * Descripción: Hilo del barrido: toma configuraciones pendientes hasta que no quede ninguna.
+ * Parámetros:
+ *  - arg: Puntero a SweepShared.
+ * Retorna: NULL.
+ */
+static void* sweepWorker(void *arg) {
+    SweepShared *shared = (SweepShared *)arg;
+    int *pages = (int *)malloc(TRACE_BATCH_SIZE * sizeof(int));
+    if (pages == NULL) {
+        return NULL;  // Las configuraciones quedan para los demás hilos
+    }
+    for (;;) {
+        int index = atomic_fetch_add(&shared->next, 1);
+        if (index >= shared->numConfigs) {
+            break;
+        }
+        runConfig(shared->trace, &shared->configs[index], pages);
+    }
+    free(pages);
+    return NULL;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: sweep [-j hilos] [-p política[,política...]|all] -f frames[,frames|inicio:fin...] -t traza
+ */
+int main(int argc, char *argv[]) {
+    const PolicyOps *selected[MAX_POLICIES];
+    int numSelected = parsePolicies("all", allPolicies, numAllPolicies, selected);
+    int frameCounts[MAX_FRAME_COUNTS];
+    int numCounts = 0;
+    const char *tracePath = NULL;
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+    while ((opt = getopt(argc, argv, "j:p:f:t:")) != -1) {
+        if (opt == 'j') {
+            numThreads = parseCount(optarg, INT_MAX);
+        } else if (opt == 'p') {
+            numSelected = parsePolicies(optarg, allPolicies, numAllPolicies, selected);
+        } else if (opt == 'f') {
+            numCounts = parseFrameCounts(optarg, frameCounts);
+        } else if (opt == 't') {
+            tracePath = optarg;
+        } else {
+            numSelected = 0;
+        }
+    }
+    if (numSelected == 0 || numCounts == 0 || tracePath == NULL || numThreads <= 0) {
+        fprintf(stderr, "Uso: %s [-j hilos] [-p política[,política...]|all] "
+                        "-f frames[,frames|inicio:fin...] -t traza\n", argv[0]);
+        return 1;
+    }
+
+    TraceReader *trace = openTrace(tracePath);
+    if (trace == NULL) {
+        return 1;
+    }
+    if (traceLength(trace) < 0) {
+        fprintf(stderr, "%s: el barrido necesita una traza binaria o compacta (ver trace-convert)\n", tracePath);
+        closeTrace(trace);
+        return 1;
+    }
+
+    SweepShared shared;
+    shared.trace = trace;
+    shared.numConfigs = numSelected * numCounts;
+    shared.configs = (SweepConfig *)calloc((size_t)shared.numConfigs, sizeof(SweepConfig));
+    atomic_init(&shared.next, 0);
+    if (shared.configs == NULL) {
+        fprintf(stderr, "No hay memoria para %d configuraciones\n", shared.numConfigs);
+        closeTrace(trace);
+        return 1;
+    }
+    for (int p = 0; p < numSelected; p++) {
+        for (int f = 0; f < numCounts; f++) {
+            shared.configs[p * numCounts + f].ops = selected[p];
+            shared.configs[p * numCounts + f].numFrames = frameCounts[f];
+        }
+    }
+
+    if (numThreads > shared.numConfigs) {
+        numThreads = shared.numConfigs;
+    }
+    pthread_t *threads = (pthread_t *)malloc((size_t)numThreads * sizeof(pthread_t));
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    long started = 0;
+    for (; threads != NULL && started < numThreads; started++) {
+        if (pthread_create(&threads[started], NULL, sweepWorker, &shared) != 0) {
+            break;
+        }
+    }
+    if (started == 0) {
+        sweepWorker(&shared);  // Sin hilos disponibles, el barrido corre en el hilo principal
+    }
+    for (long t = 0; t < started; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    double seconds = elapsedSeconds(&start);
+
+    // Combinar los resultados en el orden en que se pidieron
+    bool ok = true;
+    for (int i = 0; i < shared.numConfigs; i++) {
+        SweepConfig *config = &shared.configs[i];
+        if (!config->ok) {
+            fprintf(stderr, "%s frames=%d: la simulación falló\n", config->ops->name, config->numFrames);
+            ok = false;
+            continue;
+        }
+        printStats(config->ops->name, config->numFrames, &config->stats);
+    }
+    fprintf(stderr, "Barrido: %d configuraciones en %.3f s con %ld hilos\n",
+            shared.numConfigs, seconds, started > 0 ? started : 1);
+
+    free(threads);
+    free(shared.configs);
+    closeTrace(trace);
+    return ok ? 0 : 1;
+}
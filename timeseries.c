@@ -0,0 +1,358 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación de la serie temporal de timeseries.h. La cola es de un solo productor (el bucle de
+ * simulación) y un solo consumidor (el hilo escritor), con índices atómicos y sin cerrojos: el productor
+ * nunca espera y el escritor duerme un milisegundo cuando la encuentra vacía.
+ *
+ * El conjunto de trabajo se cuenta con una tabla hash de direccionamiento abierto en la que cada página
+ * guarda la última ventana en que se vio; una referencia cuenta como página nueva si su marca es de
+ * otra ventana. Así no hace falta vaciar la tabla en cada ventana: las entradas viejas se descartan
+ * solo al reconstruirla, cuando la ocupación supera la mitad.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "timeseries.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+#define MIN_SET_CAPACITY 1024   // Posiciones iniciales de la tabla del conjunto de trabajo
+
+struct TimeSeries {
+    FILE *out;                  // Salida de la serie
+    bool binary;                // Formato binario en lugar de CSV
+    uint64_t window;            // Referencias por ventana
+    uint64_t position;          // Referencias de la ventana actual
+    uint64_t total;             // Referencias registradas en total
+    int numPolicies;            // Políticas muestreadas
+    const char **names;         // Nombre de cada política
+    SimStats *previous;         // Contadores de cada política al abrir la ventana actual
+
+    int *keys;                  // Tabla del conjunto de trabajo: página de cada posición
+    uint64_t *stamps;           // Ventana (+1) en que se vio la página por última vez; 0 = posición libre
+    size_t capacity;            // Posiciones de la tabla (potencia de 2)
+    size_t used;                // Posiciones ocupadas, incluidas las de ventanas anteriores
+    uint64_t distinct;          // Páginas distintas de la ventana actual
+    uint64_t stamp;             // Marca de la ventana actual
+
+    TimeSample *queue;          // Cola circular de muestras pendientes de escribir
+    atomic_size_t head;         // Próxima posición que escribe el productor
+    atomic_size_t tail;         // Próxima posición que lee el escritor
+    atomic_bool done;           // El productor terminó: el escritor sale al vaciar la cola
+    uint64_t dropped;           // Muestras descartadas por cola llena (solo el productor)
+    bool failed;                // Error de escritura (solo el escritor hasta el join)
+    pthread_t writer;           // Hilo escritor
+};
+
+/*
+ * Función: slotOf
+ * Descripción: Posición inicial de una página en la tabla del conjunto de trabajo.
+ */
+static size_t slotOf(const TimeSeries *series, int page) {
+    uint32_t h = (uint32_t)page * 2654435761u;  // Hash multiplicativo de Knuth
+    h ^= h >> 16;
+    return (size_t)h & (series->capacity - 1);
+}
+
+/*
+ * Función: rebuildSet
+ * Descripción: Reconstruye la tabla del conjunto de trabajo con solo las páginas de la ventana actual,
+ *              duplicando su tamaño si estas ya ocupan más de una cuarta parte.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ * Retorna: false si no hubo memoria.
+ */
+static bool rebuildSet(TimeSeries *series) {
+    size_t oldCapacity = series->capacity;
+    int *oldKeys = series->keys;
+    uint64_t *oldStamps = series->stamps;
+    size_t capacity = series->distinct * 4 > oldCapacity ? oldCapacity * 2 : oldCapacity;
+    int *keys = (int *)malloc(capacity * sizeof(int));
+    uint64_t *stamps = (uint64_t *)calloc(capacity, sizeof(uint64_t));
+    if (keys == NULL || stamps == NULL) {
+        free(keys);
+        free(stamps);
+        return false;
+    }
+    series->keys = keys;
+    series->stamps = stamps;
+    series->capacity = capacity;
+    series->used = 0;
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldStamps[i] == series->stamp) {
+            size_t slot = slotOf(series, oldKeys[i]);
+            while (stamps[slot] != 0) {
+                slot = (slot + 1) & (capacity - 1);
+            }
+            keys[slot] = oldKeys[i];
+            stamps[slot] = series->stamp;
+            series->used++;
+        }
+    }
+    free(oldKeys);
+    free(oldStamps);
+    return true;
+}
+
+/*
+ * Función: observePage
+ * Descripción: Cuenta una referencia en el conjunto de trabajo de la ventana actual.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - page: Página referenciada.
+ * Retorna: false si no hubo memoria.
+ */
+static bool observePage(TimeSeries *series, int page) {
+    size_t slot = slotOf(series, page);
+    while (series->stamps[slot] != 0) {
+        if (series->keys[slot] == page) {
+            if (series->stamps[slot] != series->stamp) {
+                series->stamps[slot] = series->stamp;
+                series->distinct++;
+            }
+            return true;
+        }
+        slot = (slot + 1) & (series->capacity - 1);
+    }
+    series->keys[slot] = page;
+    series->stamps[slot] = series->stamp;
+    series->distinct++;
+    series->used++;
+    return series->used * 2 <= series->capacity || rebuildSet(series);
+}
+
+/*
+ * Función: enqueueSample
+ * Descripción: Copia una muestra a la cola del escritor, o la descarta si la cola está llena.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - sample: Muestra que se encola.
+ */
+static void enqueueSample(TimeSeries *series, const TimeSample *sample) {
+    size_t head = atomic_load_explicit(&series->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&series->tail, memory_order_acquire);
+    if (head - tail == TIMESERIES_QUEUE) {
+        series->dropped++;
+        return;
+    }
+    series->queue[head % TIMESERIES_QUEUE] = *sample;
+    atomic_store_explicit(&series->head, head + 1, memory_order_release);
+}
+
+/*
+ * Función: emitWindow
+ * Descripción: Encola la muestra de cada política para la ventana actual y abre la siguiente.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - policies: Políticas simuladas.
+ */
+static void emitWindow(TimeSeries *series, const Policy *policies) {
+    for (int p = 0; p < series->numPolicies; p++) {
+        const SimStats *stats = policies[p].ops->stats(policies[p].state);
+        TimeSample sample = {
+            .end = series->total,
+            .accesses = stats->accesses - series->previous[p].accesses,
+            .misses = stats->misses - series->previous[p].misses,
+            .workingSet = series->distinct,
+            .policy = (uint32_t)p,
+            .reserved = 0
+        };
+        enqueueSample(series, &sample);
+        series->previous[p] = *stats;
+    }
+    series->position = 0;
+    series->distinct = 0;
+    series->stamp++;
+}
+
+/*
+ * Función: writeSample
+ * Descripción: Escribe una muestra en la salida, en CSV o en binario (hilo escritor).
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - sample: Muestra que se escribe.
+ */
+static void writeSample(TimeSeries *series, const TimeSample *sample) {
+    if (series->binary) {
+        series->failed |= fwrite(sample, sizeof(*sample), 1, series->out) != 1;
+        return;
+    }
+    double ratio = sample->accesses == 0 ? 0.0 :
+                   (double)(sample->accesses - sample->misses) / (double)sample->accesses;
+    series->failed |= fprintf(series->out, "%llu,%llu,%s,%.6f,%llu,%llu\n",
+                              (unsigned long long)((sample->end - 1) / series->window),
+                              (unsigned long long)sample->end, series->names[sample->policy], ratio,
+                              (unsigned long long)sample->misses,
+                              (unsigned long long)sample->workingSet) < 0;
+}
+
+/*
+ * Función: writerThread
+ * Descripción: Hilo escritor: vacía la cola en la salida hasta que el productor termina.
+ * Parámetros:
+ *  - arg: Puntero a la serie.
+ * Retorna: NULL.
+ */
+static void* writerThread(void *arg) {
+    TimeSeries *series = (TimeSeries *)arg;
+    const struct timespec pause = { 0, 1000000 };
+    for (;;) {
+        size_t tail = atomic_load_explicit(&series->tail, memory_order_relaxed);
+        bool finished = atomic_load_explicit(&series->done, memory_order_acquire);
+        size_t head = atomic_load_explicit(&series->head, memory_order_acquire);
+        if (tail == head) {
+            if (finished) {
+                break;  // done se leyó antes que head: no quedan muestras por llegar
+            }
+            nanosleep(&pause, NULL);
+            continue;
+        }
+        for (; tail != head; tail++) {
+            writeSample(series, &series->queue[tail % TIMESERIES_QUEUE]);
+        }
+        atomic_store_explicit(&series->tail, tail, memory_order_release);
+    }
+    series->failed |= fflush(series->out) != 0;
+    return NULL;
+}
+
+/*
+ * Función: writeHeader
+ * Descripción: Escribe la cabecera de la serie: la línea de columnas del CSV o la cabecera binaria.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+static bool writeHeader(TimeSeries *series) {
+    if (!series->binary) {
+        return fprintf(series->out, "ventana,referencias,politica,tasa_aciertos,fallos,conjunto_trabajo\n") >= 0;
+    }
+    unsigned char header[TIMESERIES_HEADER_SIZE] = {0};
+    uint32_t version = TIMESERIES_VERSION;
+    uint32_t numPolicies = (uint32_t)series->numPolicies;
+    memcpy(header, TIMESERIES_MAGIC, 4);
+    memcpy(header + 4, &version, sizeof(version));
+    memcpy(header + 8, &numPolicies, sizeof(numPolicies));
+    memcpy(header + 16, &series->window, sizeof(series->window));
+    bool ok = fwrite(header, sizeof(header), 1, series->out) == 1;
+    for (int p = 0; p < series->numPolicies && ok; p++) {
+        char name[TIMESERIES_NAME_SIZE] = {0};
+        strncpy(name, series->names[p], sizeof(name) - 1);
+        ok = fwrite(name, sizeof(name), 1, series->out) == 1;
+    }
+    return ok;
+}
+
+/*
+ * Función: destroyTimeSeries
+ * Descripción: Libera la memoria de la serie (sin tocar la salida ni el hilo).
+ */
+static void destroyTimeSeries(TimeSeries *series) {
+    free(series->names);
+    free(series->previous);
+    free(series->keys);
+    free(series->stamps);
+    free(series->queue);
+    free(series);
+}
+
+TimeSeries* openTimeSeries(const char *path, uint64_t window, const Policy *policies, int numPolicies,
+                           uint64_t position) {
+    TimeSeries *series = (TimeSeries *)calloc(1, sizeof(TimeSeries));
+    if (series == NULL || window == 0) {
+        fprintf(stderr, "No se pudo crear la serie temporal\n");
+        free(series);
+        return NULL;
+    }
+    series->window = window;
+    series->position = position % window;
+    series->total = position;
+    series->numPolicies = numPolicies;
+    series->capacity = MIN_SET_CAPACITY;
+    series->stamp = 1;
+    series->names = (const char **)malloc((size_t)numPolicies * sizeof(const char *));
+    series->previous = (SimStats *)malloc((size_t)numPolicies * sizeof(SimStats));
+    series->keys = (int *)malloc(series->capacity * sizeof(int));
+    series->stamps = (uint64_t *)calloc(series->capacity, sizeof(uint64_t));
+    series->queue = (TimeSample *)malloc(TIMESERIES_QUEUE * sizeof(TimeSample));
+    if (series->names == NULL || series->previous == NULL || series->keys == NULL ||
+        series->stamps == NULL || series->queue == NULL) {
+        fprintf(stderr, "No hay memoria para la serie temporal\n");
+        destroyTimeSeries(series);
+        return NULL;
+    }
+    for (int p = 0; p < numPolicies; p++) {
+        series->names[p] = policies[p].ops->name;
+        series->previous[p] = *policies[p].ops->stats(policies[p].state);
+    }
+    atomic_init(&series->head, 0);
+    atomic_init(&series->tail, 0);
+    atomic_init(&series->done, false);
+
+    size_t length = strlen(path);
+    series->binary = length > 4 && strcmp(path + length - 4, ".bin") == 0;
+    series->out = strcmp(path, "-") == 0 ? stdout : fopen(path, series->binary ? "wb" : "w");
+    if (series->out == NULL) {
+        perror(path);
+        destroyTimeSeries(series);
+        return NULL;
+    }
+    if (!writeHeader(series) || pthread_create(&series->writer, NULL, writerThread, series) != 0) {
+        fprintf(stderr, "%s: no se pudo iniciar la serie temporal\n", path);
+        if (series->out != stdout) {
+            fclose(series->out);
+        }
+        destroyTimeSeries(series);
+        return NULL;
+    }
+    return series;
+}
+
+uint64_t windowRemaining(const TimeSeries *series) {
+    return series->window - series->position;
+}
+
+bool recordWindow(TimeSeries *series, const Policy *policies, const int *pages, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!observePage(series, pages[i])) {
+            return false;
+        }
+    }
+    series->position += count;
+    series->total += count;
+    if (series->position == series->window) {
+        emitWindow(series, policies);
+    }
+    return true;
+}
+
+bool closeTimeSeries(TimeSeries *series, const Policy *policies) {
+    if (series->position > 0) {
+        emitWindow(series, policies);
+    }
+    atomic_store_explicit(&series->done, true, memory_order_release);
+    pthread_join(series->writer, NULL);
+
+    bool ok = !series->failed;
+    if (series->out != stdout) {
+        ok = fclose(series->out) == 0 && ok;
+    }
+    if (series->dropped > 0) {
+        fprintf(stderr, "Serie temporal: %llu muestras descartadas por cola llena\n",
+                (unsigned long long)series->dropped);
+        ok = false;
+    }
+    if (!ok) {
+        fprintf(stderr, "Serie temporal: la salida quedó incompleta\n");
+    }
+    destroyTimeSeries(series);
+    return ok;
+}
@@ -0,0 +1,98 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Serie temporal por ventanas de la simulación, para localizar los cambios de fase de una traza. Cada
+ * N referencias se emite, por política, la tasa de aciertos y los fallos de la ventana, junto con el
+ * conjunto de trabajo: las páginas distintas referenciadas en ella (igual para todas las políticas).
+ *
+ * El bucle de simulación solo copia las muestras a una cola circular en memoria; un hilo escritor las
+ * formatea y las escribe en segundo plano. Si la cola se llenara, la muestra se descarta (y se avisa al
+ * cerrar) en lugar de detener la simulación.
+ *
+ * Formatos de salida:
+ *  - CSV (por defecto): ventana,referencias,politica,tasa_aciertos,fallos,conjunto_trabajo
+ *  - Binario (ruta terminada en .bin), en el orden de bytes de la máquina: cabecera de
+ *    TIMESERIES_HEADER_SIZE bytes con "PGTS", versión (u32), número de políticas (u32), reservado (u32)
+ *    y tamaño de ventana (u64); después el nombre de cada política en TIMESERIES_NAME_SIZE bytes
+ *    rellenos con ceros, y un registro TimeSample por muestra.
+ */
+
+#ifndef TIMESERIES_H
+#define TIMESERIES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "policy.h"
+
+#define TIMESERIES_MAGIC "PGTS"     // Número mágico de las series binarias
+#define TIMESERIES_VERSION 1        // Versión del formato binario
+#define TIMESERIES_HEADER_SIZE 24   // Bytes de la cabecera binaria
+#define TIMESERIES_NAME_SIZE 16     // Bytes por nombre de política en la cabecera binaria
+#define TIMESERIES_QUEUE 65536      // Muestras que caben en la cola del hilo escritor
+
+// Muestra de una política en una ventana (también es el registro del formato binario)
+typedef struct TimeSample {
+    uint64_t end;           // Referencias de la traza procesadas al cerrar la ventana
+    uint64_t accesses;      // Referencias de la ventana
+    uint64_t misses;        // Fallos de la política en la ventana
+    uint64_t workingSet;    // Páginas distintas referenciadas en la ventana
+    uint32_t policy;        // Índice de la política en el orden de -p
+    uint32_t reserved;      // Relleno (0)
+} TimeSample;
+
+typedef struct TimeSeries TimeSeries;
+
+/*
+ * Función: openTimeSeries
+ * Descripción: Crea la serie y arranca su hilo escritor.
+ * Parámetros:
+ *  - path: Archivo de salida ("-" para stdout); si termina en .bin se escribe en formato binario.
+ *  - window: Referencias por ventana.
+ *  - policies: Políticas simuladas, en el orden en que se muestrean.
+ *  - numPolicies: Número de políticas.
+ *  - position: Referencias ya simuladas (la posición del checkpoint al reanudar, si no 0), para que los
+ *              números de ventana y las referencias coincidan con los de una ejecución sin interrumpir.
+ *              La ventana en curso al reanudar solo cuenta las referencias posteriores al checkpoint.
+ * Retorna: Puntero a la serie, o NULL si falló (el motivo se informa por stderr).
+ */
+TimeSeries* openTimeSeries(const char *path, uint64_t window, const Policy *policies, int numPolicies,
+                           uint64_t position);
+
+/*
+ * Función: windowRemaining
+ * Descripción: Referencias que faltan para cerrar la ventana actual.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ * Retorna: Número de referencias (al menos 1).
+ */
+uint64_t windowRemaining(const TimeSeries *series);
+
+/*
+ * Función: recordWindow
+ * Descripción: Registra un tramo de referencias ya simulado por todas las políticas. El tramo no debe
+ *              pasar de windowRemaining; si completa la ventana, encola una muestra por política.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - policies: Políticas simuladas (las mismas de openTimeSeries).
+ *  - pages: Páginas del tramo.
+ *  - count: Número de páginas del tramo.
+ * Retorna: false si no hubo memoria para el conjunto de trabajo.
+ */
+bool recordWindow(TimeSeries *series, const Policy *policies, const int *pages, size_t count);
+
+/*
+ * Función: closeTimeSeries
+ * Descripción: Emite la ventana incompleta final, si la hay, espera a que el hilo escritor vacíe la cola
+ *              y cierra la salida.
+ * Parámetros:
+ *  - series: Puntero a la serie.
+ *  - policies: Políticas simuladas (las mismas de openTimeSeries).
+ * Retorna: true si todas las muestras se escribieron.
+ */
+bool closeTimeSeries(TimeSeries *series, const Policy *policies);
+
+#endif
@@ -0,0 +1,216 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Convertidor de trazas de referencias a páginas. Lee una traza en cualquiera de los formatos que
+ * entiende trace.h (texto, binaria .bin o compacta) y la escribe en formato compacto: deltas entre
+ * páginas consecutivas codificados en zigzag + varint, precedidos de una cabecera con el tamaño de
+ * página y el número de referencias. Con -x realiza la conversión inversa a texto, una página por línea.
+ *
+ * Con -m mapa las páginas se renumeran a identificadores densos en orden de primera aparición (ver
+ * remap.h): la traza resultante declara su universo en la cabecera y la tabla inversa se guarda en el
+ * archivo de mapa. Así se pueden simular trazas con números de página de 64 bits. Con -a la entrada
+ * contiene direcciones en bytes en lugar de números de página: se dividen por el tamaño de página y
+ * también se renumeran.
+ *
+ * Con -w la traza compacta se escribe en la versión 2, que conserva el tipo de cada acceso (R/W) de una
+ * entrada de texto; una entrada compacta de la versión 2 lo conserva siempre. Con -x las escrituras se
+ * escriben con el prefijo W.
+ *
+ * Las páginas etiquetadas con su proceso ("proceso:página", ver trace.h) se conservan en los dos sentidos;
+ * con -m cada par (proceso, página) recibe su propio identificador, como en un único espacio de direcciones.
+ *
+ * Compilación: gcc -O2 trace-convert.c trace.c remap.c -o trace-convert
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include "trace.h"
+#include "remap.h"
+
+/*
+ * Función: convertToCompact
+ * Descripción: Copia todas las referencias de una traza abierta a una traza compacta nueva, con sus
+ *              páginas de 64 bits tal cual (las etiquetadas con su proceso conservan la etiqueta).
+ * Parámetros:
+ *  - trace: Lector de la traza de entrada.
+ *  - outputPath: Ruta de la traza compacta de salida.
+ *  - pageSize: Tamaño de página que se registra en la cabecera.
+ *  - accessTypes: true para conservar el tipo de cada acceso (versión 2).
+ * Retorna: true si la conversión tuvo éxito.
+ */
+bool convertToCompact(TraceReader *trace, const char *outputPath, uint32_t pageSize, bool accessTypes) {
+    TraceWriter *writer = createTraceWriter(outputPath, pageSize);
+    if (writer == NULL) {
+        return false;
+    }
+    if (accessTypes) {
+        setTraceAccessTypes(writer);
+    }
+
+    int64_t pages[TRACE_BATCH_SIZE];
+    bool writes[TRACE_BATCH_SIZE];
+    size_t count;
+    bool ok = true;
+    while (ok && (count = readRawAccesses(trace, pages, writes, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = writeRawAccess(writer, pages[i], writes[i]);
+        }
+    }
+    return closeTraceWriter(writer) && ok && !traceFailed(trace);
+}
+
+/*
+ * Función: convertRemapped
+ * Descripción: Copia una traza a una traza compacta nueva renumerando sus páginas a identificadores
+ *              densos, y guarda la tabla inversa.
+ * Parámetros:
+ *  - trace: Lector de la traza de entrada.
+ *  - outputPath: Ruta de la traza compacta de salida.
+ *  - pageSize: Tamaño de página que se registra en la cabecera.
+ *  - mapPath: Ruta del archivo de mapa, o NULL para no guardarlo.
+ *  - addresses: true si la entrada contiene direcciones en bytes en lugar de páginas.
+ *  - accessTypes: true para conservar el tipo de cada acceso (versión 2).
+ * Retorna: true si la conversión tuvo éxito.
+ */
+bool convertRemapped(TraceReader *trace, const char *outputPath, uint32_t pageSize, const char *mapPath,
+                     bool addresses, bool accessTypes) {
+    uint64_t total = 0;
+    PageRemap *remap = createRemap(0);
+    TraceWriter *writer = remap != NULL ? createTraceWriter(outputPath, pageSize) : NULL;
+    if (writer == NULL) {
+        if (remap != NULL) {
+            destroyRemap(remap);
+        } else {
+            fprintf(stderr, "No hay memoria para la renumeración\n");
+        }
+        return false;
+    }
+    if (accessTypes) {
+        setTraceAccessTypes(writer);
+    }
+
+    int64_t raw[TRACE_BATCH_SIZE];
+    int pages[TRACE_BATCH_SIZE];
+    bool writes[TRACE_BATCH_SIZE];
+    size_t count;
+    bool ok = true;
+    while (ok && (count = readRawAccesses(trace, raw, writes, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count && addresses; i++) {
+            raw[i] = (int64_t)((uint64_t)raw[i] / pageSize);
+        }
+        ok = remapPages(remap, raw, pages, count);
+        total += count;
+        for (size_t i = 0; i < count && ok; i++) {
+            ok = writeAccess(writer, pages[i], writes[i]);
+        }
+    }
+    setTraceUniverse(writer, remapCount(remap));
+    ok = closeTraceWriter(writer) && ok && !traceFailed(trace);
+    if (ok) {
+        fprintf(stderr, "%llu referencias, %u páginas distintas\n", (unsigned long long)total, remapCount(remap));
+        ok = mapPath == NULL || writeRemap(remap, mapPath);
+    }
+    destroyRemap(remap);
+    return ok;
+}
+
+/*
+ * Función: convertToText
+ * Descripción: Escribe todas las referencias de una traza abierta como texto, una por línea, con el
+ *              prefijo W las escrituras y las páginas etiquetadas como "proceso:página".
+ * Parámetros:
+ *  - trace: Lector de la traza de entrada.
+ *  - outputPath: Ruta del archivo de salida ("-" para stdout).
+ * Retorna: true si la conversión tuvo éxito.
+ */
+bool convertToText(TraceReader *trace, const char *outputPath) {
+    FILE *output = (outputPath[0] == '-' && outputPath[1] == '\0') ? stdout : fopen(outputPath, "w");
+    if (output == NULL) {
+        perror(outputPath);
+        return false;
+    }
+
+    int64_t pages[TRACE_BATCH_SIZE];
+    bool writes[TRACE_BATCH_SIZE];
+    size_t count;
+    while ((count = readRawAccesses(trace, pages, writes, TRACE_BATCH_SIZE)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const char *kind = writes[i] ? "W" : "";
+            if (pages[i] > INT32_MAX && pageTenant(pages[i]) <= MAX_TENANT_ID && tenantPage(pages[i]) >= 0) {
+                fprintf(output, "%s%d:%d\n", kind, pageTenant(pages[i]), tenantPage(pages[i]));
+            } else {
+                fprintf(output, "%s%lld\n", kind, (long long)pages[i]);
+            }
+        }
+    }
+    bool ok = !ferror(output) && !traceFailed(trace);
+    if (output != stdout && fclose(output) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+/*
+ * Función: main
+ * Descripción: Uso: trace-convert [-p tamañoPágina] [-x | [-m mapa] [-a] [-w]] entrada salida
+ */
+int main(int argc, char *argv[]) {
+    uint32_t pageSize = TRACE_DEFAULT_PAGE_SIZE;
+    bool pageSizeGiven = false;
+    bool toText = false;
+    const char *mapPath = NULL;
+    bool remap = false;
+    bool addresses = false;
+    bool accessTypes = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "p:xm:aw")) != -1) {
+        if (opt == 'p') {
+            pageSize = (uint32_t)strtoul(optarg, NULL, 10);
+            pageSizeGiven = true;
+        } else if (opt == 'x') {
+            toText = true;
+        } else if (opt == 'm') {
+            mapPath = optarg;
+            remap = true;
+        } else if (opt == 'a') {
+            addresses = true;
+            remap = true;
+        } else if (opt == 'w') {
+            accessTypes = true;
+        } else {
+            optind = argc + 1;  // Forzar el mensaje de uso
+            break;
+        }
+    }
+    if (optind + 2 != argc || (toText && (remap || accessTypes)) || pageSize == 0) {
+        fprintf(stderr, "Uso: %s [-p tamañoPágina] [-x | [-m mapa] [-a] [-w]] entrada salida\n", argv[0]);
+        return 1;
+    }
+
+    TraceReader *trace = openTrace(argv[optind]);
+    if (trace == NULL) {
+        return 1;
+    }
+    if (!pageSizeGiven && tracePageSize(trace) != 0) {
+        pageSize = tracePageSize(trace);  // Conservar el tamaño de página de una traza compacta
+    }
+    accessTypes = accessTypes || traceHasAccessTypes(trace);
+
+    bool ok;
+    if (toText) {
+        ok = convertToText(trace, argv[optind + 1]);
+    } else if (remap) {
+        ok = convertRemapped(trace, argv[optind + 1], pageSize, mapPath, addresses, accessTypes);
+    } else {
+        ok = convertToCompact(trace, argv[optind + 1], pageSize, accessTypes);
+    }
+    closeTrace(trace);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,766 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación del lector de trazas declarado en trace.h. Las trazas binarias se proyectan con mmap
+ * y se avisa al kernel de que el acceso es secuencial; cada TRACE_RELEASE_STEP bytes consumidos se
+ * descartan con madvise(MADV_DONTNEED) para que la memoria residente no crezca con la traza. Las trazas
+ * de texto se leen en bloques de TRACE_CHUNK_SIZE bytes y se analizan sin copiar número a número.
+ * Las trazas compactas se reconocen por su número mágico, también se proyectan y se decodifican
+ * directamente desde la proyección; el escritor de trazas compactas usa un búfer de stdio grande.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "trace.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define TRACE_CHUNK_SIZE (1 << 20)      // Tamaño del bloque de lectura para trazas de texto
+#define TRACE_RELEASE_STEP (64 << 20)   // Bytes consumidos entre liberaciones de la proyección
+#define TRACE_MAX_VARINT 10             // Bytes máximos de un varint de 64 bits
+
+typedef enum TraceFormat {
+    TRACE_FORMAT_TEXT,      // Números de página en ASCII
+    TRACE_FORMAT_BINARY,    // Enteros de 32 bits consecutivos
+    TRACE_FORMAT_COMPACT    // Cabecera + deltas zigzag codificados como varint
+} TraceFormat;
+
+// Estado de lectura de una traza
+struct TraceReader {
+    TraceFormat format;     // Formato de la traza
+    int fd;                 // Descriptor del archivo (0 para stdin)
+    bool failed;            // Se produjo un error de lectura o de formato
+    bool shared;            // Cursor creado con shareTrace: no posee la proyección ni el descriptor
+
+    // Traza binaria proyectada en memoria
+    const unsigned char *map;   // Inicio de la proyección
+    size_t mapSize;             // Tamaño de la proyección en bytes
+    size_t offset;              // Próximo byte por leer
+    size_t released;            // Bytes ya devueltos al kernel
+
+    // Traza compacta (se decodifica sobre la proyección)
+    uint32_t pageSize;          // Tamaño de página declarado en la cabecera
+    uint32_t universe;          // Páginas distintas si están renumeradas de 0 a universe-1 (0 si no)
+    bool accessTypes;           // Cada registro lleva el bit de escritura (versión 2)
+    uint64_t remaining;         // Referencias que quedan por decodificar
+    int64_t previous;           // Última página decodificada (base del siguiente delta)
+
+    // Traza de texto leída por bloques
+    char *buffer;           // Bloque actual
+    size_t length;          // Bytes válidos en el bloque
+    size_t pos;             // Próximo byte por analizar
+    bool eof;               // El archivo no tiene más datos
+};
+
+/*
+ * Función: hasSuffix
+ * Descripción: Comprueba si una cadena termina con un sufijo dado.
+ * Parámetros:
+ *  - text: Cadena a comprobar.
+ *  - suffix: Sufijo buscado.
+ * Retorna: true si text termina en suffix.
+ */
+static bool hasSuffix(const char *text, const char *suffix) {
+    size_t textLength = strlen(text);
+    size_t suffixLength = strlen(suffix);
+    return textLength >= suffixLength && strcmp(text + textLength - suffixLength, suffix) == 0;
+}
+
+/*
+ * Función: loadLE
+ * Descripción: Lee un entero sin signo little-endian de width bytes.
+ * Parámetros:
+ *  - bytes: Bytes de origen.
+ *  - width: Número de bytes (4 u 8).
+ * Retorna: Valor leído.
+ */
+static uint64_t loadLE(const unsigned char *bytes, int width) {
+    uint64_t value = 0;
+    for (int i = width - 1; i >= 0; i--) {
+        value = (value << 8) | bytes[i];
+    }
+    return value;
+}
+
+/*
+ * Función: storeLE
+ * Descripción: Escribe un entero sin signo en little-endian con width bytes.
+ * Parámetros:
+ *  - bytes: Bytes de destino.
+ *  - value: Valor a escribir.
+ *  - width: Número de bytes (4 u 8).
+ */
+static void storeLE(unsigned char *bytes, uint64_t value, int width) {
+    for (int i = 0; i < width; i++) {
+        bytes[i] = (unsigned char)(value >> (8 * i));
+    }
+}
+
+/*
+ * Función: mapTrace
+ * Descripción: Proyecta en memoria una traza binaria o compacta ya abierta.
+ * Parámetros:
+ *  - reader: Lector con el descriptor abierto.
+ *  - path: Ruta de la traza (para los mensajes de error).
+ * Retorna: true si la proyección tuvo éxito.
+ */
+static bool mapTrace(TraceReader *reader, const char *path) {
+    struct stat info;
+    if (fstat(reader->fd, &info) != 0) {
+        perror(path);
+        return false;
+    }
+    reader->mapSize = (size_t)info.st_size;
+    if (reader->mapSize == 0) {
+        return true;  // Traza vacía: nada que proyectar
+    }
+
+    void *map = mmap(NULL, reader->mapSize, PROT_READ, MAP_PRIVATE, reader->fd, 0);
+    if (map == MAP_FAILED) {
+        perror(path);
+        return false;
+    }
+    madvise(map, reader->mapSize, MADV_SEQUENTIAL);
+    reader->map = (const unsigned char *)map;
+    return true;
+}
+
+TraceReader* openTrace(const char *path) {
+    TraceReader *reader = (TraceReader *)calloc(1, sizeof(TraceReader));
+    if (reader == NULL) {
+        fprintf(stderr, "%s: no hay memoria para el lector\n", path);
+        return NULL;
+    }
+
+    if (strcmp(path, "-") == 0) {
+        reader->fd = STDIN_FILENO;
+    } else {
+        reader->fd = open(path, O_RDONLY);
+        if (reader->fd < 0) {
+            perror(path);
+            free(reader);
+            return NULL;
+        }
+    }
+
+    // Las trazas compactas se identifican por su cabecera, el resto por la extensión
+    unsigned char header[TRACE_HEADER_SIZE];
+    bool compact = reader->fd != STDIN_FILENO &&
+                   pread(reader->fd, header, sizeof(header), 0) == (ssize_t)sizeof(header) &&
+                   memcmp(header, TRACE_MAGIC, 4) == 0;
+    if (compact) {
+        reader->format = TRACE_FORMAT_COMPACT;
+    } else {
+        reader->format = hasSuffix(path, ".bin") ? TRACE_FORMAT_BINARY : TRACE_FORMAT_TEXT;
+    }
+
+    if (reader->format != TRACE_FORMAT_TEXT) {
+        if (!mapTrace(reader, path)) {
+            closeTrace(reader);
+            return NULL;
+        }
+    }
+    if (reader->format == TRACE_FORMAT_BINARY && reader->mapSize % sizeof(int32_t) != 0) {
+        fprintf(stderr, "%s: tamaño no múltiplo de %zu bytes\n", path, sizeof(int32_t));
+        closeTrace(reader);
+        return NULL;
+    }
+    if (reader->format == TRACE_FORMAT_COMPACT) {
+        uint32_t version = (uint32_t)loadLE(header + 4, 4);
+        if (version != TRACE_VERSION && version != TRACE_VERSION_ACCESS) {
+            fprintf(stderr, "%s: versión de traza compacta %u no soportada\n", path, version);
+            closeTrace(reader);
+            return NULL;
+        }
+        reader->accessTypes = version == TRACE_VERSION_ACCESS;
+        reader->pageSize = (uint32_t)loadLE(header + 8, 4);
+        reader->universe = (uint32_t)loadLE(header + 12, 4);
+        reader->remaining = loadLE(header + 16, 8);
+        reader->offset = TRACE_HEADER_SIZE;
+    } else if (reader->format == TRACE_FORMAT_TEXT) {
+        reader->buffer = (char *)malloc(TRACE_CHUNK_SIZE);
+        if (reader->buffer == NULL) {
+            fprintf(stderr, "%s: no hay memoria para el búfer de lectura\n", path);
+            closeTrace(reader);
+            return NULL;
+        }
+    }
+    return reader;
+}
+
+/*
+ * Función: releaseConsumed
+ * Descripción: Devuelve al kernel las páginas de la proyección que ya se leyeron.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza binaria.
+ */
+static void releaseConsumed(TraceReader *reader) {
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t end = reader->offset - reader->offset % pageSize;
+    if (end > reader->released) {
+        madvise((void *)(reader->map + reader->released), end - reader->released, MADV_DONTNEED);
+        reader->released = end;
+    }
+}
+
+/*
+ * Función: storePage
+ * Descripción: Deja una referencia en el array destino que corresponda: pages (int) o raw (64 bits).
+ *              En pages se rechazan los valores negativos (se confundirían con un frame vacío) y los que no
+ *              caben en un int, en lugar de truncarlos.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza (se marca como fallido si el valor no es válido).
+ *  - pages: Array destino de readPages, o NULL.
+ *  - raw: Array destino de readRawPages, o NULL.
+ *  - index: Posición en el array destino.
+ *  - value: Número de página leído.
+ * Retorna: false si el valor no es válido en pages.
+ */
+static inline bool storePage(TraceReader *reader, int *pages, int64_t *raw, size_t index, int64_t value) {
+    if (raw != NULL) {
+        raw[index] = value;
+        return true;
+    }
+    if (value < 0 || value > INT32_MAX) {
+        fprintf(stderr, "traza: la página %lld no es un int no negativo; renumérela con trace-convert -m\n",
+                (long long)value);
+        reader->failed = true;
+        return false;
+    }
+    pages[index] = (int)value;
+    return true;
+}
+
+/*
+ * Función: readBinary
+ * Descripción: Copia referencias consecutivas desde la proyección de una traza binaria (todas lecturas).
+ *              En pages se detiene, marcando el lector como fallido, en la primera página negativa.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages, raw: Array destino (uno de los dos, ver storePage).
+ *  - writes: Recibe el tipo de cada acceso, o NULL.
+ *  - maxPages: Capacidad del array destino.
+ * Retorna: Número de páginas copiadas.
+ */
+static size_t readBinary(TraceReader *reader, int *pages, int64_t *raw, bool *writes, size_t maxPages) {
+    size_t available = (reader->mapSize - reader->offset) / sizeof(int32_t);
+    size_t count = available < maxPages ? available : maxPages;
+    const int32_t *source = (const int32_t *)(reader->map + reader->offset);
+    if (raw != NULL) {
+        for (size_t i = 0; i < count; i++) {
+            raw[i] = source[i];
+        }
+    } else {
+        int32_t signs = 0;  // Se acumula el bit de signo para no añadir una rama al bucle de copia
+        for (size_t i = 0; i < count; i++) {
+            pages[i] = source[i];
+            signs |= source[i];
+        }
+        if (signs < 0) {
+            size_t valid = 0;
+            while (source[valid] >= 0) {
+                valid++;
+            }
+            storePage(reader, pages, NULL, valid, source[valid]);
+            count = valid;
+        }
+    }
+    if (writes != NULL) {
+        memset(writes, 0, count * sizeof(bool));
+    }
+    reader->offset += count * sizeof(int32_t);
+    if (!reader->shared && reader->offset - reader->released >= TRACE_RELEASE_STEP) {
+        releaseConsumed(reader);
+    }
+    return count;
+}
+
+/*
+ * Función: refill
+ * Descripción: Conserva los bytes sin analizar al inicio del búfer y lo completa con el siguiente bloque.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza de texto.
+ * Retorna: true si se añadieron bytes al búfer.
+ */
+static bool refill(TraceReader *reader) {
+    size_t rest = reader->length - reader->pos;
+    memmove(reader->buffer, reader->buffer + reader->pos, rest);
+    reader->length = rest;
+    reader->pos = 0;
+
+    while (!reader->eof && reader->length < TRACE_CHUNK_SIZE) {
+        ssize_t n = read(reader->fd, reader->buffer + reader->length, TRACE_CHUNK_SIZE - reader->length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("lectura de la traza");
+            reader->failed = true;
+            reader->eof = true;
+            return false;
+        }
+        if (n == 0) {
+            reader->eof = true;
+            break;
+        }
+        reader->length += (size_t)n;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Función: isSeparator
+ * Descripción: Indica si un carácter separa números de página en una traza de texto.
+ * Parámetros:
+ *  - c: Carácter a comprobar.
+ * Retorna: true para espacios, tabuladores, saltos de línea y comas.
+ */
+static bool isSeparator(char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == ',';
+}
+
+/*
+ * Función: parseNumber
+ * Descripción: Interpreta un número de página de una traza de texto: decimal con signo opcional, o
+ *              hexadecimal con prefijo 0x (las direcciones virtuales suelen venir así).
+ * Parámetros:
+ *  - token: Caracteres del número (sin terminador).
+ *  - length: Número de caracteres.
+ *  - value: Recibe el valor.
+ * Retorna: true si el número es válido y cabe en 64 bits con signo.
+ */
+static bool parseNumber(const char *token, size_t length, int64_t *value) {
+    if (length == 0) {
+        return false;  // Prefijo de tipo de acceso sin número
+    }
+    bool negative = token[0] == '-';
+    size_t i = negative ? 1 : 0;
+    unsigned base = 10;
+    if (!negative && length > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X')) {
+        base = 16;
+        i = 2;
+    }
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    uint64_t result = 0;
+    if (i == length) {
+        return false;
+    }
+    for (; i < length; i++) {
+        char c = token[i];
+        unsigned digit;
+        if (c >= '0' && c <= '9') {
+            digit = (unsigned)(c - '0');
+        } else if (base == 16 && ((c | 0x20) >= 'a' && (c | 0x20) <= 'f')) {
+            digit = (unsigned)((c | 0x20) - 'a' + 10);
+        } else {
+            return false;
+        }
+        if (result > (limit - digit) / base) {
+            return false;
+        }
+        result = result * base + digit;
+    }
+    *value = negative ? (int64_t)(0 - result) : (int64_t)result;
+    return true;
+}
+
+/*
+ * Función: parseReference
+ * Descripción: Interpreta el número de página de una referencia de texto ya sin el prefijo de tipo de
+ *              acceso: una página, o "proceso:página" para una página etiquetada (ver tagPage).
+ * Parámetros:
+ *  - token: Caracteres de la referencia (sin terminador).
+ *  - length: Número de caracteres.
+ *  - value: Recibe el número de página.
+ * Retorna: true si la referencia es válida.
+ */
+static bool parseReference(const char *token, size_t length, int64_t *value) {
+    const char *colon = (const char *)memchr(token, ':', length);
+    if (colon == NULL) {
+        return parseNumber(token, length, value);
+    }
+    int64_t tenant, page;
+    size_t tenantLength = (size_t)(colon - token);
+    if (!parseNumber(token, tenantLength, &tenant) || !parseNumber(colon + 1, length - tenantLength - 1, &page) ||
+        tenant < 0 || tenant > MAX_TENANT_ID || page < 0 || page > INT32_MAX) {
+        return false;
+    }
+    *value = tagPage((int)tenant, (int)page);
+    return true;
+}
+
+/*
+ * Función: readText
+ * Descripción: Analiza referencias consecutivas de una traza de texto, con su prefijo R o W opcional.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages, raw: Array destino (uno de los dos, ver storePage).
+ *  - writes: Recibe el tipo de cada acceso, o NULL.
+ *  - maxPages: Capacidad del array destino.
+ * Retorna: Número de páginas analizadas.
+ */
+static size_t readText(TraceReader *reader, int *pages, int64_t *raw, bool *writes, size_t maxPages) {
+    size_t count = 0;
+    while (count < maxPages) {
+        // Saltar separadores, rellenando el búfer si se agota
+        while (reader->pos < reader->length && isSeparator(reader->buffer[reader->pos])) {
+            reader->pos++;
+        }
+        if (reader->pos == reader->length) {
+            if (!refill(reader)) {
+                break;
+            }
+            continue;
+        }
+
+        // Asegurar que el número completo está en el búfer antes de analizarlo
+        size_t end = reader->pos;
+        while (end < reader->length && !isSeparator(reader->buffer[end])) {
+            end++;
+        }
+        if (end == reader->length && !reader->eof) {
+            if (reader->pos == 0 && reader->length == TRACE_CHUNK_SIZE) {
+                fprintf(stderr, "traza de texto: referencia de más de %d bytes\n", TRACE_CHUNK_SIZE);
+                reader->failed = true;
+                break;
+            }
+            refill(reader);
+            if (reader->failed) {
+                break;
+            }
+            continue;
+        }
+
+        const char *token = reader->buffer + reader->pos;
+        size_t tokenLength = end - reader->pos;
+        char kind = (char)(token[0] | 0x20);  // Prefijo del tipo de acceso, sin distinguir mayúsculas
+        bool prefixed = kind == 'r' || kind == 'w';
+        int64_t value;
+        if (!parseReference(token + prefixed, tokenLength - prefixed, &value)) {
+            fprintf(stderr, "traza de texto: referencia no válida \"%.*s\"\n", (int)tokenLength, token);
+            reader->failed = true;
+            break;
+        }
+        if (!storePage(reader, pages, raw, count, value)) {
+            break;
+        }
+        if (writes != NULL) {
+            writes[count] = kind == 'w';
+        }
+        count++;
+        reader->pos = end;
+    }
+    return count;
+}
+
+/*
+ * Función: readCompact
+ * Descripción: Decodifica referencias consecutivas de una traza compacta proyectada en memoria.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages, raw: Array destino (uno de los dos, ver storePage).
+ *  - writes: Recibe el tipo de cada acceso (lectura si la traza es de la versión 1), o NULL.
+ *  - maxPages: Capacidad del array destino.
+ * Retorna: Número de páginas decodificadas.
+ */
+static size_t readCompact(TraceReader *reader, int *pages, int64_t *raw, bool *writes, size_t maxPages) {
+    const unsigned char *data = reader->map;
+    size_t offset = reader->offset;
+    size_t size = reader->mapSize;
+    int64_t previous = reader->previous;
+    size_t count = reader->remaining < maxPages ? (size_t)reader->remaining : maxPages;
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t encoded;
+        if (offset < size && data[offset] < 0x80) {
+            encoded = data[offset++];  // Caso común en trazas locales: delta de un solo byte
+        } else {
+            encoded = 0;
+            int shift = 0;
+            for (;;) {
+                if (offset == size || shift >= 7 * TRACE_MAX_VARINT) {
+                    fprintf(stderr, "traza compacta: datos truncados o corruptos\n");
+                    reader->failed = true;
+                    count = i;
+                    break;
+                }
+                unsigned char byte = data[offset++];
+                encoded |= (uint64_t)(byte & 0x7f) << shift;
+                if (byte < 0x80) {
+                    break;
+                }
+                shift += 7;
+            }
+            if (reader->failed) {
+                break;
+            }
+        }
+        bool write = false;
+        if (reader->accessTypes) {
+            write = (encoded & 1) != 0;
+            encoded >>= 1;
+        }
+        if (writes != NULL) {
+            writes[i] = write;
+        }
+        // Deshacer la codificación zigzag y acumular el delta
+        previous += (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+        if (!storePage(reader, pages, raw, i, previous)) {
+            count = i;
+            break;
+        }
+    }
+
+    reader->offset = offset;
+    reader->previous = previous;
+    reader->remaining -= count;
+    if (!reader->shared && reader->offset - reader->released >= TRACE_RELEASE_STEP) {
+        releaseConsumed(reader);
+    }
+    return count;
+}
+
+bool nextPage(TraceReader *reader, int *page) {
+    return readPages(reader, page, 1) == 1;
+}
+
+/*
+ * Función: readInto
+ * Descripción: Lee referencias en el formato de la traza hacia pages o raw (ver storePage).
+ */
+static size_t readInto(TraceReader *reader, int *pages, int64_t *raw, bool *writes, size_t maxPages) {
+    if (reader->failed) {
+        return 0;
+    }
+    if (reader->format == TRACE_FORMAT_BINARY) {
+        return readBinary(reader, pages, raw, writes, maxPages);
+    }
+    if (reader->format == TRACE_FORMAT_COMPACT) {
+        return readCompact(reader, pages, raw, writes, maxPages);
+    }
+    return readText(reader, pages, raw, writes, maxPages);
+}
+
+size_t readPages(TraceReader *reader, int *pages, size_t maxPages) {
+    return readInto(reader, pages, NULL, NULL, maxPages);
+}
+
+size_t readAccesses(TraceReader *reader, int *pages, bool *writes, size_t maxPages) {
+    return readInto(reader, pages, NULL, writes, maxPages);
+}
+
+size_t readRawPages(TraceReader *reader, int64_t *pages, size_t maxPages) {
+    return readInto(reader, NULL, pages, NULL, maxPages);
+}
+
+size_t readRawAccesses(TraceReader *reader, int64_t *pages, bool *writes, size_t maxPages) {
+    return readInto(reader, NULL, pages, writes, maxPages);
+}
+
+uint64_t skipPages(TraceReader *reader, uint64_t count) {
+    if (reader->format == TRACE_FORMAT_BINARY && !reader->failed) {
+        uint64_t available = (reader->mapSize - reader->offset) / sizeof(int32_t);
+        uint64_t skipped = available < count ? available : count;
+        reader->offset += (size_t)skipped * sizeof(int32_t);
+        if (!reader->shared) {
+            releaseConsumed(reader);
+        }
+        return skipped;
+    }
+
+    // Las trazas compactas y de texto solo se pueden avanzar decodificándolas
+    int pages[TRACE_BATCH_SIZE];
+    uint64_t skipped = 0;
+    while (skipped < count) {
+        size_t batch = count - skipped < TRACE_BATCH_SIZE ? (size_t)(count - skipped) : TRACE_BATCH_SIZE;
+        size_t read = readPages(reader, pages, batch);
+        if (read == 0) {
+            break;
+        }
+        skipped += read;
+    }
+    return skipped;
+}
+
+bool traceFailed(const TraceReader *reader) {
+    return reader->failed;
+}
+
+int64_t traceLength(const TraceReader *reader) {
+    if (reader->format == TRACE_FORMAT_COMPACT) {
+        return (int64_t)loadLE(reader->map + 16, 8);
+    }
+    if (reader->format == TRACE_FORMAT_BINARY) {
+        return (int64_t)(reader->mapSize / sizeof(int32_t));
+    }
+    return -1;
+}
+
+uint32_t tracePageSize(const TraceReader *reader) {
+    return reader->pageSize;
+}
+
+uint32_t traceUniverse(const TraceReader *reader) {
+    return reader->universe;
+}
+
+bool traceHasAccessTypes(const TraceReader *reader) {
+    return reader->accessTypes;
+}
+
+TraceReader* shareTrace(const TraceReader *trace) {
+    if (trace->format == TRACE_FORMAT_TEXT) {
+        return NULL;  // Solo las trazas proyectadas admiten varios cursores
+    }
+    TraceReader *reader = (TraceReader *)malloc(sizeof(TraceReader));
+    if (reader != NULL) {
+        *reader = *trace;
+        reader->shared = true;
+        reader->failed = false;
+        reader->previous = 0;
+        reader->offset = (trace->format == TRACE_FORMAT_COMPACT) ? TRACE_HEADER_SIZE : 0;
+        reader->remaining = (trace->format == TRACE_FORMAT_COMPACT) ? loadLE(trace->map + 16, 8) : 0;
+    }
+    return reader;
+}
+
+void closeTrace(TraceReader *reader) {
+    if (reader->shared) {
+        free(reader);
+        return;
+    }
+    if (reader->map != NULL) {
+        munmap((void *)reader->map, reader->mapSize);
+    }
+    if (reader->fd > STDIN_FILENO) {
+        close(reader->fd);
+    }
+    free(reader->buffer);
+    free(reader);
+}
+
+// Estado de escritura de una traza compacta
+struct TraceWriter {
+    FILE *file;             // Archivo de salida
+    const char *path;       // Ruta de salida (para los mensajes de error)
+    uint32_t pageSize;      // Tamaño de página que se registra en la cabecera
+    uint32_t universe;      // Páginas distintas de una traza renumerada (0 si no se indica)
+    bool accessTypes;       // Se escribe la versión 2, con el tipo de cada acceso
+    uint64_t count;         // Referencias escritas
+    int64_t previous;       // Última página escrita (base del siguiente delta)
+};
+
+/*
+ * Función: writeHeader
+ * Descripción: Escribe la cabecera de la traza compacta al inicio del archivo.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+static bool writeHeader(TraceWriter *writer) {
+    unsigned char header[TRACE_HEADER_SIZE] = {0};
+    memcpy(header, TRACE_MAGIC, 4);
+    storeLE(header + 4, writer->accessTypes ? TRACE_VERSION_ACCESS : TRACE_VERSION, 4);
+    storeLE(header + 8, writer->pageSize, 4);
+    storeLE(header + 12, writer->universe, 4);
+    storeLE(header + 16, writer->count, 8);
+    return fseek(writer->file, 0, SEEK_SET) == 0 &&
+           fwrite(header, 1, sizeof(header), writer->file) == sizeof(header);
+}
+
+TraceWriter* createTraceWriter(const char *path, uint32_t pageSize) {
+    TraceWriter *writer = (TraceWriter *)calloc(1, sizeof(TraceWriter));
+    if (writer == NULL) {
+        fprintf(stderr, "%s: no hay memoria para el escritor\n", path);
+        return NULL;
+    }
+    writer->file = fopen(path, "wb");
+    if (writer->file == NULL) {
+        perror(path);
+        free(writer);
+        return NULL;
+    }
+    setvbuf(writer->file, NULL, _IOFBF, TRACE_CHUNK_SIZE);
+    writer->path = path;
+    writer->pageSize = pageSize;
+
+    // La cabecera definitiva (con el número de referencias) se reescribe al cerrar
+    if (!writeHeader(writer)) {
+        perror(path);
+        fclose(writer->file);
+        free(writer);
+        return NULL;
+    }
+    return writer;
+}
+
+bool writePage(TraceWriter *writer, int page) {
+    return writeAccess(writer, page, false);
+}
+
+bool writeAccess(TraceWriter *writer, int page, bool write) {
+    return writeRawAccess(writer, page, write);
+}
+
+bool writeRawAccess(TraceWriter *writer, int64_t page, bool write) {
+    if (write && !writer->accessTypes) {
+        fprintf(stderr, "%s: hay escrituras, pero la traza no registra el tipo de acceso (trace-convert -w)\n", writer->path);
+        return false;
+    }
+    int64_t delta = (int64_t)((uint64_t)page - (uint64_t)writer->previous);
+    uint64_t encoded = ((uint64_t)delta << 1) ^ (uint64_t)(delta >> 63);  // Zigzag
+    if (writer->accessTypes) {
+        if (encoded >> 63 != 0) {
+            fprintf(stderr, "%s: la página %lld no cabe en la traza con tipo de acceso\n", writer->path,
+                    (long long)page);
+            return false;
+        }
+        encoded = (encoded << 1) | (write ? 1 : 0);
+    }
+    unsigned char bytes[TRACE_MAX_VARINT];
+    int length = 0;
+    while (encoded >= 0x80) {
+        bytes[length++] = (unsigned char)(encoded | 0x80);
+        encoded >>= 7;
+    }
+    bytes[length++] = (unsigned char)encoded;
+
+    writer->previous = page;
+    writer->count++;
+    return fwrite(bytes, 1, (size_t)length, writer->file) == (size_t)length;
+}
+
+bool setTraceAccessTypes(TraceWriter *writer) {
+    if (writer->count > 0) {
+        return false;
+    }
+    writer->accessTypes = true;
+    return true;
+}
+
+void setTraceUniverse(TraceWriter *writer, uint32_t universe) {
+    writer->universe = universe;
+}
+
+bool closeTraceWriter(TraceWriter *writer) {
+    bool ok = writeHeader(writer) && !ferror(writer->file);
+    if (fclose(writer->file) != 0) {
+        ok = false;
+    }
+    if (!ok) {
+        perror(writer->path);
+    }
+    free(writer);
+    return ok;
+}
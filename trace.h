@@ -0,0 +1,286 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Lector de trazas de referencias a páginas compartido por los simuladores. Una traza binaria
+ * (extensión .bin, enteros de 32 bits en el orden de bytes de la máquina) se proyecta en memoria con
+ * mmap y se recorre secuencialmente, liberando las páginas ya consumidas; una traza de texto (números
+ * de página en decimal o en hexadecimal con 0x, separados por espacios, comas o saltos de línea) se lee
+ * por bloques grandes con read(). En el texto cada número puede ir precedido de R (lectura, por defecto)
+ * o W (escritura), por ejemplo "W0x1f3"; las trazas binarias .bin solo contienen lecturas.
+ * En ningún caso se materializa la traza completa: la memoria usada no depende de su longitud.
+ * 
+ * Formato compacto (versión 1), reconocido por su número mágico sin importar la extensión:
+ *  - Cabecera de TRACE_HEADER_SIZE bytes, little-endian: "PGTR", versión (u32), tamaño de página en
+ *    bytes (u32), universo (u32) y número de referencias (u64). El universo es el número de páginas
+ *    distintas cuando la traza está renumerada a identificadores densos 0..universo-1 (trace-convert -m),
+ *    o 0 si las páginas son las originales.
+ *  - Una referencia por registro: la diferencia con la página anterior (la primera se resta de 0),
+ *    codificada en zigzag y escrita como varint (7 bits por byte, el bit alto indica continuación).
+ * Como las trazas son muy locales, la mayoría de las referencias ocupa un solo byte.
+ * La versión 2 registra además el tipo de acceso: cada registro es el varint de (zigzag(delta) << 1) | W,
+ * donde W vale 1 en las escrituras. El escritor produce la versión 2 si se le pide con
+ * setTraceAccessTypes antes de la primera referencia.
+ * 
+ * Los simuladores trabajan con páginas int no negativas: readPages falla, en lugar de truncar, si la
+ * traza contiene páginas que no caben en 32 bits, y también si contiene páginas negativas, porque los
+ * frames vacíos se marcan con páginas negativas y una referencia a ellas sería un falso acierto. Esas
+ * trazas se leen con readRawPages y se renumeran con remap.h.
+ * 
+ * Las trazas de varios procesos etiquetan cada referencia con el proceso (inquilino) que la hace: la
+ * página de 64 bits lleva el proceso en los bits altos y la página de ese proceso en los 32 bajos (ver
+ * tagPage). En el texto se escriben como "proceso:página", por ejemplo "W3:0x1f3"; los formatos compacto
+ * y de texto las conservan, y los simuladores de un solo espacio de direcciones las leen con -m, que da
+ * a cada (proceso, página) un identificador propio (ver TENANT-LRU.c para la memoria repartida).
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define TRACE_BATCH_SIZE 4096   // Referencias por lote recomendadas para readPages
+#define TRACE_MAGIC "PGTR"      // Número mágico de las trazas compactas
+#define TRACE_VERSION 1         // Versión del formato compacto
+#define TRACE_VERSION_ACCESS 2  // Versión del formato compacto con tipo de acceso (lectura/escritura)
+#define TRACE_HEADER_SIZE 24    // Bytes de la cabecera compacta
+#define TRACE_DEFAULT_PAGE_SIZE 4096  // Tamaño de página registrado si no se indica otro
+
+#define TENANT_SHIFT 32         // Bits de página de cada proceso en una página etiquetada
+#define MAX_TENANT_ID 0xFFFFFF  // Mayor número de proceso en una página etiquetada
+
+typedef struct TraceReader TraceReader;
+typedef struct TraceWriter TraceWriter;
+
+/*
+ * Funciones: tagPage, pageTenant, tenantPage
+ * Descripción: Componen una página etiquetada a partir del proceso y de su página (0..INT32_MAX), y las
+ *              separan de nuevo. Las páginas sin etiqueta son las del proceso 0.
+ */
+static inline int64_t tagPage(int tenant, int page) {
+    return ((int64_t)tenant << TENANT_SHIFT) | (int64_t)page;
+}
+
+static inline int pageTenant(int64_t page) {
+    return (int)(page >> TENANT_SHIFT);
+}
+
+static inline int tenantPage(int64_t page) {
+    return (int)(uint32_t)page;
+}
+
+/*
+ * Función: openTrace
+ * Descripción: Abre una traza para lectura secuencial. "-" lee una traza de texto desde stdin.
+ * Parámetros:
+ *  - path: Ruta del archivo de traza.
+ * Retorna: Puntero al lector creado, o NULL si no se pudo abrir (el motivo se informa por stderr).
+ */
+TraceReader* openTrace(const char *path);
+
+/*
+ * Función: nextPage
+ * Descripción: Obtiene la siguiente referencia de la traza.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - page: Donde se deja el número de página leído.
+ * Retorna: true si se leyó una página, false al final de la traza o ante un error.
+ */
+bool nextPage(TraceReader *reader, int *page);
+
+/*
+ * Función: readPages
+ * Descripción: Lee hasta maxPages referencias consecutivas de la traza.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages: Array destino.
+ *  - maxPages: Capacidad del array destino.
+ * Retorna: Número de páginas leídas; 0 al final de la traza o ante un error.
+ */
+size_t readPages(TraceReader *reader, int *pages, size_t maxPages);
+
+/*
+ * Función: readAccesses
+ * Descripción: Como readPages, y además indica qué referencias son escrituras.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages: Array destino.
+ *  - writes: Recibe true en las escrituras y false en las lecturas (NULL para descartarlo).
+ *  - maxPages: Capacidad de los arrays destino.
+ * Retorna: Número de páginas leídas; 0 al final de la traza o ante un error.
+ */
+size_t readAccesses(TraceReader *reader, int *pages, bool *writes, size_t maxPages);
+
+/*
+ * Función: readRawPages
+ * Descripción: Lee hasta maxPages referencias consecutivas sin limitarlas al rango de int, para
+ *              renumerar trazas con números de página de 64 bits.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages: Array destino.
+ *  - maxPages: Capacidad del array destino.
+ * Retorna: Número de páginas leídas; 0 al final de la traza o ante un error.
+ */
+size_t readRawPages(TraceReader *reader, int64_t *pages, size_t maxPages);
+
+/*
+ * Función: readRawAccesses
+ * Descripción: Como readRawPages, y además indica qué referencias son escrituras.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - pages: Array destino.
+ *  - writes: Recibe true en las escrituras y false en las lecturas (NULL para descartarlo).
+ *  - maxPages: Capacidad de los arrays destino.
+ * Retorna: Número de páginas leídas; 0 al final de la traza o ante un error.
+ */
+size_t readRawAccesses(TraceReader *reader, int64_t *pages, bool *writes, size_t maxPages);
+
+/*
+ * Función: skipPages
+ * Descripción: Descarta las siguientes referencias de la traza. En las trazas binarias solo avanza el
+ *              cursor; las compactas y las de texto se decodifican sin entregar las páginas.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ *  - count: Número de referencias a descartar.
+ * Retorna: Número de referencias descartadas (menor que count si la traza terminó antes).
+ */
+uint64_t skipPages(TraceReader *reader, uint64_t count);
+
+/*
+ * Función: traceFailed
+ * Descripción: Indica si la lectura terminó por un error (E/S o formato) en lugar del fin de la traza.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ * Retorna: true si hubo un error.
+ */
+bool traceFailed(const TraceReader *reader);
+
+/*
+ * Función: traceLength
+ * Descripción: Número total de referencias de la traza, cuando se conoce sin leerla.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ * Retorna: Número de referencias, o -1 para trazas de texto.
+ */
+int64_t traceLength(const TraceReader *reader);
+
+/*
+ * Función: tracePageSize
+ * Descripción: Tamaño de página declarado en la cabecera de una traza compacta.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ * Retorna: Tamaño de página en bytes, o 0 si la traza no lo registra.
+ */
+uint32_t tracePageSize(const TraceReader *reader);
+
+/*
+ * Función: traceUniverse
+ * Descripción: Número de páginas distintas de una traza compacta renumerada a identificadores densos.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ * Retorna: Universo de páginas (todas están en 0..universo-1), o 0 si la traza no está renumerada.
+ */
+uint32_t traceUniverse(const TraceReader *reader);
+
+/*
+ * Función: traceHasAccessTypes
+ * Descripción: Indica si una traza compacta registra el tipo de acceso (versión 2).
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ * Retorna: true solo para las trazas compactas de la versión 2 (el texto los admite sin declararlos).
+ */
+bool traceHasAccessTypes(const TraceReader *reader);
+
+/*
+ * Función: shareTrace
+ * Descripción: Crea un cursor independiente, desde el inicio, sobre la proyección de una traza binaria
+ *              o compacta ya abierta. Varios hilos pueden leer la misma traza con un cursor cada uno;
+ *              la traza original debe cerrarse después de todos sus cursores.
+ * Parámetros:
+ *  - trace: Traza abierta con openTrace.
+ * Retorna: Puntero al nuevo cursor, o NULL si la traza es de texto o no hay memoria.
+ */
+TraceReader* shareTrace(const TraceReader *trace);
+
+/*
+ * Función: closeTrace
+ * Descripción: Cierra la traza y libera los recursos del lector.
+ * Parámetros:
+ *  - reader: Puntero al lector de la traza.
+ */
+void closeTrace(TraceReader *reader);
+
+/*
+ * Función: createTraceWriter
+ * Descripción: Crea un archivo de traza en formato compacto.
+ * Parámetros:
+ *  - path: Ruta del archivo de salida.
+ *  - pageSize: Tamaño de página en bytes que se registra en la cabecera.
+ * Retorna: Puntero al escritor creado, o NULL si no se pudo crear (el motivo se informa por stderr).
+ */
+TraceWriter* createTraceWriter(const char *path, uint32_t pageSize);
+
+/*
+ * Función: writePage
+ * Descripción: Añade una referencia a la traza compacta.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ *  - page: Número de página referenciada.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+bool writePage(TraceWriter *writer, int page);
+
+/*
+ * Función: writeAccess
+ * Descripción: Añade una referencia de lectura o escritura a la traza compacta. Las escrituras solo se
+ *              admiten si se llamó antes a setTraceAccessTypes.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ *  - page: Número de página referenciada.
+ *  - write: true si la referencia es una escritura.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+bool writeAccess(TraceWriter *writer, int page, bool write);
+
+/*
+ * Función: writeRawAccess
+ * Descripción: Como writeAccess, para páginas de 64 bits (por ejemplo, páginas etiquetadas con su proceso).
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ *  - page: Número de página referenciada.
+ *  - write: true si la referencia es una escritura.
+ * Retorna: true si la escritura tuvo éxito.
+ */
+bool writeRawAccess(TraceWriter *writer, int64_t page, bool write);
+
+/*
+ * Función: setTraceAccessTypes
+ * Descripción: Pasa el escritor a la versión 2 del formato, que registra el tipo de cada acceso.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza, sin referencias escritas todavía.
+ * Retorna: false si ya se escribió alguna referencia.
+ */
+bool setTraceAccessTypes(TraceWriter *writer);
+
+/*
+ * Función: setTraceUniverse
+ * Descripción: Declara en la cabecera que la traza usa identificadores densos 0..universe-1.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ *  - universe: Número de páginas distintas.
+ */
+void setTraceUniverse(TraceWriter *writer, uint32_t universe);
+
+/*
+ * Función: closeTraceWriter
+ * Descripción: Completa la cabecera con el número de referencias y cierra la traza compacta.
+ * Parámetros:
+ *  - writer: Puntero al escritor de la traza.
+ * Retorna: true si la traza quedó escrita por completo.
+ */
+bool closeTraceWriter(TraceWriter *writer);
+
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Implementación de los generadores de workload.h. Los números pseudoaleatorios salen de splitmix64 y
+ * las muestras de Zipf del método de rechazo-inversión de Hörmann y Derflinger, que funciona con
+ * cualquier sesgo positivo en tiempo constante por muestra y sin tablas que dependan de numPages.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#include "workload.h"
+
+// Estado de un generador
+struct Workload {
+    WorkloadSpec spec;          // Parámetros de la carga
+    uint64_t state;             // Estado de splitmix64
+    int64_t generated;          // Referencias producidas hasta ahora
+    double hIntegralX1;         // Constantes del muestreo de Zipf por rechazo-inversión
+    double hIntegralN;
+    double squeeze;
+};
+
+/*
+ * Función: nextRandom
+ * Descripción: Siguiente número de 64 bits de splitmix64.
+ */
+static uint64_t nextRandom(Workload *workload) {
+    uint64_t z = (workload->state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/*
+ * Función: nextUnit
+ * Descripción: Número pseudoaleatorio uniforme en [0, 1) con 53 bits de precisión.
+ */
+static double nextUnit(Workload *workload) {
+    return (double)(nextRandom(workload) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*
+ * Funciones: helper1, helper2
+ * Descripción: log1p(x) / x y expm1(x) / x, con su desarrollo en serie cerca de 0.
+ */
+static double helper1(double x) {
+    return fabs(x) > 1e-8 ? log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+static double helper2(double x) {
+    return fabs(x) > 1e-8 ? expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x * (1.0 / 3.0) * (1.0 + 0.25 * x));
+}
+
+/*
+ * Funciones: zipfH, zipfHIntegral, zipfHIntegralInverse
+ * Descripción: La densidad x^-s, su primitiva y la inversa de la primitiva usadas por el rechazo-inversión.
+ */
+static double zipfH(double skew, double x) {
+    return exp(-skew * log(x));
+}
+
+static double zipfHIntegral(double skew, double x) {
+    double logX = log(x);
+    return helper2((1.0 - skew) * logX) * logX;
+}
+
+static double zipfHIntegralInverse(double skew, double x) {
+    double t = x * (1.0 - skew);
+    if (t < -1.0) {
+        t = -1.0;  // Evita log1p(-1) por errores de redondeo
+    }
+    return exp(helper1(t) * x);
+}
+
+/*
+ * Función: nextZipf
+ * Descripción: Muestra el rango de una página (0 el más popular) con distribución de Zipf.
+ * Parámetros:
+ *  - workload: Puntero al generador.
+ * Retorna: Rango entre 0 y numPages - 1.
+ */
+static int nextZipf(Workload *workload) {
+    double skew = workload->spec.skew;
+    int n = workload->spec.numPages;
+    for (;;) {
+        double u = workload->hIntegralN + nextUnit(workload) * (workload->hIntegralX1 - workload->hIntegralN);
+        double x = zipfHIntegralInverse(skew, u);
+        int k = (int)(x + 0.5);
+        if (k < 1) {
+            k = 1;
+        } else if (k > n) {
+            k = n;
+        }
+        if (k - x <= workload->squeeze || u >= zipfHIntegral(skew, k + 0.5) - zipfH(skew, k)) {
+            return k - 1;
+        }
+    }
+}
+
+bool parseWorkload(const char *text, WorkloadSpec *spec) {
+    static const struct {
+        const char *name;
+        WorkloadKind kind;
+    } kinds[] = {
+        { "zipf", WORKLOAD_ZIPF }, { "uniform", WORKLOAD_UNIFORM }, { "seq", WORKLOAD_SEQUENTIAL },
+        { "loop", WORKLOAD_LOOP }, { "phase", WORKLOAD_PHASE }
+    };
+    const char *colon = strchr(text, ':');
+    size_t length = colon != NULL ? (size_t)(colon - text) : strlen(text);
+    for (size_t k = 0; k < sizeof(kinds) / sizeof(kinds[0]); k++) {
+        if (strlen(kinds[k].name) != length || strncmp(text, kinds[k].name, length) != 0) {
+            continue;
+        }
+        spec->kind = kinds[k].kind;
+        spec->skew = WORKLOAD_DEFAULT_SKEW;
+        spec->phaseLength = WORKLOAD_DEFAULT_PHASE;
+        if (colon == NULL) {
+            return true;
+        }
+        char *end;
+        double value = strtod(colon + 1, &end);
+        if (*end != '\0' || value <= 0) {
+            return false;
+        }
+        if (spec->kind == WORKLOAD_ZIPF) {
+            spec->skew = value;
+        } else if (spec->kind == WORKLOAD_LOOP && value <= INT_MAX) {
+            spec->numPages = (int)value;
+        } else if (spec->kind == WORKLOAD_PHASE) {
+            spec->phaseLength = (int64_t)value;
+        } else {
+            return false;  // uniform y seq no tienen parámetro
+        }
+        return true;
+    }
+    return false;
+}
+
+const char* workloadName(WorkloadKind kind) {
+    static const char *const names[] = { "zipf", "uniform", "seq", "loop", "phase" };
+    return names[kind];
+}
+
+Workload* createWorkload(const WorkloadSpec *spec) {
+    if (spec->numPages <= 0 || spec->skew <= 0 || spec->phaseLength <= 0) {
+        return NULL;
+    }
+    Workload *workload = (Workload *)malloc(sizeof(Workload));
+    if (workload != NULL) {
+        workload->spec = *spec;
+        workload->state = spec->seed;
+        workload->generated = 0;
+        double skew = spec->skew;
+        workload->hIntegralX1 = zipfHIntegral(skew, 1.5) - 1.0;
+        workload->hIntegralN = zipfHIntegral(skew, spec->numPages + 0.5);
+        workload->squeeze = 2.0 - zipfHIntegralInverse(skew, zipfHIntegral(skew, 2.5) - zipfH(skew, 2.0));
+    }
+    return workload;
+}
+
+void generatePages(Workload *workload, int *pages, size_t count) {
+    const WorkloadSpec *spec = &workload->spec;
+    for (size_t i = 0; i < count; i++, workload->generated++) {
+        switch (spec->kind) {
+        case WORKLOAD_ZIPF:
+            pages[i] = nextZipf(workload);
+            break;
+        case WORKLOAD_UNIFORM:
+            pages[i] = (int)(((nextRandom(workload) >> 32) * (uint64_t)spec->numPages) >> 32);
+            break;
+        case WORKLOAD_SEQUENTIAL:
+            pages[i] = (int)(workload->generated % INT_MAX);
+            break;
+        case WORKLOAD_LOOP:
+            pages[i] = (int)(workload->generated % spec->numPages);
+            break;
+        case WORKLOAD_PHASE: {
+            // Cada fase desplaza el universo completo: su conjunto caliente no comparte páginas con el anterior
+            int64_t phase = workload->generated / spec->phaseLength;
+            int64_t phases = INT_MAX / spec->numPages;
+            pages[i] = (int)((phase % phases) * spec->numPages) + nextZipf(workload);
+            break;
+        }
+        }
+    }
+}
+
+void destroyWorkload(Workload *workload) {
+    free(workload);
+}
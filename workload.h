@@ -0,0 +1,94 @@
+/*
+ * Nombre del equipo: S.O. AGREVAL
+ * Fecha: 16/10/2024
+ * Versión: 1.0.0
+ * Descripción:
+ * Generadores de cargas sintéticas de referencias a páginas, para medir los algoritmos sin depender de
+ * una traza en disco. Cada generador es determinista a partir de su semilla, de modo que todas las
+ * políticas de una comparación ven exactamente la misma secuencia de referencias:
+ *  - zipf: páginas 0..numPages-1 con popularidad de Zipf de sesgo ajustable (la página 0 es la más usada).
+ *  - uniform: páginas 0..numPages-1 equiprobables.
+ *  - seq: recorrido secuencial sin repeticiones (0, 1, 2, ...), el peor caso de un barrido.
+ *  - loop: conjunto de trabajo de numPages páginas recorrido en bucle (0..numPages-1, 0, ...).
+ *  - phase: Zipf cuyo conjunto caliente cambia por completo cada phaseLength referencias.
+ */
+
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define WORKLOAD_DEFAULT_SKEW 0.99          // Sesgo de zipf y phase si no se indica otro
+#define WORKLOAD_DEFAULT_PHASE 1000000      // Referencias por fase de phase si no se indica otra
+
+// Tipo de carga sintética
+typedef enum WorkloadKind {
+    WORKLOAD_ZIPF,
+    WORKLOAD_UNIFORM,
+    WORKLOAD_SEQUENTIAL,
+    WORKLOAD_LOOP,
+    WORKLOAD_PHASE
+} WorkloadKind;
+
+// Parámetros de una carga sintética
+typedef struct WorkloadSpec {
+    WorkloadKind kind;      // Generador
+    int numPages;           // Páginas distintas (universo de zipf, uniform y phase; tamaño del bucle en loop)
+    double skew;            // Sesgo de Zipf (zipf y phase), mayor que 0
+    int64_t phaseLength;    // Referencias por fase (phase)
+    uint64_t seed;          // Semilla del generador pseudoaleatorio
+} WorkloadSpec;
+
+typedef struct Workload Workload;
+
+/*
+ * Función: parseWorkload
+ * Descripción: Interpreta la descripción de una carga: nombre[:parámetro], donde el parámetro es el
+ *              sesgo en zipf, las páginas del bucle en loop y las referencias por fase en phase.
+ *              Los demás campos de spec (numPages, seed) deben venir ya inicializados.
+ * Parámetros:
+ *  - text: Descripción, por ejemplo "zipf:0.8", "loop:5000" o "phase:200000".
+ *  - spec: Parámetros que se completan.
+ * Retorna: true si la descripción es válida.
+ */
+bool parseWorkload(const char *text, WorkloadSpec *spec);
+
+/*
+ * Función: workloadName
+ * Descripción: Nombre corto de un tipo de carga.
+ * Parámetros:
+ *  - kind: Tipo de carga.
+ * Retorna: Nombre del generador ("zipf", "uniform", ...).
+ */
+const char* workloadName(WorkloadKind kind);
+
+/*
+ * Función: createWorkload
+ * Descripción: Crea un generador; zipf y phase precalculan la constante de normalización en O(numPages).
+ * Parámetros:
+ *  - spec: Parámetros de la carga.
+ * Retorna: Puntero al generador creado, o NULL si los parámetros no son válidos o no hay memoria.
+ */
+Workload* createWorkload(const WorkloadSpec *spec);
+
+/*
+ * Función: generatePages
+ * Descripción: Produce las siguientes referencias de la carga.
+ * Parámetros:
+ *  - workload: Puntero al generador.
+ *  - pages: Array destino.
+ *  - count: Número de referencias a generar.
+ */
+void generatePages(Workload *workload, int *pages, size_t count);
+
+/*
+ * Función: destroyWorkload
+ * Descripción: Libera un generador.
+ * Parámetros:
+ *  - workload: Puntero al generador.
+ */
+void destroyWorkload(Workload *workload);
+
+#endif